@@ -0,0 +1,132 @@
+#include "NumericalRecipes.hpp"
+
+#include "HybridPipeline.hpp"
+
+#include "Interpolate.hpp"
+#include "VectorFunctions.hpp"
+
+using namespace WaveformUtilities;
+using namespace WaveformObjects;
+using std::string;
+using std::vector;
+using std::cerr;
+using std::endl;
+using std::min;
+using std::max;
+
+WaveformObjects::HybridPipeline::HybridPipeline(const Waveform& iNR, const double iomega, const double iomegat1, const double iomegat2,
+                                                const double iDeltaT, const double iMinStep)
+  : NR(iNR), omega(iomega), omegat1(iomegat1), omegat2(iomegat2), DeltaT(iDeltaT), MinStep(iMinStep),
+    OmegaNR(NR.Omega2m2()), T1NR(max(omegat1, NR.T(0))), T2NR(min(omegat2, NR.T().back())), TANR(0.0),
+    MagSplinesNR(NR.NModes(), 0), ArgSplinesNR(NR.NModes(), 0)
+{
+  if(omega==0.0) {
+    cerr << "\nThe frequency input to HybridPipeline is exactly 0.0.  This will give you garbage" << endl;
+    Throw1WithMessage("Bad frequency");
+  }
+  unsigned int i=0;
+  for(i=0; i<NR.NModes(); ++i) {
+    if(NR.L(i)==2 && NR.M(i)==2) { break; }
+  }
+  if(i==NR.NModes()) {
+    cerr << "\nNR.LM()=" << NR.LM() << endl;
+    Throw1WithMessage("Can't find the 2,2 component of the NR Waveform!");
+  }
+  TANR = WaveformUtilities::FrequencyMatchingTime(NR.T(), OmegaNR, T1NR, T2NR, omega);
+  for(unsigned int Mode=0; Mode<NR.NModes(); ++Mode) {
+    MagSplinesNR[Mode] = new SplineInterpolator(NR.T(), NR.Mag(Mode));
+    ArgSplinesNR[Mode] = new SplineInterpolator(NR.T(), NR.Arg(Mode));
+  }
+}
+
+WaveformObjects::HybridPipeline::~HybridPipeline() {
+  for(unsigned int Mode=0; Mode<MagSplinesNR.size(); ++Mode) {
+    delete MagSplinesNR[Mode];
+    delete ArgSplinesNR[Mode];
+  }
+}
+
+/// Align PN to the NR waveform at the frequency omega, and hybridize
+/// over DeltaT on either side of that time, as in
+/// PN.HybridizeWith_F(NR, ...).  Hybrid is overwritten.
+void WaveformObjects::HybridPipeline::Hybridize(const Waveform& PN, Waveform& Hybrid) const {
+  if(PN.NModes() != NR.NModes()) {
+    cerr << "\nTrying to Align Waveforms with mismatched LM data." << endl;
+    cerr << "NR.NModes()=" << NR.NModes() << "\tPN.NModes()=" << PN.NModes() << endl;
+    Throw1WithMessage("Different number of modes");
+  }
+  if(PN.LM() != NR.LM()) {
+    cerr << "\nTrying to Align Waveforms with mismatched LM data." << endl;
+    cerr << "NR.LM()=" << NR.LM() << "\nPN.LM()=" << PN.LM() << endl;
+    Throw1WithMessage("Different modes");
+  }
+
+  //// Find the time shift, using the stored NR matching time unless
+  //// the PN data restricts the matching interval further
+  const double T1 = max(T1NR, PN.T(0));
+  const double T2 = min(T2NR, PN.T().back());
+  const double TA = (T1==T1NR && T2==T2NR ? TANR : WaveformUtilities::FrequencyMatchingTime(NR.T(), OmegaNR, T1, T2, omega));
+  const double TB = WaveformUtilities::FrequencyMatchingTime(PN.T(), PN.Omega2m2(), T1, T2, omega);
+  const double dt = TA-TB;
+  const vector<double> TPN = PN.T() + dt;
+
+  //// Set up the hybrid's times
+  const double t1 = max(TA-DeltaT, max(NR.T(0), TPN[0]));
+  const double t2 = min(TA+DeltaT, min(NR.T().back(), TPN.back()));
+  Hybrid.TRef() = Union(TPN, NR.T(), MinStep);
+  int it=Hybrid.NTimes()-1;
+  while(Hybrid.T(it)>NR.T().back() && it>0) { --it; }
+  Hybrid.TRef().erase(Hybrid.TRef().begin()+it, Hybrid.TRef().end());
+  const vector<double>& t = Hybrid.T();
+  const unsigned int NTimes = t.size();
+  unsigned int J01=0, J12=NTimes-1;
+  while(t[J01]<t1 && J01<NTimes) { J01++; }
+  while(t[J12]>t2 && J12>0) { J12--; }
+  const double TransitionLength=max(1.0,double(J12-J01-1.0));
+
+  //// Copy the metadata, and interpolate the data
+  Hybrid.SetHistory(PN.HistoryStr());
+  Hybrid.History() << "### HybridPipeline(NR, " << omega << ", " << omegat1 << ", " << omegat2 << ", " << DeltaT << ", " << MinStep
+                   << ").Hybridize(this); # Hybridized with NR at t=" << TA << endl;
+  Hybrid.TypeIndexRef() = PN.TypeIndex();
+  Hybrid.TimeScaleRef() = PN.TimeScale();
+  Hybrid.FrameRef() = PN.Frame();
+  Hybrid.LMRef() = PN.LM();
+  Hybrid.RRef() = vector<double>(1, 0.0);
+  Hybrid.MagRef().resize(PN.NModes(), NTimes);
+  Hybrid.ArgRef().resize(PN.NModes(), NTimes);
+  for(unsigned int Mode=0; Mode<PN.NModes(); ++Mode) {
+    SplineInterpolator SplineMagPN(TPN, PN.Mag(Mode));
+    SplineInterpolator SplineArgPN(TPN, PN.Arg(Mode));
+    const SplineInterpolator& SplineMagNR = *MagSplinesNR[Mode];
+    const SplineInterpolator& SplineArgNR = *ArgSplinesNR[Mode];
+    int jMagNR=0, jArgNR=0;
+    const double dArg = SplineArgNR.interp(TA, jArgNR) - SplineArgPN.interp(TA);
+    vector<double>& mag = Hybrid.MagRef(Mode);
+    vector<double>& arg = Hybrid.ArgRef(Mode);
+    for(unsigned int j=0; j<J01; ++j) {
+      mag[j] = SplineMagPN.interp(t[j]);
+      arg[j] = SplineArgPN.interp(t[j]) + dArg;
+    }
+    for(unsigned int j=J01; j<J12; ++j) {
+      const double Transition = double(j-J01)/TransitionLength;
+      mag[j] = SplineMagPN.interp(t[j])*(1.0-Transition) + SplineMagNR.interp(t[j], jMagNR)*Transition;
+      arg[j] = (SplineArgPN.interp(t[j]) + dArg)*(1.0-Transition) + SplineArgNR.interp(t[j], jArgNR)*Transition;
+    }
+    for(unsigned int j=J12; j<NTimes; ++j) {
+      mag[j] = SplineMagNR.interp(t[j], jMagNR);
+      arg[j] = SplineArgNR.interp(t[j], jArgNR);
+    }
+  }
+
+  // Check for NaNs
+  Hybrid.HasNaNs();
+
+  return;
+}
+
+Waveform WaveformObjects::HybridPipeline::Hybridize(const Waveform& PN) const {
+  Waveform Hybrid;
+  Hybridize(PN, Hybrid);
+  return Hybrid;
+}
@@ -0,0 +1,58 @@
+#ifndef HYBRIDPIPELINE_HPP
+#define HYBRIDPIPELINE_HPP
+
+#include <vector>
+#include "Waveform.hpp"
+
+namespace WaveformUtilities {
+  class SplineInterpolator;
+}
+
+namespace WaveformObjects {
+
+  /// This class hybridizes many PN (or other) waveforms with a single
+  /// NR waveform.  The result of
+  ///
+  ///   HybridPipeline(NR, omega, t1, t2, DeltaT, MinStep).Hybridize(PN)
+  ///
+  /// is the same, to roundoff, as
+  ///
+  ///   PN.HybridizeWith_F(NR, omega, t1, t2, DeltaT, MinStep)
+  ///
+  /// but everything that depends only on the NR waveform -- its copy,
+  /// its frequency, the time at which that reaches omega, and the
+  /// splines of its modes -- is computed once, in the constructor.
+  /// The splines are evaluated in place, through their const interp
+  /// with an index local to each call.
+  /// The PN waveform is not copied: its time shift and phase offsets
+  /// are applied as it is interpolated onto the hybrid's times.
+  ///
+  /// Hybridize is const and keeps all of its working state local, so
+  /// one pipeline may be used for many variants concurrently.
+  class HybridPipeline {
+  private:
+    HybridPipeline(const HybridPipeline&);
+    HybridPipeline& operator=(const HybridPipeline&);
+
+  private:
+    const Waveform NR;
+    const double omega, omegat1, omegat2, DeltaT, MinStep;
+    std::vector<double> OmegaNR;
+    double T1NR, T2NR, TANR;
+    std::vector<WaveformUtilities::SplineInterpolator*> MagSplinesNR, ArgSplinesNR;
+
+  public:
+    HybridPipeline(const Waveform& NR, const double omega, const double omegat1=-1e300, const double omegat2=1e300,
+                   const double DeltaT=10.0, const double MinStep=0.005);
+    ~HybridPipeline();
+
+    const Waveform& NRWaveform() const { return NR; }
+    double MatchingTime() const { return TANR; }
+
+    void Hybridize(const Waveform& PN, Waveform& Hybrid) const;
+    Waveform Hybridize(const Waveform& PN) const;
+  };
+
+} // namespace WaveformObjects
+
+#endif // HYBRIDPIPELINE_HPP
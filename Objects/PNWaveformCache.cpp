@@ -0,0 +1,343 @@
+#include "PNWaveformCache.hpp"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <pthread.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "Utilities.hpp"
+
+using namespace WaveformUtilities;
+using namespace WaveformObjects;
+using std::string;
+using std::vector;
+using std::cerr;
+using std::endl;
+
+typedef vector<vector<vector<double> > > Extras_t;
+
+namespace {
+
+  struct MemoEntry {
+    string Key;
+    Waveform W;
+    Extras_t Extras;
+  };
+
+  struct DiskEntry {
+    string Path;
+    time_t MTime;
+    double Bytes;
+    bool operator<(const DiskEntry& b) const { return MTime<b.MTime; }
+  };
+
+  /// State shared by all instances; the most recently used memo entry
+  /// is at the front of the list.  Every access to it holds CacheMutex.
+  string CacheDirectory("");
+  double CacheMaxBytes = 1.0e9;
+  unsigned int CacheMaxMemoryEntries = 0;
+  std::list<MemoEntry> Memo;
+  unsigned int NHits = 0;
+  unsigned int NMisses = 0;
+  pthread_mutex_t CacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+  /// Hold CacheMutex for the lifetime of this object.
+  class CacheLock {
+  public:
+    CacheLock() { pthread_mutex_lock(&CacheMutex); }
+    ~CacheLock() { pthread_mutex_unlock(&CacheMutex); }
+  private:
+    CacheLock(const CacheLock&);
+    CacheLock& operator=(const CacheLock&);
+  };
+
+  /// A build from a working tree with uncommitted changes has a
+  /// GitRevision ending in "-dirty" (see setup.py).  Its revision does
+  /// not identify the code, so it never uses the on-disk store.
+  bool DirtyRevision() {
+    const string Revision(GitRevision);
+    const string Dirty("-dirty");
+    return Revision.size()>=Dirty.size() && Revision.compare(Revision.size()-Dirty.size(), Dirty.size(), Dirty)==0;
+  }
+  bool UseDisk() { return CacheDirectory.size()>0 && !DirtyRevision(); }
+
+  const char Magic[8] = {'T','r','i','t','o','n','P','N'};
+  const unsigned int FormatVersion = 1;
+  const string Suffix(".pnw");
+
+  /// Binary I/O helpers; sizes are stored as unsigned int, doubles in
+  /// the native byte order.
+  template <class T>
+  void WriteScalar(std::ostream& os, const T& x) { os.write(reinterpret_cast<const char*>(&x), sizeof(T)); }
+  template <class T>
+  bool ReadScalar(std::istream& is, T& x) { is.read(reinterpret_cast<char*>(&x), sizeof(T)); return bool(is); }
+
+  void WriteString(std::ostream& os, const string& s) {
+    WriteScalar(os, (unsigned int)(s.size()));
+    os.write(s.data(), s.size());
+  }
+  bool ReadString(std::istream& is, string& s) {
+    unsigned int N;
+    if(!ReadScalar(is, N)) { return false; }
+    s.resize(N);
+    if(N>0) { is.read(&s[0], N); }
+    return bool(is);
+  }
+
+  template <class T>
+  void WriteVector(std::ostream& os, const vector<T>& v) {
+    WriteScalar(os, (unsigned int)(v.size()));
+    if(v.size()>0) { os.write(reinterpret_cast<const char*>(&v[0]), v.size()*sizeof(T)); }
+  }
+  template <class T>
+  bool ReadVector(std::istream& is, vector<T>& v) {
+    unsigned int N;
+    if(!ReadScalar(is, N)) { return false; }
+    v.resize(N);
+    if(N>0) { is.read(reinterpret_cast<char*>(&v[0]), N*sizeof(T)); }
+    return bool(is);
+  }
+
+  template <class T>
+  void WriteRows(std::ostream& os, const vector<vector<T> >& M) {
+    WriteScalar(os, (unsigned int)(M.size()));
+    for(unsigned int i=0; i<M.size(); ++i) { WriteVector(os, M[i]); }
+  }
+  template <class T>
+  bool ReadRows(std::istream& is, vector<vector<T> >& M) {
+    unsigned int N;
+    if(!ReadScalar(is, N)) { return false; }
+    M.resize(N);
+    for(unsigned int i=0; i<N; ++i) {
+      if(!ReadVector(is, M[i])) { return false; }
+    }
+    return true;
+  }
+
+  string EntryPath(const string& Key) {
+    return CacheDirectory + "/" + PNWaveformCache::Hash(Key) + Suffix;
+  }
+
+  void Write(const string& Path, const string& Key, const Waveform& W, const Extras_t& Extras) {
+    /// Write to a temporary file and rename it, so that concurrent
+    /// readers never see a partial entry.
+    char PID[32];
+    sprintf(PID, ".%ld", long(getpid()));
+    const string TmpPath = Path + PID;
+    std::ofstream ofs(TmpPath.c_str(), std::ios_base::out | std::ios_base::binary);
+    if(!ofs.is_open()) {
+      cerr << "PNWaveformCache: Failed to open '" << TmpPath << "' for writing." << endl;
+      return;
+    }
+    ofs.write(Magic, sizeof(Magic));
+    WriteScalar(ofs, FormatVersion);
+    WriteString(ofs, Key);
+    WriteString(ofs, W.HistoryStr());
+    WriteScalar(ofs, W.TypeIndex());
+    WriteString(ofs, W.TimeScale());
+    WriteVector(ofs, W.T());
+    WriteVector(ofs, W.R());
+    vector<double> Frame(4*W.Frame().size());
+    for(unsigned int i=0; i<W.Frame().size(); ++i) {
+      for(unsigned int j=0; j<4; ++j) { Frame[4*i+j] = W.Frame()[i][j]; }
+    }
+    WriteVector(ofs, Frame);
+    WriteRows(ofs, W.LM().RawData());
+    WriteRows(ofs, W.Mag().RawData());
+    WriteRows(ofs, W.Arg().RawData());
+    WriteScalar(ofs, (unsigned int)(Extras.size()));
+    for(unsigned int i=0; i<Extras.size(); ++i) { WriteRows(ofs, Extras[i]); }
+    ofs.close();
+    if(!ofs || rename(TmpPath.c_str(), Path.c_str())!=0) {
+      cerr << "PNWaveformCache: Failed to write '" << Path << "'." << endl;
+      remove(TmpPath.c_str());
+    }
+  }
+
+  bool Read(const string& Path, const string& Key, Waveform& W, Extras_t& Extras) {
+    std::ifstream ifs(Path.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!ifs.is_open()) { return false; }
+    char FileMagic[sizeof(Magic)];
+    unsigned int Version;
+    string FileKey;
+    ifs.read(FileMagic, sizeof(Magic));
+    if(!ifs || !std::equal(Magic, Magic+sizeof(Magic), FileMagic)
+       || !ReadScalar(ifs, Version) || Version!=FormatVersion) {
+      cerr << "PNWaveformCache: '" << Path << "' is not a cache entry of this version; ignoring it." << endl;
+      return false;
+    }
+    if(!ReadString(ifs, FileKey) || FileKey!=Key) { return false; } // Hash collision
+    string History;
+    vector<double> Frame;
+    Waveform In;
+    bool Good = ReadString(ifs, History)
+      && ReadScalar(ifs, In.TypeIndexRef())
+      && ReadString(ifs, In.TimeScaleRef())
+      && ReadVector(ifs, In.TRef())
+      && ReadVector(ifs, In.RRef())
+      && ReadVector(ifs, Frame)
+      && ReadRows(ifs, In.LMRef().RawData())
+      && ReadRows(ifs, In.MagRef().RawData())
+      && ReadRows(ifs, In.ArgRef().RawData());
+    unsigned int NExtras = 0;
+    Good = Good && ReadScalar(ifs, NExtras);
+    Extras_t InExtras(NExtras);
+    for(unsigned int i=0; Good && i<NExtras; ++i) {
+      Good = ReadRows(ifs, InExtras[i]);
+    }
+    if(!Good) {
+      cerr << "PNWaveformCache: '" << Path << "' is truncated; ignoring it." << endl;
+      return false;
+    }
+    In.SetHistory(History);
+    In.FrameRef().resize(Frame.size()/4);
+    for(unsigned int i=0; i<In.Frame().size(); ++i) {
+      In.FrameRef()[i] = Quaternion(Frame[4*i], Frame[4*i+1], Frame[4*i+2], Frame[4*i+3]);
+    }
+    W.swap(In);
+    Extras.swap(InExtras);
+    return true;
+  }
+
+  /// Delete the least-recently used entries until the directory holds
+  /// no more than CacheMaxBytes of entries.
+  void Evict(const string& Keep) {
+    DIR* Dir = opendir(CacheDirectory.c_str());
+    if(!Dir) { return; }
+    vector<DiskEntry> Entries;
+    double TotalBytes = 0.0;
+    struct dirent* ent;
+    while((ent = readdir(Dir)) != NULL) {
+      const string Name(ent->d_name);
+      if(Name.size()<=Suffix.size() || Name.compare(Name.size()-Suffix.size(), Suffix.size(), Suffix)!=0) { continue; }
+      DiskEntry E;
+      E.Path = CacheDirectory + "/" + Name;
+      struct stat st;
+      if(stat(E.Path.c_str(), &st)!=0) { continue; }
+      E.MTime = st.st_mtime;
+      E.Bytes = double(st.st_size);
+      TotalBytes += E.Bytes;
+      Entries.push_back(E);
+    }
+    closedir(Dir);
+    if(TotalBytes<=CacheMaxBytes) { return; }
+    std::sort(Entries.begin(), Entries.end());
+    for(unsigned int i=0; i<Entries.size() && TotalBytes>CacheMaxBytes; ++i) {
+      if(Entries[i].Path==Keep) { continue; }
+      if(remove(Entries[i].Path.c_str())==0) { TotalBytes -= Entries[i].Bytes; }
+    }
+  }
+
+  void Memoize(const string& Key, const Waveform& W, const Extras_t& Extras) {
+    if(CacheMaxMemoryEntries==0) { return; }
+    Memo.push_front(MemoEntry());
+    Memo.front().Key = Key;
+    Memo.front().W = W;
+    Memo.front().Extras = Extras;
+    while(Memo.size()>CacheMaxMemoryEntries) { Memo.pop_back(); }
+  }
+
+} // empty namespace
+
+
+/// Set the directory of the on-disk store; an empty string disables it.
+void PNWaveformCache::SetDirectory(const std::string& Dir) {
+  CacheLock Lock;
+  CacheDirectory = Dir;
+  if(CacheDirectory.size()>1 && CacheDirectory[CacheDirectory.size()-1]=='/') {
+    CacheDirectory.erase(CacheDirectory.size()-1);
+  }
+  if(CacheDirectory.size()>0) {
+    mkdir(CacheDirectory.c_str(), 0777);
+    struct stat st;
+    if(stat(CacheDirectory.c_str(), &st)!=0 || !S_ISDIR(st.st_mode)) {
+      cerr << "PNWaveformCache: Cannot use '" << CacheDirectory << "' as a directory." << endl;
+      Throw1WithMessage("Bad cache directory");
+    }
+    if(DirtyRevision()) {
+      cerr << "PNWaveformCache: This code was built from a working tree with uncommitted changes ("
+           << GitRevision << "); the on-disk store will not be used." << endl;
+    }
+  }
+}
+
+std::string PNWaveformCache::Directory() { CacheLock Lock; return CacheDirectory; }
+
+/// Set the maximum total size in bytes of the on-disk store (default 1e9).
+void PNWaveformCache::SetMaxBytes(const double MaxBytes) { CacheLock Lock; CacheMaxBytes = MaxBytes; }
+
+double PNWaveformCache::MaxBytes() { CacheLock Lock; return CacheMaxBytes; }
+
+/// Set the number of Waveforms memoized in memory; zero disables it.
+void PNWaveformCache::SetMaxMemoryEntries(const unsigned int N) {
+  CacheLock Lock;
+  CacheMaxMemoryEntries = N;
+  while(Memo.size()>CacheMaxMemoryEntries) { Memo.pop_back(); }
+}
+
+unsigned int PNWaveformCache::MaxMemoryEntries() { CacheLock Lock; return CacheMaxMemoryEntries; }
+
+void PNWaveformCache::ClearMemory() { CacheLock Lock; Memo.clear(); }
+
+unsigned int PNWaveformCache::Hits() { CacheLock Lock; return NHits; }
+
+unsigned int PNWaveformCache::Misses() { CacheLock Lock; return NMisses; }
+
+/// Return the 64-bit FNV-1a hash of the key as 16 hex digits.
+std::string PNWaveformCache::Hash(const std::string& Key) {
+  unsigned long long h = 14695981039346656037ULL;
+  for(unsigned int i=0; i<Key.size(); ++i) {
+    h ^= (unsigned char)(Key[i]);
+    h *= 1099511628211ULL;
+  }
+  char Hex[17];
+  sprintf(Hex, "%016llx", h);
+  return string(Hex);
+}
+
+/// Look for the key in memory, then on disk.
+bool PNWaveformCache::Find(const std::string& Key, Waveform& W, Extras_t& Extras) {
+  /// Returns true and fills W and Extras on success; otherwise, W and
+  /// Extras are unchanged.
+  CacheLock Lock;
+  if(CacheMaxMemoryEntries==0 && !UseDisk()) { return false; }
+  for(std::list<MemoEntry>::iterator it=Memo.begin(); it!=Memo.end(); ++it) {
+    if(it->Key==Key) {
+      Memo.splice(Memo.begin(), Memo, it);
+      W = Memo.front().W;
+      Extras = Memo.front().Extras;
+      ++NHits;
+      return true;
+    }
+  }
+  if(UseDisk()) {
+    const string Path = EntryPath(Key);
+    if(Read(Path, Key, W, Extras)) {
+      utime(Path.c_str(), NULL); // Mark as recently used
+      Memoize(Key, W, Extras);
+      ++NHits;
+      return true;
+    }
+  }
+  ++NMisses;
+  return false;
+}
+
+/// Store the Waveform (and any extra output arrays) under the key.
+void PNWaveformCache::Insert(const std::string& Key, const Waveform& W, const Extras_t& Extras) {
+  CacheLock Lock;
+  Memoize(Key, W, Extras);
+  if(UseDisk()) {
+    const string Path = EntryPath(Key);
+    Write(Path, Key, W, Extras);
+    Evict(Path);
+  }
+}
@@ -0,0 +1,70 @@
+#ifndef PNWAVEFORMCACHE_HPP
+#define PNWAVEFORMCACHE_HPP
+
+#include <string>
+#include <vector>
+#include "Waveform.hpp"
+
+namespace WaveformObjects {
+
+  /// This class caches the Waveforms built by the PN/EOB constructors
+  /// of the Waveform class, so that repeated requests for the same
+  /// inspiral (e.g., by many analysis scripts hybridizing with the
+  /// same PN waveform) need not integrate it again.
+  ///
+  /// The cache key is a string containing the code revision
+  /// (`GitRevision`), the constructor, the approximant, and every
+  /// parameter to full precision -- including LM, nsave, and
+  /// denseish.  Waveforms built by a different revision of the code
+  /// are therefore never reused.  A build from a working tree with
+  /// uncommitted changes has a revision ending in "-dirty", which
+  /// does not identify the code; such a build uses only the memo,
+  /// never the on-disk store.
+  ///
+  /// There are two levels, both of which are disabled by default:
+  ///
+  ///   * An in-memory memo of the most recently used Waveforms,
+  ///     enabled by SetMaxMemoryEntries(N) with N>0.
+  ///
+  ///   * An on-disk store, enabled by SetDirectory(Dir).  Each entry
+  ///     is one binary file, named by a 64-bit hash of the key (the
+  ///     full key is stored in the file, so collisions are detected).
+  ///     The doubles are written in the native byte order, so a
+  ///     directory should not be shared between machines of different
+  ///     endianness.  When the total size of the entries exceeds
+  ///     MaxBytes, the least-recently used entries are deleted;
+  ///     reading an entry updates its modification time.
+  ///
+  /// Any problem reading or writing the disk store is reported on
+  /// cerr, and the Waveform is simply computed as usual.
+  ///
+  /// All of the shared state -- the settings, the memo, and the
+  /// counts of hits and misses -- is guarded by a mutex, so the cache
+  /// may be used from several threads at once.  Each Find or Insert
+  /// holds the mutex while it reads or writes the disk, so threads
+  /// using the cache take turns doing so.
+  class PNWaveformCache {
+  public:
+    static void SetDirectory(const std::string& Dir);
+    static std::string Directory();
+    static void SetMaxBytes(const double MaxBytes);
+    static double MaxBytes();
+    static void SetMaxMemoryEntries(const unsigned int N);
+    static unsigned int MaxMemoryEntries();
+    static void ClearMemory();
+    static unsigned int Hits();
+    static unsigned int Misses();
+    static std::string Hash(const std::string& Key);
+
+    #ifndef SWIG // Exclude the following from SWIG
+    static bool Find(const std::string& Key, Waveform& W,
+                     std::vector<std::vector<std::vector<double> > >& Extras);
+    static void Insert(const std::string& Key, const Waveform& W,
+                       const std::vector<std::vector<std::vector<double> > >& Extras
+                       =std::vector<std::vector<std::vector<double> > >(0));
+    #endif // Excluded the above from SWIG
+  };
+
+} // namespace WaveformObjects
+
+#endif // PNWAVEFORMCACHE_HPP
@@ -9,6 +9,7 @@
 
 #include "Waveform.hpp"
 #include "Waveforms.hpp"
+#include "PNWaveformCache.hpp"
 
 #include "Interpolate.hpp"
 #include "Minimize.hpp"
@@ -130,6 +131,10 @@ WaveformObjects::Waveform::Waveform(const std::string& DataFileName, const std::
   /// and the following two lines contain either the real-imaginary or
   /// magnitude-argument data.
   ///
+  /// For path names ending in .twc, or if Format contains
+  /// 'Compressed', the file is assumed to have been written by
+  /// OutputToCompressedFormat, and everything is read from it.
+  ///
   /// For all other path names, the file is assumed to be a single
   /// data file containing all necessary (l,m) modes.  The first
   /// column is assumed to be time, and consecutive pairs of columns
@@ -238,17 +243,13 @@ WaveformObjects::Waveform::Waveform(const std::string& DataFileName, const std::
       for(unsigned int i=0; i<Data[0].size(); ++i) {
         Times[End][i] = Data[0][i];
       }
-      if(t.size()==0) {
-        t = Times[End];
-      } else {
-        t = Intersection(t, Times[End], 0.05, -1.e300);
-      }
       for(unsigned int i = 0; i<Data[0].size(); ++i) { // Loop over time steps
         Re[End][i] = Data[1][i];
         Im[End][i] = Data[2][i];
       }
     }
     ifs.close();
+    if(Times.size()>0) { t = Intersection(Times, 0.05, -1.e300); }
 
     r = std::vector<double>(1, 0.0);
 
@@ -273,6 +274,11 @@ WaveformObjects::Waveform::Waveform(const std::string& DataFileName, const std::
       arg[i] = WaveformUtilities::Interpolate(Times[i], Im[i], t);
     }
 
+  } else if(tolower(Format).find("compressed") != string::npos
+            || (DataFileName.size()>4 && DataFileName.compare(DataFileName.size()-4,4,".twc")==0)) {  //// Written by OutputToCompressedFormat?
+
+    ReadCompressedFormat(DataFileName);
+
   } else {  // Treat this file like a normal data file
 
     // Read data file
@@ -465,6 +471,21 @@ WaveformObjects::Waveform::Waveform(const std::vector<std::string>& BBHDataSecti
 }
 
 
+/// Build the PNWaveformCache key for the PN/EOB constructors.
+static std::string PNCacheKey(const std::string& Constructor, const std::string& Approximant, const double delta,
+                              const std::vector<double>& chi1, const std::vector<double>& chi2, const double v0,
+                              const WaveformUtilities::Matrix<int>& LM, const int nsave, const bool denseish,
+                              const double PNPhaseOrder, const double PNAmplitudeOrder)
+{
+  stringstream Key;
+  Key << setprecision(17)
+      << GitRevision << ";" << Constructor << ";" << Approximant << ";"
+      << delta << ";(" << chi1 << ");(" << chi2 << ");" << v0 << ";"
+      << RowFormat(LM) << ";" << nsave << ";" << denseish << ";"
+      << PNPhaseOrder << ";" << PNAmplitudeOrder;
+  return Key.str();
+}
+
 /// Simple PN/EOB constructor for non-precessing systems
 WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double delta, const double chis, const double chia, const double v0,
                                     const WaveformUtilities::Matrix<int> LM, const int nsave, const bool denseish,
@@ -495,9 +516,24 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
   ///   &= 2\left[L\, (L-1)/2-1\right] + (L-2) \\
   ///   &= (L+3)\, (L-1)
   /// \f}
+  ///
+  /// If the PNWaveformCache is enabled, an identical Waveform
+  /// constructed earlier is returned from the cache instead.
 
   SetWaveformTypes();
 
+  const std::string CacheKey = PNCacheKey("NonPrecessing", Approximant, delta, std::vector<double>(1, chis), std::vector<double>(1, chia),
+                                          v0, LM, nsave, denseish, PNPhaseOrder, PNAmplitudeOrder);
+  {
+    Waveform Cached;
+    std::vector<std::vector<std::vector<double> > > Extras;
+    if(PNWaveformCache::Find(CacheKey, Cached, Extras)) {
+      swap(Cached);
+      history << "### // Retrieved from PNWaveformCache entry " << PNWaveformCache::Hash(CacheKey) << endl;
+      return;
+    }
+  }
+
   {
     history << "### Code revision `git rev-parse HEAD` = " << GitRevision << endl
             << "### Waveform("
@@ -568,6 +604,7 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
     }
   }
   r.resize(1, 0.0);
+  PNWaveformCache::Insert(CacheKey, *this);
 }
 
 
@@ -592,8 +629,23 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
   /// Constructs a PN inspiral for precessing systems using the method
   /// described in [Phys. Rev. D 84, 124011
   /// (2011)](http://link.aps.org/doi/10.1103/PhysRevD.84.124011)
+  ///
+  /// If the PNWaveformCache is enabled, an identical Waveform
+  /// constructed earlier is returned from the cache instead.
   SetWaveformTypes();
 
+  const std::string CacheKey = PNCacheKey("Precessing", Approximant, delta, chi1, chi2,
+                                          v0, LM, nsave, denseish, PNPhaseOrder, PNAmplitudeOrder);
+  {
+    Waveform Cached;
+    std::vector<std::vector<std::vector<double> > > Extras;
+    if(PNWaveformCache::Find(CacheKey, Cached, Extras)) {
+      swap(Cached);
+      history << "### // Retrieved from PNWaveformCache entry " << PNWaveformCache::Hash(CacheKey) << endl;
+      return;
+    }
+  }
+
   std::vector<double> alpha, beta, gamma;
   {
     history << "### Code revision `git rev-parse HEAD` = " << GitRevision << endl
@@ -645,6 +697,7 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
   }
   frame = Quaternions(alpha, beta, gamma);
   r.resize(1, 0.0);
+  PNWaveformCache::Insert(CacheKey, *this);
 }
 
 /// PN/EOB constructor for precessing systems
@@ -681,8 +734,27 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
   /// coordinate positions of the BHs in the PN approximation.  Note
   /// that this is distinct from the information gained by looking at
   /// the Waveform alone.)
+  ///
+  /// If the PNWaveformCache is enabled, an identical Waveform
+  /// constructed earlier (along with S1, S2, and LNHat) is returned
+  /// from the cache instead.
   SetWaveformTypes();
 
+  const std::string CacheKey = PNCacheKey("PrecessingWithSpins", Approximant, delta, chi1, chi2,
+                                          v0, LM, nsave, denseish, PNPhaseOrder, PNAmplitudeOrder);
+  {
+    Waveform Cached;
+    std::vector<std::vector<std::vector<double> > > Extras;
+    if(PNWaveformCache::Find(CacheKey, Cached, Extras) && Extras.size()==3) {
+      swap(Cached);
+      S1.swap(Extras[0]);
+      S2.swap(Extras[1]);
+      LNHat.swap(Extras[2]);
+      history << "### // Retrieved from PNWaveformCache entry " << PNWaveformCache::Hash(CacheKey) << endl;
+      return;
+    }
+  }
+
   {
     history << "### Code revision `git rev-parse HEAD` = " << GitRevision << endl
             << "### Waveform("
@@ -736,6 +808,13 @@ WaveformObjects::Waveform::Waveform(const std::string& Approximant, const double
     }
   }
   r.resize(1, 0.0);
+  {
+    std::vector<std::vector<std::vector<double> > > Extras(3);
+    Extras[0] = S1;
+    Extras[1] = S2;
+    Extras[2] = LNHat;
+    PNWaveformCache::Insert(CacheKey, *this, Extras);
+  }
 }
 
 
@@ -6,6 +6,10 @@
 #include "Quaternions.hpp"
 #include "Matrix.hpp"
 
+namespace WaveformUtilities {
+  class MultiSplineInterpolator;
+}
+
 namespace WaveformObjects {
 
   class Waveform {
@@ -49,6 +53,7 @@ namespace WaveformObjects {
     WaveformUtilities::Matrix<int> lm;
     WaveformUtilities::Matrix<double> mag;
     WaveformUtilities::Matrix<double> arg;
+    void ReadCompressedFormat(const std::string& FileName);
   public:
     static std::vector<std::string> Types;
 
@@ -159,6 +164,7 @@ namespace WaveformObjects {
     // Interpolation routines
     Waveform& Interpolate(const std::vector<double>& Time);
     Waveform& Interpolate(const std::vector<double>& Time, const double ExtrapVal);
+    Waveform& Interpolate(const std::vector<double>& Time, WaveformUtilities::MultiSplineInterpolator& Spline);
     Waveform& Interpolate(const double Time);
     Waveform& Interpolate(const Waveform& b);
     Waveform& Interpolate(const Waveform& b, const double ExtrapVal);
@@ -199,14 +205,16 @@ namespace WaveformObjects {
 
     // Align and hybridize waveforms
     Waveform& AlignPhasesToTwoPi(const Waveform& a, const double tFrac=0.25);
-    Waveform& AlignTo(const Waveform& a, const double t1, const double t2);
+    Waveform& AlignTo(const Waveform& a, const double t1, const double t2, unsigned int* NEvaluations=0);
+    Waveform& AlignTo_FFT(const Waveform& a, const double t1, const double t2, const double Step=0.0);
     Waveform& AlignWithIntermediate(const Waveform& a, Waveform Intermediate, const double t1, const double t2);
     Waveform HybridizeWith(const Waveform& b, const double t1, const double t2, const double MinStep=0.005) const;
     Waveform& AlignTo_F(const Waveform& a, const double omega, const double omegat1=-1e300, const double omegat2=1e300,
                         const double DeltaT=1e300, const double MinStep=0.005);
     Waveform HybridizeWith_F(const Waveform& a, const double omega, const double omegat1=-1e300, const double omegat2=1e300,
                              const double DeltaT=10.0, const double MinStep=0.005) const;
-    Waveform& AttachQNMs(const double delta, const double chiKerr, double dt=0.0, const double TLength=500.0);
+    Waveform& AttachQNMs(const double delta, const double chiKerr, double dt=0.0, const double TLength=500.0,
+                          const unsigned int NOvertones=1);
 
     // Rotate by the given Euler angles or Quaternion
     Waveform& RotatePhysicalSystem(const double alpha, const double beta, const double gamma);
@@ -228,6 +236,8 @@ namespace WaveformObjects {
     // Nice, easy way of compressing and outputting to NINJA
     Waveform& MinimalGrid(const double MagTol=1.e-5, const double ArgTol=1.e-5);
     void OutputToNINJAFormat(const std::string& MetadataFileName, const std::string ExtractionRadiusString="", const std::string WaveformIdentifier="") const;
+    // Compact binary archive, read back by the data-file constructor
+    void OutputToCompressedFormat(const std::string& FileName, const double MagTol=0.0, const double ArgTol=0.0) const;
 
   }; // class Waveform
 
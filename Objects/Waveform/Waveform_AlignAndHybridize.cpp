@@ -4,11 +4,15 @@
 #include <sys/param.h>
 
 #include <fstream>
+#include <complex>
+#include <algorithm>
 
 #include "../Waveform.hpp"
 
 #include "Interpolate.hpp"
+#include "fft.hpp"
 #include "Minimize.hpp"
+#include "Fit.hpp"
 #include "FileIO.hpp"
 #include "SWSHs.hpp"
 #include "EasyParser.hpp"
@@ -33,37 +37,49 @@ using std::ofstream;
 using std::min;
 using std::max;
 using std::ios_base;
+using std::complex;
 
 
+/// Objective function for aligning Waveform B to Waveform A in time:
+/// the integral over the times of A in [t1,t2] of the squared
+/// difference of the (2,2) phases, less its mean.  The phase of B is
+/// fit once, and the integrals over the (fixed) times of A are
+/// weighted sums, with weights equal to the integrals of the natural
+/// spline through the samples.  The derivative with respect to the
+/// time offset follows from the derivative of B's spline.
 class WaveformAligner {
   friend class Waveform;
+private:
+  WaveformAligner(const WaveformAligner&);
+  WaveformAligner& operator=(const WaveformAligner&);
 protected:
-  const Waveform& a, b;
-  vector<double> t, arga;
+  const Waveform &a, &b;
+  vector<double> t, arga, Weights, tb, argb, darg, dargbdt;
   int LMa, LMb;
+  PiecewiseCubic SplineArgB;
+  double dtLast, fLast, dfLast, dargLast;
+  unsigned int nEvaluations;
 public:
-  WaveformAligner(const Waveform& A, const Waveform& B, const double t1, const double t2)
-    : a(A), b(B), t(a.T()), arga(0), LMa(-1), LMb(-1)
-  {
-    if(a.NModes() != b.NModes()) {
+  static void Validate(const Waveform& A, const Waveform& B, const double t1, const double t2) {
+    if(A.NModes() != B.NModes()) {
       cerr << "\nTrying to Align Waveforms with mismatched LM data." << endl;
-      cerr << "a.NModes()=" << a.NModes() << "\tb.NModes()=" << b.NModes() << endl;
+      cerr << "a.NModes()=" << A.NModes() << "\tb.NModes()=" << B.NModes() << endl;
       Throw1WithMessage("Different number of modes");
     }
-    if(a.LM() != b.LM()) {
+    if(A.LM() != B.LM()) {
       cerr << "\nTrying to Align Waveforms with mismatched LM data." << endl;
-      cerr << "a.LM()=" << a.LM() << "\nb.LM()=" << b.LM() << endl;
+      cerr << "a.LM()=" << A.LM() << "\nb.LM()=" << B.LM() << endl;
       Throw1WithMessage("Different modes");
     }
-    if(t1<a.T(0)) {
+    if(t1<A.T(0)) {
       cerr << "\nAlignment time t1=" << t1 << " does not occur in Waveform A (which has A.T(0)=" << A.T(0) << ")." << endl;
       Throw1WithMessage("Bad matching time for Waveform A");
     }
-    if(t1<b.T(0)) {
+    if(t1<B.T(0)) {
       cerr << "\nAlignment time t1=" << t1 << " does not occur in Waveform B (which has B.T(0)=" << B.T(0) << ")." << endl;
       Throw1WithMessage("Bad matching time for Waveform B");
     }
-    if(t2>a.T().back()) {
+    if(t2>A.T().back()) {
       cerr << "\nAlignment time t2=" << t2 << " does not occur in Waveform A (which has A.T(-1)=" << A.T().back() << ")." << endl;
       Throw1WithMessage("Bad matching time for Waveform A");
     }
@@ -71,24 +87,28 @@ public:
       cerr << "\nAlignment time t2=" << t2 << " does not occur in Waveform B (which has B.T(-1)=" << B.T().back() << ")." << endl;
       Throw1WithMessage("Bad matching time for Waveform B");
     }
-    unsigned int i=0;
-    //ORIENTATION!!! following loops
-    for(i=0; i<a.NModes(); ++i) {
-      if(a.L(i)==2 && a.M(i)==2) { LMa=i; break; }
-    }
-    if(LMa==-1) {
-      cerr << "\na.LM()=" << a.LM() << endl;
-      Throw1WithMessage("Can't find the 2,2 component of Waveform a!");
-    }
-    for(i=0; i<b.NModes(); ++i) {
-      if(b.L(i)==2 && b.M(i)==2) { LMb=i; break; }
-    }
-    if(LMb==-1) {
-      cerr << "\nb.LM()=" << b.LM() << endl;
-      Throw1WithMessage("Can't find the 2,2 component of Waveform b!");
+    Find22(A, "a");
+    Find22(B, "b");
+  }
+
+  static int Find22(const Waveform& W, const string& Name) {
+    //ORIENTATION!!! following loop
+    for(unsigned int i=0; i<W.NModes(); ++i) {
+      if(W.L(i)==2 && W.M(i)==2) { return i; }
     }
+    cerr << "\n" << Name << ".LM()=" << W.LM() << endl;
+    Throw1WithMessage("Can't find the 2,2 component of Waveform " + Name + "!");
+  }
+
+  WaveformAligner(const Waveform& A, const Waveform& B, const double t1, const double t2)
+    : a(A), b(B), t(a.T()), arga(0), LMa(-1), LMb(-1), SplineArgB(),
+      dtLast(0.0), fLast(0.0), dfLast(0.0), dargLast(0.0), nEvaluations(0)
+  {
+    Validate(a, b, t1, t2);
+    LMa = Find22(a, "a");
+    LMb = Find22(b, "b");
     arga = a.Arg(LMa);
-    i=t.size()-1;
+    unsigned int i=t.size()-1;
     while(t[i]>t2 && i>0) { --i; }
     t.erase(t.begin()+i, t.end());
     arga.erase(arga.begin()+i, arga.end());
@@ -96,26 +116,81 @@ public:
     while(i<a.T().size() && a.T(i)<t1) { ++i; }
     t.erase(t.begin(), t.begin()+i);
     arga.erase(arga.begin(), arga.begin()+i);
+    Weights = SplineIntegrationWeights(t);
+    tb.resize(t.size());
+    argb.resize(t.size());
+    darg.resize(t.size());
+    dargbdt.resize(t.size());
+    // Offsets are limited to t2-t1 in either direction, so only that
+    // much of B is fit, with enough extra points on either side that
+    // the fit is the same as that to all of B, to roundoff
+    const int Margin = 32;
+    const vector<double>& T = b.T();
+    const int i0 = max(0, int(std::lower_bound(T.begin(), T.end(), 2*t1-t2)-T.begin())-Margin);
+    const int i1 = min(int(T.size()), int(std::upper_bound(T.begin(), T.end(), 2*t2-t1)-T.begin())+Margin);
+    SplineArgB = PiecewiseCubic(vector<double>(T.begin()+i0, T.begin()+i1), vector<double>(b.Arg(LMb).begin()+i0, b.Arg(LMb).begin()+i1));
+    Evaluate(0.0);
   }
 
   int LM_a() { return LMa; }
+  unsigned int NEvaluations() const { return nEvaluations; }
+
+  /// Evaluate the objective and its derivative at the time offset dt
+  void Evaluate(const double dt) {
+    const unsigned int N = t.size();
+    for(unsigned int i=0; i<N; ++i) {
+      tb[i] = t[i]-dt;
+    }
+    SplineArgB.ValueAndDerivative(tb, argb, dargbdt);
+    double Integral = 0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      darg[i] = arga[i]-argb[i];
+      Integral += Weights[i]*darg[i];
+    }
+    dargLast = Integral / (t.back()-t[0]);
+    double f=0.0, df=0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      const double d = darg[i]-dargLast;
+      f += Weights[i]*d*d;
+      df += Weights[i]*d*dargbdt[i];
+    }
+    dtLast = dt;
+    fLast = f;
+    dfLast = 2.0*df;
+    ++nEvaluations;
+  }
+
+  /// The mean difference in the (2,2) phases at offset dt
+  double darg22(const double dt) {
+    if(dt!=dtLast) { Evaluate(dt); }
+    return dargLast;
+  }
 
-  double darg(const double dt, const unsigned int mode) const {
-    vector<double> argA = WaveformUtilities::Interpolate(a.T(), a.Arg(mode), t);
-    vector<double> argB = WaveformUtilities::Interpolate(b.T(), b.Arg(mode), t-dt);
-    // return trapz(t, argA-argB) / (t.back()-t[0]);
-    return SplineCumulativeIntegral(t, argA-argB) / (t.back()-t[0]);
+  double operator()(const double dt) {
+    if(dt!=dtLast) { Evaluate(dt); }
+    return fLast;
   }
 
-  double operator()(const double dt) const {
-    vector<double> argb = WaveformUtilities::Interpolate(b.T(), b.Arg(LMb), t-dt);
-    // double darg = trapz(t, arga-argb) / (t.back()-t[0]);
-    // return trapz(t, (arga-argb-darg)*(arga-argb-darg));
-    double darg = SplineCumulativeIntegral(t, arga-argb) / (t.back()-t[0]);
-    return SplineCumulativeIntegral(t, (arga-argb-darg)*(arga-argb-darg));
+  double df(const double dt) {
+    if(dt!=dtLast) { Evaluate(dt); }
+    return dfLast;
   }
 };
 
+/// Add m*darg22/2 to the phase of each mode of b, which has already
+/// been shifted in time to match a, plus the multiple of 2*pi that
+/// brings it closest to the phase of a at t2.
+static void AddPhaseOffsets(const Waveform& a, Waveform& b, const double t2, const double darg22) {
+  int Ia=0;
+  int Ib=0;
+  while(a.T(Ia)<t2 && Ia<int(a.NTimes())) { Ia++; }
+  while(b.T(Ib)<t2 && Ib<int(b.NTimes())) { Ib++; }
+  for(unsigned int mode=0; mode<a.NModes() && mode<b.NModes(); ++mode) {
+    b.ArgRef(mode) += (2.0 * M_PI * round((a.Arg(mode,Ia)-b.Arg(mode,Ib)-b.M(mode)*darg22/2.0)/(2.0*M_PI))) + b.M(mode)*darg22/2.0;
+  }
+  b.History() << "#### this->RotatePhase(" << darg22/2.0 << "); # Pseudo-command: Add (m times this phase) to each mode's phase." << endl;
+}
+
 /// Align phases of two Waveforms to within 2*pi at a fractional time in this Waveform of tFrac.
 Waveform& WaveformObjects::Waveform::AlignPhasesToTwoPi(const Waveform& a, const double tFrac) {
   if(tFrac<0 || tFrac>1) {
@@ -132,24 +207,126 @@ Waveform& WaveformObjects::Waveform::AlignPhasesToTwoPi(const Waveform& a, const
   return *this;
 }
 
-Waveform& WaveformObjects::Waveform::AlignTo(const Waveform& a, const double t1, const double t2) {
+Waveform& WaveformObjects::Waveform::AlignTo(const Waveform& a, const double t1, const double t2, unsigned int* NEvaluations) {
+  /// If NEvaluations is not null, it is set to the number of
+  /// evaluations of the objective function by the minimizer.
   History() << "### this->AlignTo(a, " << t1 << ", " << t2 << ");\n#" << flush;
   WaveformAligner Align(a, *this, t1, t2);
-  Brent Minimizer;
+  Dbrent Minimizer;
   Minimizer.ax = max(t1-t2, T(0)-t1);
   Minimizer.bx = 0.0;
   Minimizer.cx = min(t2-t1, T().back()-t2);
   double dt = Minimizer.minimize(Align);
-  const double darg22 = Align.darg(dt, Align.LM_a());
+  const double darg22 = Align.darg22(dt);
+  if(NEvaluations) { *NEvaluations = Align.NEvaluations(); }
   this->AddToTime(dt);
-  int Ia=0;
-  int Ithis=0;
-  while(a.T(Ia)<t2 && Ia<int(a.NTimes())) { Ia++; }
-  while(T(Ithis)<t2 && Ithis<int(NTimes())) { Ithis++; }
-  for(unsigned int mode=0; mode<a.NModes() && mode<NModes(); ++mode) {
-    ArgRef(mode) += (2.0 * M_PI * round((a.Arg(mode,Ia)-Arg(mode,Ithis)-M(mode)*darg22/2.0)/(2.0*M_PI))) + M(mode)*darg22/2.0;
+  AddPhaseOffsets(a, *this, t2, darg22);
+  return *this;
+}
+
+/// Interpolate Y(X) to the sorted times X2, splining only the part of
+/// the data that covers X2 (with a few extra points on either side, so
+/// that the spline's end conditions do not matter).
+static vector<double> InterpolateLocally(const vector<double>& X, const vector<double>& Y, const vector<double>& X2) {
+  const int Margin = 4;
+  const int i0 = max(0, int(std::upper_bound(X.begin(), X.end(), X2[0])-X.begin())-1-Margin);
+  const int i1 = min(int(X.size()), int(std::lower_bound(X.begin(), X.end(), X2.back())-X.begin())+1+Margin);
+  return WaveformUtilities::Interpolate(vector<double>(X.begin()+i0, X.begin()+i1), vector<double>(Y.begin()+i0, Y.begin()+i1), X2);
+}
+
+/// Align this Waveform to a in time and phase by maximizing the
+/// overlap of the (2,2) modes over [t1,t2], found from a single
+/// FFT-based cross-correlation rather than by minimization.  The
+/// modes are resampled to a uniform grid with spacing Step (by
+/// default, the smallest step of a in [t1,t2]), and the peak of the
+/// normalized overlap is refined to a fraction of Step by a parabola
+/// through the largest sample and its neighbors.  Shifts are limited
+/// to t2-t1 in either direction, and to those keeping [t1,t2] within
+/// this Waveform.
+Waveform& WaveformObjects::Waveform::AlignTo_FFT(const Waveform& a, const double t1, const double t2, const double Step) {
+  History() << "### this->AlignTo_FFT(a, " << t1 << ", " << t2 << ", " << Step << ");\n#" << flush;
+  WaveformAligner::Validate(a, *this, t1, t2);
+  const int LMa = WaveformAligner::Find22(a, "a");
+  const int LMb = WaveformAligner::Find22(*this, "b");
+
+  // Set up the grid: b is sampled on all of it, and a only in [t1,t2]
+  double dt = Step;
+  if(dt<=0.0) {
+    dt = t2-t1;
+    for(unsigned int i=1; i<a.NTimes(); ++i) {
+      if(a.T(i)>t1 && a.T(i-1)<t2 && a.T(i)-a.T(i-1)<dt) { dt = a.T(i)-a.T(i-1); }
+    }
+  }
+  const double g0 = max(T(0), 2*t1-t2);
+  const double g1 = min(T().back(), 2*t2-t1);
+  const int Nb = int((g1-g0)/dt) + 1;
+  const int ja0 = int(ceil((t1-g0)/dt));
+  const int ja1 = min(int((t2-g0)/dt), Nb-1);
+  if(ja1-ja0<2) {
+    cerr << "\nt1=" << t1 << "\tt2=" << t2 << "\tStep=" << dt << endl;
+    Throw1WithMessage("Too few samples in the alignment window");
+  }
+  unsigned int N = 2;
+  while(N<(unsigned int)(Nb)) { N <<= 1; }
+  vector<double> tb(Nb), ta(ja1-ja0+1);
+  for(int j=0; j<Nb; ++j) { tb[j] = g0+j*dt; }
+  for(int j=ja0; j<=ja1; ++j) { ta[j-ja0] = tb[j]; }
+  const vector<double> magb = InterpolateLocally(T(), Mag(LMb), tb);
+  const vector<double> argb = InterpolateLocally(T(), Arg(LMb), tb);
+  const vector<double> maga = InterpolateLocally(a.T(), a.Mag(LMa), ta);
+  const vector<double> arga = InterpolateLocally(a.T(), a.Arg(LMa), ta);
+
+  // c[k] = sum_j a[j] b*[j-k], which does not wrap around for the
+  // shifts k in [ja1-Nb+1, ja0]
+  WrapVecDoub A(2*N), B(2*N);
+  for(int j=ja0; j<=ja1; ++j) {
+    A.real(j) = maga[j-ja0]*cos(arga[j-ja0]);
+    A.imag(j) = maga[j-ja0]*sin(arga[j-ja0]);
+  }
+  vector<double> NormB(Nb+1, 0.0);
+  for(int j=0; j<Nb; ++j) {
+    B.real(j) = magb[j]*cos(argb[j]);
+    B.imag(j) = magb[j]*sin(argb[j]);
+    NormB[j+1] = NormB[j] + magb[j]*magb[j];
+  }
+  dft(A);
+  dft(B);
+  for(unsigned int i=0; i<N; ++i) {
+    A[i] *= std::conj(B[i]);
+  }
+  idft(A);
+
+  // Find the largest overlap, normalizing by the norm of the part of
+  // b that overlaps a at each shift (the factor of N is irrelevant)
+  const int kMin = ja1-Nb+1, kMax = ja0;
+  vector<double> Overlap(kMax-kMin+1);
+  int kBest = kMin;
+  for(int k=kMin; k<=kMax; ++k) {
+    Overlap[k-kMin] = std::abs(A[k]) / sqrt(NormB[ja1-k+1]-NormB[ja0-k]);
+    if(Overlap[k-kMin]>Overlap[kBest-kMin]) { kBest = k; }
   }
-  History() << "#### this->RotatePhase(" << darg22/2.0 << "); # Pseudo-command: Add (m times this phase) to each mode's phase." << endl;
+  double Fraction = 0.0;
+  if(kBest>kMin && kBest<kMax) {
+    const double ym = Overlap[kBest-1-kMin], y0 = Overlap[kBest-kMin], yp = Overlap[kBest+1-kMin];
+    if(ym-2*y0+yp<0.0) { Fraction = 0.5*(ym-yp)/(ym-2*y0+yp); }
+  }
+  const double Shift = (kBest+Fraction)*dt;
+
+  // The phase of the correlation turns by about omega*dt between
+  // samples -- often more than pi -- so it is not interpolated, but
+  // evaluated directly at the refined shift
+  vector<double> tShifted(ta);
+  for(unsigned int j=0; j<tShifted.size(); ++j) { tShifted[j] -= Shift; }
+  const vector<double> argbShifted = InterpolateLocally(T(), Arg(LMb), tShifted);
+  const vector<double> magbShifted = InterpolateLocally(T(), Mag(LMb), tShifted);
+  complex<double> Peak(0.0, 0.0);
+  for(unsigned int j=0; j<tShifted.size(); ++j) {
+    Peak += std::polar(maga[j]*magbShifted[j], arga[j]-argbShifted[j]);
+  }
+  const double darg22 = std::arg(Peak);
+  History() << "# Correlated " << N << " samples with spacing " << dt << "\n#" << flush;
+  this->AddToTime(Shift);
+  AddPhaseOffsets(a, *this, t2, darg22);
   return *this;
 }
 
@@ -211,101 +388,19 @@ Waveform WaveformObjects::Waveform::HybridizeWith(const Waveform& b, const doubl
   return c;
 }
 
-inline double sign(const double x) {
-  return (x<0 ? -1.0 : 1.0);
-}
-
 Waveform& WaveformObjects::Waveform::AlignTo_F(const Waveform& a, const double omega, const double t1, const double t2, const double DeltaT, const double MinStep) {
   if(omega==0.0) {
     cerr << "\nThe frequency input to AlignTo_F is exactly 0.0.  This will give you garbage" << endl;
     Throw1WithMessage("Bad frequency");
   }
-  unsigned int i=0;
   double T1(t1), T2(t2);
   if(T1<a.T(0)) { T1=a.T(0); }
   if(T1<  T(0)) { T1=  T(0); }
   if(T2>a.T().back()) { T2=a.T().back(); }
   if(T2>  T().back()) { T2=  T().back(); }
-  WaveformAligner Align(a, *this, T1, T2);
-  vector<double> NewTimeA(a.T());
-  vector<double> NewOmegaA(a.Omega2m2());
-  const double NewOmegaASign = sign(NewOmegaA[NewOmegaA.size()/2]);
-  vector<double> NewTimeB(T());
-  vector<double> NewOmegaB(Omega2m2());
-  const double NewOmegaBSign = sign(NewOmegaB[NewOmegaB.size()/2]);
-  try {
-    /// Make sure A only includes data before T2
-    i=NewTimeA.size()-1;
-    while(NewTimeA[i]>T2 && i>0) { --i; }
-    if(i!=NewTimeA.size()-1) {
-      NewTimeA.erase(NewTimeA.begin()+i, NewTimeA.begin()+NewTimeA.size());
-      NewOmegaA.erase(NewOmegaA.begin()+i, NewOmegaA.begin()+NewOmegaA.size());
-    }
-    /// Make sure A only includes data after T1
-    i=0;
-    while(i<NewTimeA.size() && NewTimeA[i]<T1) { ++i; }
-    if(i!=0) {
-      NewTimeA.erase(NewTimeA.begin(), NewTimeA.begin()+i);
-      NewOmegaA.erase(NewOmegaA.begin(), NewOmegaA.begin()+i);
-    }
-    /// Make sure NewOmegaA gets up to abs(omega), but is strictly monotonically increasing before it
-    i=1;
-    while(i<NewOmegaA.size() && NewOmegaASign*NewOmegaA[i]<fabs(omega)) { ++i; }
-    while(i>0 && NewOmegaASign*NewOmegaA[i-1]<NewOmegaASign*NewOmegaA[i]) { --i; }
-    if(i!=1) {
-      NewTimeA.erase(NewTimeA.begin(), NewTimeA.begin()+i);
-      NewOmegaA.erase(NewOmegaA.begin(), NewOmegaA.begin()+i);
-    }
-    /// Make sure NewOmegaA gets past abs(omega), and is strictly monotonically increasing afterward
-    i=1;
-    while(i<NewTimeA.size() && NewOmegaASign*NewOmegaA[i]<fabs(omega)) { ++i; }
-    while(i<NewTimeA.size() && NewOmegaASign*NewOmegaA[i]>NewOmegaASign*NewOmegaA[i-1]) { ++i; }
-    if(i!=1) {
-      NewTimeA.erase(NewTimeA.begin()+i, NewTimeA.begin()+NewTimeA.size());
-      NewOmegaA.erase(NewOmegaA.begin()+i, NewOmegaA.begin()+NewOmegaA.size());
-    }
-
-    /// Make sure B only includes data before T2
-    i=NewTimeB.size()-1;
-    while(NewTimeB[i]>T2 && i>0) { --i; }
-    if(i!=NewTimeB.size()-1) {
-      NewTimeB.erase(NewTimeB.begin()+i, NewTimeB.begin()+NewTimeB.size());
-      NewOmegaB.erase(NewOmegaB.begin()+i, NewOmegaB.begin()+NewOmegaB.size());
-    }
-    /// Make sure B only includes data after T1
-    i=0;
-    while(i<NewTimeB.size() && NewTimeB[i]<T1) { ++i; }
-    if(i!=0) {
-      NewTimeB.erase(NewTimeB.begin(), NewTimeB.begin()+i);
-      NewOmegaB.erase(NewOmegaB.begin(), NewOmegaB.begin()+i);
-    }
-    /// Make sure NewOmegaB gets up to fabs(omega), but is strictly monotonically increasing before it
-    i=1;
-    while(i<NewOmegaB.size() && NewOmegaBSign*NewOmegaB[i]<fabs(omega)) { ++i; }
-    while(i>0 && NewOmegaBSign*NewOmegaB[i-1]<NewOmegaBSign*NewOmegaB[i]) { --i; }
-    if(i>1) {
-      NewTimeB.erase(NewTimeB.begin(), NewTimeB.begin()+i);
-      NewOmegaB.erase(NewOmegaB.begin(), NewOmegaB.begin()+i);
-    }
-    /// Make sure NewOmegaB gets past fabs(omega), and is strictly monotonically increasing afterward
-    i=1;
-    while(i<NewOmegaB.size() && NewOmegaBSign*NewOmegaB[i]<fabs(omega)) { ++i; }
-    while(i<NewTimeB.size() && NewOmegaBSign*NewOmegaB[i]>NewOmegaBSign*NewOmegaB[i-1]) { ++i; }
-    if(i>1) {
-      NewTimeB.erase(NewTimeB.begin()+i, NewTimeB.begin()+NewTimeB.size());
-      NewOmegaB.erase(NewOmegaB.begin()+i, NewOmegaB.begin()+NewOmegaB.size());
-    }
-  } catch (char* str) {
-    cerr << "Bad news from AlignTo_F: " << str << endl
-         << "\nThe frequency requested is probably out of range of one or both of the Waveforms, or your t1 and t2 are too restrictive.\n" << endl;
-    exit(1);
-  }
-  const double TA = WaveformUtilities::Interpolate(NewOmegaA, NewTimeA, NewOmegaASign*fabs(omega));
-  NewOmegaA.clear();
-  NewTimeA.clear();
-  const double TB = WaveformUtilities::Interpolate(NewOmegaB, NewTimeB, NewOmegaBSign*fabs(omega));
-  NewOmegaB.clear();
-  NewTimeB.clear();
+  WaveformAligner::Validate(a, *this, T1, T2);
+  const double TA = WaveformUtilities::FrequencyMatchingTime(a.T(), a.Omega2m2(), T1, T2, omega);
+  const double TB = WaveformUtilities::FrequencyMatchingTime(T(), Omega2m2(), T1, T2, omega);
 
   const double dt = TA-TB;
   TRef() += dt;
@@ -328,14 +423,230 @@ Waveform WaveformObjects::Waveform::HybridizeWith_F(const Waveform& a, const dou
   return b;
 }
 
-Waveform& WaveformObjects::Waveform::AttachQNMs(const double delta, const double chiKerr, double dt, const double TLength) {
+/// Basis functions for the overtones n>=1 of a ringdown
+/// h(tau)=sum_n C_n*exp[(i*omegaRe_n-omegaIm_n)*tau], where C_0 is
+/// eliminated by requiring h(0)=h0, so that the n-th function is
+/// exp[(i*omegaRe_n-omegaIm_n)*tau]-exp[(i*omegaRe_0-omegaIm_0)*tau],
+/// with complex amplitude a[2*n-2]+i*a[2*n-1].  The real and imaginary
+/// parts of the data are fit together: x=(tau,0) is a real-part
+/// sample, and x=(tau,1) is an imaginary-part sample.
+class QNMOvertoneBasisFunctions {
+private:
+  const vector<double>& omegaRe;
+  const vector<double>& omegaIm;
+public:
+  QNMOvertoneBasisFunctions(const vector<double>& OmegaRe, const vector<double>& OmegaIm)
+    : omegaRe(OmegaRe), omegaIm(OmegaIm) { }
+  VecDoub operator()(VecDoub_I& x) const {
+    VecDoub ans(2*omegaRe.size()-2);
+    const double Decay0 = exp(-omegaIm[0]*x[0]);
+    const double c0 = Decay0*cos(omegaRe[0]*x[0]);
+    const double s0 = Decay0*sin(omegaRe[0]*x[0]);
+    for(unsigned int n=1; n<omegaRe.size(); ++n) {
+      const double Decay = exp(-omegaIm[n]*x[0]);
+      const double c = Decay*cos(omegaRe[n]*x[0]) - c0;
+      const double s = Decay*sin(omegaRe[n]*x[0]) - s0;
+      if(x[1]==0.0) {
+        ans[2*n-2] = c;
+        ans[2*n-1] = -s;
+      } else {
+        ans[2*n-2] = s;
+        ans[2*n-1] = c;
+      }
+    }
+    return ans;
+  }
+  VecDoub operator()(Doub tau) const { // Real part only
+    VecDoub x(2);
+    x[0] = tau;
+    x[1] = 0.0;
+    return this->operator()(x);
+  }
+};
+
+/// Index of the first time kept by Waveform::DropBefore(time)
+static unsigned int DropBeforeIndex(const vector<double>& t, const double time) {
+  unsigned int i=0;
+  while(i<t.size()-1 && t[i+1]<=time) { ++i; }
+  return i;
+}
+
+/// Index one past the last time kept by Waveform::DropAfter(time),
+/// applied to the data starting at index i1
+static unsigned int DropAfterIndex(const vector<double>& t, const unsigned int i1, const double time) {
+  unsigned int i=t.size()-1;
+  while(i>i1 && t[i]>time) { --i; }
+  return i;
+}
+
+/// Find the time at which the magnitude decays at the rate omegaIm by
+/// interpolating d|h|/dt+omegaIm*|h| to zero.  Most of this is
+/// dedicated to making sure that interpolation is well-posed.
+static double QNMMatchingTime(const vector<double>& t, const vector<double>& mag, const double omegaIm, const bool TrimRising) {
+  vector<double> Fvec = dydx(mag, t) + (mag * abs(omegaIm));
+  vector<double> Tvec = t;
+  unsigned int k=1;
+  if(TrimRising || Fvec[0]>0.0) {
+    while(k<Fvec.size() && Fvec[k]>Fvec[k-1]) { ++k; }
+    Fvec.erase(Fvec.begin(), Fvec.begin()+k);
+    Tvec.erase(Tvec.begin(), Tvec.begin()+k);
+    k=1;
+  }
+  while(k<Fvec.size() && Fvec[k]<Fvec[k-1]) { ++k; }
+  Fvec.erase(Fvec.begin()+k, Fvec.end());
+  Tvec.erase(Tvec.begin()+k, Tvec.end());
+  return WaveformUtilities::Interpolate(Fvec, Tvec, 0.0);
+}
+
+/// Replace the data of one mode after its peak by a ringdown with the
+/// given QNM frequencies (the first being the n=0 overtone).  This
+/// touches nothing but its arguments, so modes are independent.
+static void AttachQNMsToMode(const vector<double>& t, vector<double>& mag, vector<double>& arg,
+                             const vector<double>& omegaRe, const vector<double>& omegaIm,
+                             const double TEnd, const bool TailoredToq10chis095, unsigned int QNMi1)
+{
+  const unsigned int NTimes = t.size();
+
+  //// Extract the invertible data of the mode
+  unsigned int iPeak=maxIndex(mag);
+  const double tDropBefore(t[iPeak]);
+  unsigned int i=iPeak;
+  i++;
+  while(mag[i] < mag[i-1] && t[i]<TEnd) { ++i; }
+  const unsigned int iBad=i;
+  const double tDropAfter(t[iBad]);
+  unsigned int i1 = DropBeforeIndex(t, tDropBefore);
+  unsigned int i2 = DropAfterIndex(t, i1, tDropAfter);
+  vector<double> tInspiral(t.begin()+i1, t.begin()+i2);
+  vector<double> magInspiral(mag.begin()+i1, mag.begin()+i2);
+
+  //// Find the solution
+  double tmatch = QNMMatchingTime(tInspiral, magInspiral, omegaIm[0], false);
+  if(TailoredToq10chis095) {
+    iPeak = NTimes-1;
+    while(t[iPeak] > -40.0 && iPeak>1) { --iPeak; }
+    QNMi1 = iPeak;
+    i1 = DropBeforeIndex(t, t[iPeak]);
+    i2 = DropAfterIndex(t, i1, TEnd-1.0);
+    tInspiral.assign(t.begin()+i1, t.begin()+i2);
+    magInspiral.assign(mag.begin()+i1, mag.begin()+i2);
+    const double tLength = tInspiral.back()-tInspiral[0];
+    for(unsigned int j=0; j<tInspiral.size(); ++j) {
+      magInspiral[j] *= (1.0-TransitionFunction_Smooth((tInspiral[j]-tInspiral[0])/tLength));
+      mag[j+i1] = magInspiral[j];
+    }
+    tmatch = QNMMatchingTime(tInspiral, magInspiral, omegaIm[0], true);
+  } else if(tmatch<tDropBefore || tmatch>tDropAfter) {
+    i1 = DropBeforeIndex(t, tDropBefore);
+    i2 = DropAfterIndex(t, i1, TEnd);
+    tInspiral.assign(t.begin()+i1, t.begin()+i2);
+    magInspiral.assign(mag.begin()+i1, mag.begin()+i2);
+    const double tFakeRingdown = std::min(tInspiral[0]+50.0, tInspiral.back());
+    const double tLength = tFakeRingdown-tInspiral[0];
+    for(unsigned int j=0; j<tInspiral.size(); ++j) {
+      magInspiral[j] *= (1.0-TransitionFunction_Smooth((tInspiral[j]-tInspiral[0])/tLength));
+      mag[j+i1] = magInspiral[j];
+    }
+    tmatch = QNMMatchingTime(tInspiral, magInspiral, omegaIm[0], false);
+  }
+  const double magMatch = WaveformUtilities::Interpolate(tInspiral, magInspiral, tmatch);
+  i=iPeak;
+  while(tmatch>t[i] && i<NTimes) { ++i; }
+  const unsigned int iMatch=i; // iMatch points at or to the right of tmatch
+
+  //// Ramp the frequency linearly from its value at the peak to the QNM frequency
+  const double phiPeak = arg[iPeak];
+  const double omegaPeak = (arg[iPeak+1]-arg[iPeak-1]) / (t[iPeak+1]-t[iPeak-1]);
+  const double omegaQNM = omegaRe[0];
+  vector<double> omegaTransition(iMatch-iPeak, omegaPeak);
+  for(unsigned int k=1; k<omegaTransition.size(); ++k) {
+    omegaTransition[k] = omegaPeak + (omegaQNM-omegaPeak)*TransitionFunction_Linear((t[k+iPeak]-t[iPeak])/(t[iMatch-1]-t[iPeak]));
+  }
+  vector<double> phiTransition(iMatch-iPeak, phiPeak);
+  for(unsigned int k=1; k<phiTransition.size(); ++k) {
+    phiTransition[k] = phiTransition[k-1] + (t[k+iPeak]-t[k+iPeak-1])*(omegaTransition[k]+omegaTransition[k-1])/2.0;
+  }
+  for(unsigned int j=iPeak; j<iMatch; ++j) {
+    arg[j] = phiTransition[j-iPeak];
+  }
+  const double phiOffset = phiTransition.back() + omegaTransition.back()*(tmatch-t[iMatch-1]);
+
+  //// Read data into the QNM portion of the waveform
+  unsigned int iFit=iMatch-1;
+  while(iFit>0 && t[iFit-1]>=tmatch-1.0/omegaIm[0]) { --iFit; }
+  const unsigned int NSamples = iMatch-iFit;
+  const unsigned int NModes = std::min(NSamples+1, (unsigned int)(omegaRe.size()));
+  if(NModes==1) {
+    /// A single damped sinusoid matched at tmatch has constant
+    /// frequency, so no trigonometric functions are needed
+    const double AbsAlm0 = std::fabs(magMatch);
+    for(unsigned int j=iMatch; j<NTimes; ++j) {
+      mag[j] = AbsAlm0 * exp(-omegaIm[0]*(t[j]-tmatch));
+      arg[j] = omegaRe[0]*(t[j]-tmatch) + phiOffset;
+    }
+  } else {
+    /// Fit the complex amplitudes of the overtones by least squares to
+    /// the (phase-ramped) data over one e-folding time of the n=0 mode
+    /// before tmatch, with the n=0 amplitude fixed so that the
+    /// ringdown starts continuously
+    const vector<double> OvertonesRe(omegaRe.begin(), omegaRe.begin()+NModes);
+    const vector<double> OvertonesIm(omegaIm.begin(), omegaIm.begin()+NModes);
+    const double h0Re = magMatch*cos(phiOffset);
+    const double h0Im = magMatch*sin(phiOffset);
+    MatDoub x(2*NSamples, 2);
+    VecDoub y(2*NSamples), sig(2*NSamples, 1.0);
+    for(unsigned int k=0; k<NSamples; ++k) {
+      const double tau = t[iFit+k]-tmatch;
+      const double Decay0 = exp(-OvertonesIm[0]*tau);
+      const double c0 = Decay0*cos(OvertonesRe[0]*tau);
+      const double s0 = Decay0*sin(OvertonesRe[0]*tau);
+      x[2*k][0] = x[2*k+1][0] = tau;
+      x[2*k][1] = 0.0;
+      x[2*k+1][1] = 1.0;
+      y[2*k] = mag[iFit+k]*cos(arg[iFit+k]) - (h0Re*c0 - h0Im*s0);
+      y[2*k+1] = mag[iFit+k]*sin(arg[iFit+k]) - (h0Im*c0 + h0Re*s0);
+    }
+    const QNMOvertoneBasisFunctions Basis(OvertonesRe, OvertonesIm);
+    FitSVD<QNMOvertoneBasisFunctions> Amplitudes(x, y, sig, Basis);
+    Amplitudes.fit();
+    vector<double> CRe(NModes, h0Re), CIm(NModes, h0Im);
+    for(unsigned int n=1; n<NModes; ++n) {
+      CRe[n] = Amplitudes.a[2*n-2];
+      CIm[n] = Amplitudes.a[2*n-1];
+      CRe[0] -= CRe[n];
+      CIm[0] -= CIm[n];
+    }
+    for(unsigned int j=iMatch; j<NTimes; ++j) {
+      const double tau = t[j]-tmatch;
+      double qnmRe=0.0, qnmIm=0.0;
+      for(unsigned int n=0; n<NModes; ++n) {
+        const double Decay = exp(-OvertonesIm[n]*tau);
+        const double c = Decay*cos(OvertonesRe[n]*tau);
+        const double s = Decay*sin(OvertonesRe[n]*tau);
+        qnmRe += CRe[n]*c - CIm[n]*s;
+        qnmIm += CIm[n]*c + CRe[n]*s;
+      }
+      mag[j] = sqrt(qnmRe*qnmRe + qnmIm*qnmIm);
+      arg[j] = atan2(qnmIm, qnmRe);
+    }
+  }
+  const unsigned int iUnwrap = std::min(QNMi1, iPeak);
+  Unwrap(arg, (iUnwrap>10 ? iUnwrap-10 : 0), NTimes); // Unwrap just the new part of the data
+}
+
+/// Attach a ringdown to each mode, starting from the peak of its
+/// magnitude.  With NOvertones>1, the complex amplitudes of the first
+/// NOvertones overtones are fit to the data just before the matching
+/// time; otherwise, the n=0 mode is matched at that time.
+Waveform& WaveformObjects::Waveform::AttachQNMs(const double delta, const double chiKerr, double dt, const double TLength,
+                                                const unsigned int NOvertones) {
 //   if(LM() != QNMLMs()) {
 //     cerr << "LM=" << LM() << "\nQNMLMs()=" << QNMLMs() << endl;
 //     Throw1WithMessage("Bad input LMs.");
 //   }
 
   if(dt==0.0) { dt = 2*M_PI/(4*2.07); } // 2.07 -> MAX(omegaRe of all the QNM modes)
-  History() << "### this->AttachQNMs(" << chiKerr << ", " << dt << ", " << TLength << ");" << endl;
+  History() << "### this->AttachQNMs(" << chiKerr << ", " << dt << ", " << TLength << ", " << NOvertones << ");" << endl;
 
   /// Add the new times, and resize everything as appropriate
   const double TPeak = Peak22Time();
@@ -354,142 +665,26 @@ Waveform& WaveformObjects::Waveform::AttachQNMs(const double delta, const double
     this->Interpolate(NewTimes, ExtrapVal);
   }
 
-//   const unsigned int NTimesEnd = NTimes();
-//   TRef().resize(NTimes()+int(floor(TLength/dt)), T().back());
-//   for(unsigned int i=0; i<NTimes()-NTimesEnd; ++i) {
-//     TRef(i+NTimesEnd) += (i+1)*dt;
-//   }
-//   if(R().size()>1) { RRef().resize(NTimes(), 0.0); }
-//   MagRef().resize(NModes(), NTimes(), 0.0);
-//   ArgRef().resize(NModes(), NTimes(), 0.0);
-
+  const bool TailoredToq10chis095 = (delta==deltaOFq(10.0) && chiKerr==FinalSpinApproximation(deltaOFq(10), 0.95));
   for(unsigned int mode=0; mode<NModes(); ++mode) {
     //// If this mode should be exactly zero, let it be
     if(delta==0.0 && !(M(mode)%2==0)) {
       continue;
     }
 
-    //// Get the QNM frequency
-    double omegaRe, omegaIm;
-    QNM(L(mode), M(mode), 0, chiKerr, omegaRe, omegaIm);
-
-    //// Extract the invertible data of the l,m mode
-    unsigned int iPeak=maxIndex(Mag(mode));
-    const double tDropBefore(T(iPeak));
-    unsigned int i=iPeak;
-    i++;
-    while(Mag(mode, i) < Mag(mode, i-1) && T(i)<TEnd) { ++i; }
-    const unsigned int iBad=i;
-    const double tDropAfter(T(iBad));
-    Waveform InspiralLM((this->operator[](mode)).DropBefore(tDropBefore).DropAfter(tDropAfter));
-
-    //// Find the solution.  Most of this is dedicated to making sure the interpolation of Fvec and Tvec is well-posed
-    vector<double> Fvec = dydx(InspiralLM.Mag(0), InspiralLM.T()) + (InspiralLM.Mag(0) * abs(omegaIm));
-    vector<double> Tvec = InspiralLM.T();
-    {
-      unsigned int k=1;
-      if(Fvec[0]>0.0) {
-        while(Fvec[k]>Fvec[k-1] && k<Fvec.size()) { ++k; }
-        Fvec.erase(Fvec.begin(), Fvec.begin()+k);
-        Tvec.erase(Tvec.begin(), Tvec.begin()+k);
-        k=1;
-      }
-      while(Fvec[k]<Fvec[k-1]) { ++k; }
-      Fvec.erase(Fvec.begin()+k, Fvec.end());
-      Tvec.erase(Tvec.begin()+k, Tvec.end());
-    }
-    double tmatch = WaveformUtilities::Interpolate(Fvec, Tvec, 0.0);
-
-    if((delta==deltaOFq(10.0) && chiKerr==FinalSpinApproximation(deltaOFq(10), 0.95))) {
-      //cout << "Redoing tmatch find! (tailored to q==10 && chis==0.95)" << endl;
-      iPeak = NTimes()-1;
-      while(T(iPeak) > -40.0 && iPeak>1) { --iPeak; }
-      QNMi1 = iPeak;
-      InspiralLM = (this->operator[](mode)).DropBefore(T(iPeak)).DropAfter(TEnd-1.0);
-      //cout << "InspiralLM.NTimes()=" << InspiralLM.NTimes()
-      //     << " InspiralLM.T(0)=" << InspiralLM.T(0)
-      //     << " InspiralLM.T().back()=" << InspiralLM.T().back() << endl;
-      const double tLength = InspiralLM.T().back()-InspiralLM.T(0);
-      for(unsigned int j=0; j<InspiralLM.NTimes(); ++j) {
-        InspiralLM.MagRef(0,j) *= (1.0-TransitionFunction_Smooth((InspiralLM.T(j)-InspiralLM.T(0))/tLength));
-        MagRef(mode, j+iPeak) = InspiralLM.Mag(0, j);
-      }
-      Fvec = dydx(InspiralLM.Mag(0), InspiralLM.T()) + (InspiralLM.Mag(0) * abs(omegaIm));
-      Tvec = InspiralLM.T();
-      {
-        unsigned int k=1;
-        while(Fvec[k]>Fvec[k-1] && k<Fvec.size()) { ++k; }
-        Fvec.erase(Fvec.begin(), Fvec.begin()+k);
-        Tvec.erase(Tvec.begin(), Tvec.begin()+k);
-        k=1;
-        while(Fvec[k]<Fvec[k-1] && k<Fvec.size()) { ++k; }
-        Fvec.erase(Fvec.begin()+k, Fvec.end());
-        Tvec.erase(Tvec.begin()+k, Tvec.end());
-      }
-      tmatch = WaveformUtilities::Interpolate(Fvec, Tvec, 0.0);
-    } else if(tmatch<tDropBefore || tmatch>tDropAfter) {
-      //cout << "Redoing tmatch find!" << endl;
-      InspiralLM = (this->operator[](mode)).DropBefore(tDropBefore).DropAfter(TEnd);
-      const double tFakeRingdown = std::min(InspiralLM.T(0)+50.0, InspiralLM.T().back());
-      const double tLength = tFakeRingdown-InspiralLM.T(0);
-      for(unsigned int j=0; j<InspiralLM.NTimes(); ++j) {
-        InspiralLM.MagRef(0, j) *= (1.0-TransitionFunction_Smooth((InspiralLM.T(j)-InspiralLM.T(0))/tLength));
-        MagRef(mode, j+iPeak) = InspiralLM.Mag(0, j);
-      }
-      Fvec = dydx(InspiralLM.Mag(0), InspiralLM.T()) + (InspiralLM.Mag(0) * abs(omegaIm));
-      Tvec = InspiralLM.T();
-      {
-        unsigned int k=1;
-        if(Fvec[0]>0.0) {
-          while(Fvec[k]>Fvec[k-1] && k<Fvec.size()) { ++k; }
-          Fvec.erase(Fvec.begin(), Fvec.begin()+k);
-          Tvec.erase(Tvec.begin(), Tvec.begin()+k);
-          k=1;
-        }
-        while(Fvec[k]<Fvec[k-1]) { ++k; }
-        Fvec.erase(Fvec.begin()+k, Fvec.end());
-        Tvec.erase(Tvec.begin()+k, Tvec.end());
+    //// Get the QNM frequencies
+    vector<double> omegaRe(1), omegaIm(1);
+    if(NOvertones>1) {
+      QNMOvertones(L(mode), M(mode), chiKerr, omegaRe, omegaIm);
+      if(omegaRe.size()>NOvertones) {
+        omegaRe.resize(NOvertones);
+        omegaIm.resize(NOvertones);
       }
-      tmatch = WaveformUtilities::Interpolate(Fvec, Tvec, 0.0);
-      //if(L(mode)==2 && M(mode)==2) {
-      //  ofstream ofs("Outputs/F.dat", ofstream::out);
-      //  for(unsigned int k=0; k<Fvec.size(); ++k) {
-      //  ofs << setprecision(14) << Tvec[k] << " " << Fvec[k] << " " << InspiralLM.Mag(0, k) << endl;
-      //}
-      //ofs.close();
-      //}
+    } else {
+      QNM(L(mode), M(mode), 0, chiKerr, omegaRe[0], omegaIm[0]);
     }
-    InspiralLM = InspiralLM.Interpolate(tmatch);
-    const double Alm0Re = (InspiralLM.Mag(0,0))*cos(InspiralLM.Arg(0,0));
-    const double Alm0Im = (InspiralLM.Mag(0,0))*sin(InspiralLM.Arg(0,0));
-    i=iPeak;
-    while(tmatch>T(i) && i<NTimes()) { ++i; }
-    const unsigned int iMatch=i; // iMatch points at or to the right of tmatch
-
-    //// Read data into the QNM portion of the waveform
-    const double phiPeak = Arg(mode, iPeak);
-    const double omegaPeak = (Arg(mode, iPeak+1)-Arg(mode, iPeak-1)) / (T(iPeak+1)-T(iPeak-1));
-    const double omegaQNM = omegaRe;
-    //cout << "L=" << L(mode) << " M=" << M(mode) << setprecision(14) << " tPeak=" << tDropBefore << " tmatch=" << tmatch << " tBad=" << tDropAfter << " omegaPeak=" << omegaPeak << " omegaQNM=" << omegaQNM << endl;
-    vector<double> omegaTransition(iMatch-iPeak, omegaPeak);
-    for(unsigned int k=1; k<omegaTransition.size(); ++k) {
-      omegaTransition[k] = omegaPeak + (omegaQNM-omegaPeak)*TransitionFunction_Linear((T(k+iPeak)-T(iPeak))/(T(iMatch-1)-T(iPeak)));
-    }
-    vector<double> phiTransition(iMatch-iPeak, phiPeak);
-    for(unsigned int k=1; k<phiTransition.size(); ++k) {
-      phiTransition[k] = phiTransition[k-1] + (T(k+iPeak)-T(k+iPeak-1))*(omegaTransition[k]+omegaTransition[k-1])/2.0;
-    }
-    for(unsigned int j=iPeak; j<iMatch; ++j) {
-      ArgRef(mode, j) = phiTransition[j-iPeak];
-    }
-    const double phiOffset = phiTransition.back() + omegaTransition.back()*(tmatch-T(iMatch-1));
-    for(unsigned int j=iMatch; j<NTimes(); ++j) {
-      const double qnmRe = Alm0Re*cos(omegaRe*(T(j)-tmatch)) - Alm0Im*sin(omegaRe*(T(j)-tmatch));
-      const double qnmIm = Alm0Im*cos(omegaRe*(T(j)-tmatch)) + Alm0Re*sin(omegaRe*(T(j)-tmatch));
-      MagRef(mode, j) = sqrt(qnmRe*qnmRe + qnmIm*qnmIm) * exp(-omegaIm*(T(j)-tmatch));
-      ArgRef(mode, j) = atan2(qnmIm, qnmRe) + phiOffset - atan2(Alm0Im, Alm0Re);
-    }
-    Unwrap(ArgRef(mode), QNMi1-10, NTimes()); // Unwrap just the new part of the data
+
+    AttachQNMsToMode(T(), MagRef(mode), ArgRef(mode), omegaRe, omegaIm, TEnd, TailoredToq10chis095, QNMi1);
   }
   return *this;
 }
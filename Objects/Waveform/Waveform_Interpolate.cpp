@@ -37,9 +37,22 @@ using std::ios_base;
 
 /// Interpolate Waveform to a new time vector.
 Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewTime) {
+  MultiSplineInterpolator Spline(T(), NewTime);
+  return this->Interpolate(NewTime, Spline);
+}
+
+/// Interpolate Waveform to a new time vector, using a
+/// MultiSplineInterpolator from T() to NewTime, which may be shared
+/// with other Waveforms having the same times.
+Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewTime, MultiSplineInterpolator& Spline) {
   History() << "### this->Interpolate(const vector<double>& NewTime);" << endl;
+  if(Spline.NIn()!=NTimes() || Spline.NOut()!=NewTime.size()) {
+    cerr << "\nSpline.NIn()=" << Spline.NIn() << "\tNTimes()=" << NTimes()
+         << "\tSpline.NOut()=" << Spline.NOut() << "\tNewTime.size()=" << NewTime.size() << endl;
+    Throw1WithMessage("Spline does not match this interpolation");
+  }
   if(R().size()==NTimes()) {
-    RRef() = WaveformUtilities::Interpolate(T(), R(), NewTime);
+    RRef() = Spline(R());
   }
   if(Frame().size()>1) {
     FrameRef() = Squad(Frame(), T(), NewTime);
@@ -48,8 +61,8 @@ Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewT
   WaveformUtilities::Matrix<double> Newarg(NModes(), NewTime.size());
   //ORIENTATION!!! 4 following lines
   for(unsigned int i=0; i<NModes(); ++i) {
-    Newmag[i] = WaveformUtilities::Interpolate(t, Mag(i), NewTime);
-    Newarg[i] = WaveformUtilities::Interpolate(t, Arg(i), NewTime);
+    Spline(Mag(i), Newmag[i]);
+    Spline(Arg(i), Newarg[i]);
   }
   Newmag.swap(MagRef());
   Newarg.swap(ArgRef());
@@ -60,8 +73,11 @@ Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewT
 /// Interpolate Waveform to a new time vector, returning ExtrapVal when out of range.
 Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewTime, const double ExtrapVal) {
   History() << "### this->Interpolate(const vector<double>& NewTime, " << ExtrapVal << ");" << endl;
+  MultiSplineInterpolator Spline(T(), NewTime);
   if(R().size()==NTimes()) {
-    RRef() = WaveformUtilities::Interpolate(T(), R(), NewTime, R().back());
+    vector<double> NewR;
+    Spline(R(), NewR, R().back());
+    RRef().swap(NewR);
   }
   if(Frame().size()>1) {
     FrameRef() = Squad(Frame(), T(), NewTime);
@@ -70,8 +86,8 @@ Waveform& WaveformObjects::Waveform::Interpolate(const std::vector<double>& NewT
   WaveformUtilities::Matrix<double> Newarg(NModes(), NewTime.size());
   //ORIENTATION!!! 4 following lines
   for(unsigned int i=0; i<NModes(); ++i) {
-    Newmag[i] = WaveformUtilities::Interpolate(T(), Mag(i), NewTime, ExtrapVal);
-    Newarg[i] = WaveformUtilities::Interpolate(T(), Arg(i), NewTime, Arg(i).back());
+    Spline(Mag(i), Newmag[i], ExtrapVal);
+    Spline(Arg(i), Newarg[i], Arg(i).back());
   }
   Newmag.swap(mag);
   Newarg.swap(arg);
@@ -13,6 +13,7 @@
 #include "SWSHs.hpp"
 #include "EasyParser.hpp"
 #include "VectorFunctions.hpp"
+#include "VectorMath.hpp"
 #include "Utilities.hpp"
 #include "Units.hpp"
 #include "PostNewtonian.hpp"
@@ -168,9 +169,7 @@ Waveform& WaveformObjects::Waveform::FixNonOscillatingData() {
   //ORIENTATION!!! following loop
   for(unsigned int i=0; i<NModes(); ++i) { // Loop over components
     if(M(i)==0) {
-      vector<double> Im = Mag(i) * sin(Arg(i));
-      MagRef(i) = Mag(i) * cos(Arg(i));
-      ArgRef(i) = Im;
+      PolarToCartesian(Mag(i), Arg(i), MagRef(i), ArgRef(i));
     }
   }
   return *this;
@@ -181,9 +180,7 @@ Waveform& WaveformObjects::Waveform::UnfixNonOscillatingData() {
   //ORIENTATION!!! following loop
   for(unsigned int i=0; i<NModes(); ++i) { // Loop over components
     if(M(i)==0) {
-      vector<double> Re = Mag(i);
-      vector<double> Im = Arg(i);
-      MagArg(Re, Im, MagRef(i), ArgRef(i));
+      MagArg(Mag(i), Arg(i), MagRef(i), ArgRef(i));
     }
   }
   return *this;
@@ -193,9 +190,7 @@ Waveform& WaveformObjects::Waveform::ConvertReImToMagArg() {
   History() << "### this->ConvertReImToMagArg();" << endl;
   //ORIENTATION!!! following loop
   for(unsigned int i=0; i<NModes(); ++i) { // Loop over components
-    vector<double> Re = Mag(i);
-    vector<double> Im = Arg(i);
-    MagArg(Re, Im, MagRef(i), ArgRef(i));
+    MagArg(Mag(i), Arg(i), MagRef(i), ArgRef(i));
   }
   return *this;
 }
@@ -204,9 +199,7 @@ Waveform& WaveformObjects::Waveform::ConvertMagArgToReIm() {
   History() << "### this->ConvertMagArgToReIm();" << endl;
   //ORIENTATION!!! following loop
   for(unsigned int i=0; i<NModes(); ++i) { // Loop over components
-    const vector<double> Im = Mag(i) * sin(Arg(i));
-    MagRef(i) = Mag(i) * cos(Arg(i));
-    ArgRef(i) = Im;
+    PolarToCartesian(Mag(i), Arg(i), MagRef(i), ArgRef(i));
   }
   return *this;
 }
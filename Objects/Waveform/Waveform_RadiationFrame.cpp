@@ -152,16 +152,17 @@ std::vector<WaveformUtilities::Quaternion> MinimalRotation(const std::vector<dou
   // Find the minimal-rotation frame using the Euler-angle method
   vector<double> gammaDot = -dydx(alpha, t)*cos(beta);
   vector<double> gamma = -alpha*cos(beta) + cumtrapz(t, -sin(beta)*dydx(beta,t)*alpha);
-  vector<WaveformUtilities::Quaternion> MinRotFrame = WaveformUtilities::Quaternions(alpha, beta, gamma);
+  QuaternionSeries MinRotFrame(WaveformUtilities::Quaternions(alpha, beta, gamma)), Integrand;
 
   // Now use that frame with the quaternion method for better numerics
   const Quaternion z(0.,0.,0.,1.);
   for(unsigned int iteration=0; iteration<NIterations; ++iteration) {
+    // Integrand = conjugate(MinRotFrame) * CenteredDifferencing(MinRotFrame, t) * z, in place.
     // Note that Component0 gives -1 times the dot product of two vectors
-    const vector<double> negativegammaover2 = SplineIntegral(t, Component0( conjugate(MinRotFrame) * CenteredDifferencing(MinRotFrame, t) * z ));
-    for(unsigned int i=0; i<negativegammaover2.size(); ++i) {
-      MinRotFrame[i] = MinRotFrame[i] * (negativegammaover2[i]*z).exp();
-    }
+    Integrand = MinRotFrame;
+    Integrand.Conjugate().RightMultiply(CenteredDifferencing(MinRotFrame, t)).RightMultiply(z);
+    const vector<double> negativegammaover2 = SplineIntegral(t, Integrand.Component0());
+    MinRotFrame.RightMultiplyByExp(negativegammaover2, z);
     string FileName = "MinRotPhaseConvergence_" + DoubleToString(iteration+1) + "of" + DoubleToString(NIterations) + ".dat";
     ofstream File(FileName.c_str());
     File << "# [1] = t\n# [2] = gamma\n";
@@ -202,7 +203,7 @@ std::vector<WaveformUtilities::Quaternion> MinimalRotation(const std::vector<dou
   //   MinRotFrame[i] = MinRotFrame[i] * (gamma[i]*z).exp();
   // }
 
-  return MinRotFrame;
+  return MinRotFrame.Quaternions();
 }
 
 
@@ -13,6 +13,7 @@
 #include "SWSHs.hpp"
 #include "EasyParser.hpp"
 #include "VectorFunctions.hpp"
+#include "VectorMath.hpp"
 #include "Utilities.hpp"
 #include "Units.hpp"
 #include "PostNewtonian.hpp"
@@ -73,14 +74,19 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const double alpha, co
           DIm[mp+l][m+l] = mag*sin(arg);
         }
       }
+      // Convert the data for all m' modes to (Re,Im), a mode at a time
+      vector<vector<double> > ReModes(2*l+1), ImModes(2*l+1);
+      for(int mp=-l, i=0; mp<=l; ++mp, ++i) {
+        PolarToCartesian(Mag(ModeIndices[i]), Arg(ModeIndices[i]), ReModes[mp+l], ImModes[mp+l]);
+      }
       // Loop through each time step
       for(unsigned int t=0; t<NTimes(); ++t) {
         vector<double> ReData(2*l+1);
         vector<double> ImData(2*l+1);
-        for(int mp=-l, i=0; mp<=l; ++mp, ++i) {
+        for(int mp=-l; mp<=l; ++mp) {
           // Save the data at this time step
-          ReData[mp+l] = Mag(ModeIndices[i], t)*cos(Arg(ModeIndices[i], t));
-          ImData[mp+l] = Mag(ModeIndices[i], t)*sin(Arg(ModeIndices[i], t));
+          ReData[mp+l] = ReModes[mp+l][t];
+          ImData[mp+l] = ImModes[mp+l][t];
         }
         for(int m=-l, i=0; m<=l; ++m, ++i) {
           MagRef(ModeIndices[i], t) = 0.0;
@@ -102,9 +108,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const double alpha, co
     }
     // Convert back to MagArg form
     for(unsigned int mode=0; mode<NModes(); ++mode) {
-      vector<double> Re = Mag(mode);
-      vector<double> Im = Arg(mode);
-      MagArg(Re, Im, MagRef(mode), ArgRef(mode));
+      MagArg(Mag(mode), Arg(mode), MagRef(mode), ArgRef(mode));
     }
   }
 
@@ -171,6 +175,11 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<doub
       // Construct the D matrices
       Matrix<double> DRe(2*l+1, 2*l+1);
       Matrix<double> DIm(2*l+1, 2*l+1);
+      // Convert the data for all m' modes to (Re,Im), a mode at a time
+      vector<vector<double> > ReModes(2*l+1), ImModes(2*l+1);
+      for(int mp=-l; mp<=l; ++mp) {
+        PolarToCartesian(Mag((l*l-4)+(mp+l)), Arg((l*l-4)+(mp+l)), ReModes[mp+l], ImModes[mp+l]);
+      }
       // Loop through each time step
       for(unsigned int t=0; t<NTimes(); ++t) {
         for(int m=-l; m<=l; ++m) {
@@ -185,8 +194,8 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<doub
         vector<double> ImData(2*l+1);
         for(int mp=-l; mp<=l; ++mp) {
           // Save the data at this time step
-          ReData[mp+l] = Mag((l*l-4)+(mp+l), t)*cos(Arg((l*l-4)+(mp+l), t));
-          ImData[mp+l] = Mag((l*l-4)+(mp+l), t)*sin(Arg((l*l-4)+(mp+l), t));
+          ReData[mp+l] = ReModes[mp+l][t];
+          ImData[mp+l] = ImModes[mp+l][t];
         }
         for(int m=-l; m<=l; ++m) {
           MagRef((l*l-4)+(m+l), t) = 0.0;
@@ -208,9 +217,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<doub
     }
     // Convert back to MagArg form
     for(unsigned int mode=0; mode<NModes(); ++mode) {
-      vector<double> Re = Mag(mode);
-      vector<double> Im = Arg(mode);
-      MagArg(Re, Im, MagRef(mode), ArgRef(mode));
+      MagArg(Mag(mode), Arg(mode), MagRef(mode), ArgRef(mode));
     }
   }
 
@@ -275,6 +282,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<Wave
       }
       Matrix<double> DMag(2*l+1, 2*l+1);
       Matrix<double> DArg(2*l+1, 2*l+1);
+      vector<double> TermMag((2*l+1)*(2*l+1)), TermArg((2*l+1)*(2*l+1)), TermRe, TermIm;
       // Loop through each time step
       for(unsigned int t=0; t<NTimes(); ++t) {
         // Get the Wigner D matrix data at this time step
@@ -291,21 +299,22 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<Wave
           MagData[mp+l] = Mag(ModeIndices[i], t);
           ArgData[mp+l] = Arg(ModeIndices[i], t);
         }
-        for(int m=-l, i=0; m<=l; ++m, ++i) {
+        // Compute the additions to the data at this time step, and
+        // convert them to (Re,Im) together
+        for(int m=-l, k=0; m<=l; ++m) {
+          for(int mp=-l; mp<=l; ++mp, ++k) {
+            TermMag[k] = DMag[mp+l][m+l]*MagData[mp+l];
+            TermArg[k] = DArg[mp+l][m+l]+ArgData[mp+l];
+          }
+        }
+        PolarToCartesian(TermMag, TermArg, TermRe, TermIm);
+        for(int m=-l, i=0, k=0; m<=l; ++m, ++i) {
           MagRef(ModeIndices[i], t) = 0.0;
           ArgRef(ModeIndices[i], t) = 0.0;
-          for(int mp=-l; mp<=l; ++mp) {
-            // Compute the addition to the data at this time step
-            const double Mag = DMag[mp+l][m+l]*MagData[mp+l];
-            const double Arg = DArg[mp+l][m+l]+ArgData[mp+l];
+          for(int mp=-l; mp<=l; ++mp, ++k) {
             // NB: Mag and Arg are temporarily storing Re and Im data!
-            // if((m+mp)%2==0) { // (-1)^{m+mp}
-              MagRef(ModeIndices[i], t) += Mag*cos(Arg);
-              ArgRef(ModeIndices[i], t) += Mag*sin(Arg);
-            // } else {
-            //   MagRef(ModeIndices[i], t) -= Mag*cos(Arg);
-            //   ArgRef(ModeIndices[i], t) -= Mag*sin(Arg);
-            // }
+            MagRef(ModeIndices[i], t) += TermRe[k];
+            ArgRef(ModeIndices[i], t) += TermIm[k];
           }
         }
       }
@@ -313,9 +322,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const std::vector<Wave
     }
     // Convert back to MagArg form
     for(unsigned int mode=0; mode<NModes(); ++mode) {
-      vector<double> Re = Mag(mode);
-      vector<double> Im = Arg(mode);
-      MagArg(Re, Im, MagRef(mode), ArgRef(mode));
+      MagArg(Mag(mode), Arg(mode), MagRef(mode), ArgRef(mode));
     }
   }
 
@@ -364,6 +371,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const WaveformUtilitie
       Matrix<WignerDMatrix_Q> Ds(2*l+1, 2*l+1);
       Matrix<double> DMag(2*l+1, 2*l+1);
       Matrix<double> DArg(2*l+1, 2*l+1);
+      vector<double> TermMag((2*l+1)*(2*l+1)), TermArg((2*l+1)*(2*l+1)), TermRe, TermIm;
       for(int m=-l; m<=l; ++m) {
         for(int mp=-l; mp<=l; ++mp) {
           Ds[mp+l][m+l].SetElement(l, mp, m);
@@ -380,21 +388,22 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const WaveformUtilitie
           MagData[mp+l] = Mag(ModeIndices[i], t);
           ArgData[mp+l] = Arg(ModeIndices[i], t);
         }
-        for(int m=-l, i=0; m<=l; ++m, ++i) {
+        // Compute the additions to the data at this time step, and
+        // convert them to (Re,Im) together
+        for(int m=-l, k=0; m<=l; ++m) {
+          for(int mp=-l; mp<=l; ++mp, ++k) {
+            TermMag[k] = DMag[mp+l][m+l]*MagData[mp+l];
+            TermArg[k] = DArg[mp+l][m+l]+ArgData[mp+l];
+          }
+        }
+        PolarToCartesian(TermMag, TermArg, TermRe, TermIm);
+        for(int m=-l, i=0, k=0; m<=l; ++m, ++i) {
           MagRef(ModeIndices[i], t) = 0.0;
           ArgRef(ModeIndices[i], t) = 0.0;
-          for(int mp=-l; mp<=l; ++mp) {
-            // Compute the addition to the data at this time step
-            const double Mag = DMag[mp+l][m+l]*MagData[mp+l];
-            const double Arg = DArg[mp+l][m+l]+ArgData[mp+l];
+          for(int mp=-l; mp<=l; ++mp, ++k) {
             // NB: Mag and Arg are temporarily storing Re and Im data!
-            // if((m+mp)%2==0) { // (-1)^{m+mp}
-              MagRef(ModeIndices[i], t) += Mag*cos(Arg);
-              ArgRef(ModeIndices[i], t) += Mag*sin(Arg);
-            // } else {
-            //   MagRef(ModeIndices[i], t) -= Mag*cos(Arg);
-            //   ArgRef(ModeIndices[i], t) -= Mag*sin(Arg);
-            // }
+            MagRef(ModeIndices[i], t) += TermRe[k];
+            ArgRef(ModeIndices[i], t) += TermIm[k];
           }
         }
       }
@@ -402,9 +411,7 @@ Waveform& WaveformObjects::Waveform::RotatePhysicalSystem(const WaveformUtilitie
     }
     // Convert back to MagArg form
     for(unsigned int mode=0; mode<NModes(); ++mode) {
-      vector<double> Re = Mag(mode);
-      vector<double> Im = Arg(mode);
-      MagArg(Re, Im, MagRef(mode), ArgRef(mode));
+      MagArg(Mag(mode), Arg(mode), MagRef(mode), ArgRef(mode));
     }
   }
 
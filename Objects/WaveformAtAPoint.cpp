@@ -3,6 +3,7 @@
 #include "WaveformAtAPoint.hpp"
 
 #include "VectorFunctions.hpp"
+#include "VectorMath.hpp"
 #include "Interpolate.hpp"
 #include "SWSHs.hpp"
 #include "Utilities.hpp"
@@ -42,17 +43,21 @@ WaveformAtAPoint::WaveformAtAPoint(const Waveform& W, const double dt, const dou
   ArgRef() = Matrix<double>(1, N2, 0.0);
 
   // Step through the modes interpolating to the new time
-  vector<double> SWSHAmp, SWSHPhi, Amplitude, Phase;
+  vector<double> SWSHAmp, SWSHPhi, Amplitude, Phase, SinPhase, CosPhase;
   SWSH(W.LM().RawData(), vartheta, varphi, SWSHAmp, SWSHPhi);
+  WaveformUtilities::MultiSplineInterpolator Spline(W.T(), NewTime);
   for(unsigned int mode=0; mode<W.NModes(); ++mode) { // Loop over components
-    Amplitude = SWSHAmp[mode] * WaveformUtilities::Interpolate(W.T(), W.Mag(mode), NewTime, 0.0);
-    Phase     = SWSHPhi[mode] + WaveformUtilities::Interpolate(W.T(), W.Arg(mode), NewTime, W.Arg(mode).back());
-    ReRef() += Amplitude * cos(Phase);
-    ImRef() += Amplitude * sin(Phase);
+    Spline(W.Mag(mode), Amplitude, 0.0);
+    Spline(W.Arg(mode), Phase, W.Arg(mode).back());
+    Amplitude *= SWSHAmp[mode];
+    Phase += SWSHPhi[mode];
+    SinCos(Phase, SinPhase, CosPhase);
+    ReRef() += Amplitude * CosPhase;
+    ImRef() += Amplitude * SinPhase;
   }
   TRef() = NewTime;
   if(W.R().size()==W.T().size()) {
-    RRef() = WaveformUtilities::Interpolate(W.T(), W.R(), T());
+    RRef() = Spline(W.R());
   } else {
     RRef() = W.R();
   }
@@ -298,15 +298,25 @@ WaveformObjects::Waveforms::Waveforms(const std::vector<std::string>& BBHDataSec
 
 void WaveformObjects::Waveforms::SetCommonTime(const double& MinStep, const double& MinTime) {
   history << "### this->SetCommonTime(" << MinStep << ", " << MinTime << ");" << endl;
-  std::vector<double> Time(Ws[0].T());
-  // Get the intersection of all the time data
-  for(unsigned int i=1; i<Ws.size(); ++i) {
-    Time = Intersection(Time, Ws[i].T(), MinStep, MinTime);
+  // Get the intersection of all the time data in one pass
+  vector<vector<double> > Times(Ws.size());
+  for(unsigned int i=0; i<Ws.size(); ++i) {
+    Times[i] = Ws[i].T();
   }
-  // Interpolate each Waveform to the common time series
+  const vector<double> Time = Intersection(Times, MinStep, MinTime);
+  // Interpolate each Waveform to the common time series, sharing the
+  // spline setup between consecutive Waveforms with the same times
+  vector<double> LastTime;
+  MultiSplineInterpolator* Spline = 0;
   for(unsigned int i=0; i<Ws.size(); ++i) {
-    Ws[i].Interpolate(Time);
+    if(!Spline || Ws[i].T()!=LastTime) {
+      delete Spline;
+      LastTime = Ws[i].T();
+      Spline = new MultiSplineInterpolator(LastTime, Time);
+    }
+    Ws[i].Interpolate(Time, *Spline);
   }
+  delete Spline;
   CommonTimeSet = true;
   return;
 }
@@ -0,0 +1,75 @@
+#include "EOBInitialDataCache.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "Utilities.hpp"
+
+namespace WU = WaveformUtilities;
+using WU::EOBInitialDataCache;
+
+
+/// Look for initial data stored at exactly these parameters.
+bool EOBInitialDataCache::Find(const double delta, const double chis, const double chia, const double v0,
+                               double& prstar, double& pPhi) const {
+  for(unsigned int i=0; i<Entries.size(); ++i) {
+    const Entry& e = Entries[i];
+    if(e.delta==delta && e.chis==chis && e.chia==chia && e.v0==v0) {
+      prstar = e.prstar;
+      pPhi = e.pPhi;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Store reduced initial data; existing data for these parameters are
+/// replaced.
+void EOBInitialDataCache::Insert(const double delta, const double chis, const double chia, const double v0,
+                                 const double prstar, const double pPhi) {
+  Entry e;
+  e.delta = delta;
+  e.chis = chis;
+  e.chia = chia;
+  e.v0 = v0;
+  e.prstar = prstar;
+  e.pPhi = pPhi;
+  for(unsigned int i=0; i<Entries.size(); ++i) {
+    const Entry& f = Entries[i];
+    if(f.delta==delta && f.chis==chis && f.chia==chia && f.v0==v0) {
+      Entries[i] = e;
+      return;
+    }
+  }
+  Entries.push_back(e);
+}
+
+/// Add the entries stored in a file written by Write.
+bool EOBInitialDataCache::Read(const std::string& FileName) {
+  std::ifstream ifs(FileName.c_str());
+  if(!ifs) { return false; }
+  std::string Line;
+  while(std::getline(ifs, Line)) {
+    if(Line.empty() || Line[0]=='#') { continue; }
+    std::istringstream iss(Line);
+    Entry e;
+    if(iss >> e.delta >> e.chis >> e.chia >> e.v0 >> e.prstar >> e.pPhi) {
+      Insert(e.delta, e.chis, e.chia, e.v0, e.prstar, e.pPhi);
+    }
+  }
+  return true;
+}
+
+/// Write all entries to a text file, one per line, to full precision.
+void EOBInitialDataCache::Write(const std::string& FileName) const {
+  std::ofstream ofs(FileName.c_str());
+  if(!ofs) { Throw1WithMessage("Couldn't open '" + FileName + "' for writing."); }
+  ofs << "# delta chis chia v0 prstar pPhi" << std::endl;
+  ofs << std::setprecision(17);
+  for(unsigned int i=0; i<Entries.size(); ++i) {
+    const Entry& e = Entries[i];
+    ofs << e.delta << " " << e.chis << " " << e.chia << " " << e.v0 << " "
+        << e.prstar << " " << e.pPhi << std::endl;
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef EOBINITIALDATACACHE_HPP
+#define EOBINITIALDATACACHE_HPP
+
+#include <vector>
+#include <string>
+
+namespace WaveformUtilities {
+
+  /// This class remembers EOB initial data whose eccentricity has
+  /// already been reduced, keyed by the physical parameters (delta,
+  /// chis, chia, v0).  An exact match can be used directly, skipping
+  /// eccentricity reduction entirely.  (Data at nearby parameters are
+  /// not used: starting Newton's method from the post-circular data is
+  /// already as fast as starting from a correction carried over.)
+  ///
+  /// The cache is owned by the caller (for example, by a loop over
+  /// parameters), and is not itself thread-safe; each thread should
+  /// use its own cache.  It may be saved to and restored from a plain
+  /// text file.
+  class EOBInitialDataCache {
+  private:
+    struct Entry {
+      double delta, chis, chia, v0;
+      double prstar, pPhi;
+    };
+    std::vector<Entry> Entries;
+
+  public:
+    EOBInitialDataCache() { }
+    ~EOBInitialDataCache() { }
+
+    inline unsigned int size() const { return Entries.size(); }
+    void Clear() { Entries.clear(); }
+
+    bool Find(const double delta, const double chis, const double chia, const double v0,
+              double& prstar, double& pPhi) const;
+    void Insert(const double delta, const double chis, const double chia, const double v0,
+                const double prstar, const double pPhi);
+
+    bool Read(const std::string& FileName);
+    void Write(const std::string& FileName) const;
+  };
+
+} // namespace WaveformUtilities
+
+#endif // EOBINITIALDATACACHE_HPP
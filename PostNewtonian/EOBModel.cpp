@@ -149,19 +149,44 @@ WaveformUtilities::EOBMetricWithSpin::EOBMetricWithSpin(const EOBParameters& P)
 { }
 
 
+/// Evaluate the metric functions at r without touching the object's
+/// own (mutable) data.
+void WaveformUtilities::EOBMetricWithSpin::Evaluate(const double r, EOBMetricValues& m) const {
+  const double rinv = 1.0/r;
+  const double r2 = r*r;
+  const double r3 = r2*r;
+  const double r5 = r3*r2;
+  const double DtNumPoly = DtNum0 + r*(DtNum1);
+  const double DtNum = r5*r*DtNumPoly;
+  const double DtDen = DtDen0 + r*(DtDen1 + r*(DtDen2 + r*(DtDen3 + r*(DtDen4 + r*(DtDen5) ) ) ) );
+  const double DtDenInv = 1.0/DtDen;
+  const double Dinv = Dinv0 + (Dinv2 + (Dinv3 + Dinv4*rinv)*rinv)*rinv*rinv;
+  m.r = r;
+  m.rinv = rinv;
+  m.r2 = r2;
+  m.Dt = DtNum * DtDenInv;
+  m.Dr = m.Dt * Dinv;
+  m.dDtdr = ((r5*(6*DtNum0 + 7*r*(DtNum1)))*DtDen - DtNum*(DtDen1 + r*(2*DtDen2 + r*(3*DtDen3 + r*(4*DtDen4 + r*(5*DtDen5)))))) * (DtDenInv*DtDenInv);
+  m.dDrdr = m.dDtdr*Dinv + (r3*DtNumPoly*DtDenInv)*(-2*Dinv2 + (-3*Dinv3-4*Dinv4*rinv)*rinv);
+  const double r2PlusChiKerr2Inv = 1.0/(r2 + chiKerr*chiKerr);
+  m.drdrstar = sqrt(m.Dt*m.Dr) * r2PlusChiKerr2Inv;  // Eq. (28) of PRD 81, 084041 [Pan et al., 2010]
+  m.drstardr = 1.0 / m.drdrstar;
+  m.ddrstardrdr = (2*r*r2PlusChiKerr2Inv - 0.5*m.dDrdr/m.Dr - 0.5*m.dDtdr/m.Dr) * m.drstardr;
+  return;
+}
+
 void WaveformUtilities::EOBMetricWithSpin::operator()(const double r_new) const {
   if(r==r_new) { return; }
   r = r_new;
-  const double DtNum = pow(r,6)*(DtNum0 + r*(DtNum1));
-  const double DtDen = DtDen0 + r*(DtDen1 + r*(DtDen2 + r*(DtDen3 + r*(DtDen4 + r*(DtDen5) ) ) ) );
-  const double Dinv = Dinv0 + (Dinv2 + (Dinv3 + Dinv4/r)/r)/(r*r);
-  Dt = DtNum / DtDen;
-  Dr = Dt * Dinv;
-  dDtdr = ((pow(r,5)*(6*DtNum0 + 7*r*(DtNum1)))*DtDen - DtNum*(DtDen1 + r*(2*DtDen2 + r*(3*DtDen3 + r*(4*DtDen4 + r*(5*DtDen5)))))) / (DtDen*DtDen);
-  dDrdr = dDtdr*Dinv + (pow(r,3)*(DtNum0+r*(DtNum1))/DtDen)*(-2*Dinv2 + (-3*Dinv3-4*Dinv4/r)/r);
-  drdrstar = sqrt(Dt*Dr) / (r*r + chiKerr*chiKerr);  // Eq. (28) of PRD 81, 084041 [Pan et al., 2010]
-  drstardr = 1.0 / drdrstar;
-  ddrstardrdr = (2*r/(r*r+chiKerr*chiKerr) - 0.5*dDrdr/Dr - 0.5*dDtdr/Dr) * drstardr;
+  EOBMetricValues m;
+  Evaluate(r, m);
+  Dt = m.Dt;
+  Dr = m.Dr;
+  dDtdr = m.dDtdr;
+  dDrdr = m.dDrdr;
+  drdrstar = m.drdrstar;
+  drstardr = m.drstardr;
+  ddrstardrdr = m.ddrstardrdr;
   return;
 }
 
@@ -180,12 +205,29 @@ WaveformUtilities::EOBHamiltonianWithSpin::EOBHamiltonianWithSpin(const EOBParam
     Heff(0.0), H(0.0), dHdr(0.0), dHdPhi(0.0), dHdprstar(0.0), dHdpPhi(0.0), v(0.0)
 { }
 
-void WaveformUtilities::EOBHamiltonianWithSpin::operator()(const double r_new, const double prstar_new, const double pPhi_new) const {
-  g(r_new);
-  if(r==r_new && prstar==prstar_new && pPhi==pPhi_new) { return; }
-  r = r_new;
-  prstar = prstar_new;
-  pPhi = pPhi_new;
+/// Evaluate the Hamiltonian and its derivatives at (m.r, prstar,
+/// pPhi) without touching the object's own (mutable) data.  Every
+/// power of the phase-space variables is computed once here.
+void WaveformUtilities::EOBHamiltonianWithSpin::Evaluate(const double prstar, const double pPhi, const EOBMetricValues& m, EOBHamiltonianValues& h) const {
+  const double r = m.r;
+  const double r2 = m.r2;
+  const double r3 = r2*r;
+  const double r4 = r2*r2;
+  const double rinv = m.rinv;
+  const double rinv2 = rinv*rinv;
+  const double rinv4 = rinv2*rinv2;
+  const double chiKerr2 = chiKerr*chiKerr;
+  const double chiKerr4 = chiKerr2*chiKerr2;
+  const double prstar2 = prstar*prstar;
+  const double prstar4 = prstar2*prstar2;
+  const double pPhi2 = pPhi*pPhi;
+  const double q = m.drstardr;
+  const double q2 = q*q;
+  const double q3 = q2*q;
+  const double q4 = q2*q2;
+  const double nuTerm = (4 - 3*nu)*nu;
+  const double S = chiKerr2 + r2;
+  const double S2 = S*S;
 
   /// For k=0
 //   const double lambda = -(pow(chiKerr,2)*g.Dt) + pow(pow(chiKerr,2) + pow(r,2),2);
@@ -209,38 +251,81 @@ void WaveformUtilities::EOBHamiltonianWithSpin::operator()(const double r_new, c
 
 
   /// For k=1
-  const double lambda = -(pow(chiKerr,2)*g.Dt) + pow(pow(chiKerr,2) + pow(r,2),2);
-  const double dlambdadr = -(pow(chiKerr,2)*g.dDtdr) + 4*r*(pow(chiKerr,2) + pow(r,2));
-  const double kappa = pow(chiKerr,2) - g.Dt + pow(r,2);
-  const double dkappadr = -g.dDtdr + 2*r;
-
-  const double sigma = sigmaconst + (pow(pPhi,2)*sigmapPhi)/pow(r,2) + sigmarinv/r + pow(prstar,2)*(sigmapr + (g.Dr*sigmaprDr)/pow(r,2))*pow(g.drstardr,2);
-  const double dsigmadr = (-2*pow(pPhi,2)*sigmapPhi)/pow(r,3) + pow(g.drstardr,2)*pow(prstar,2)*((-2*g.Dr*sigmaprDr)/pow(r,3) + (g.dDrdr*sigmaprDr)/pow(r,2)) + 2*g.ddrstardrdr*g.drstardr*pow(prstar,2)*(sigmapr + (g.Dr*sigmaprDr)/pow(r,2)) - sigmarinv/pow(r,2);
-  const double dsigmadprstar = 2*pow(g.drstardr,2)*prstar*(sigmapr + (g.Dr*sigmaprDr)/pow(r,2));
-  const double dsigmadpPhi = (2*pPhi*sigmapPhi)/pow(r,2);
-
-  const double HeffRadicand = (pow(prstar,2)*pow(pow(chiKerr,2) + pow(r,2),2) + (g.Dt*(2*pow(g.drstardr,4)*lambda*(4 - 3*nu)*nu*pow(prstar,4) + lambda*pow(r,2) + pow(pPhi,2)*pow(r,4)))/lambda)/lambda;
-
-  const double dHeffRadicanddr = (-(pow(chiKerr,4)*dlambdadr*lambda*pow(prstar,2)) - 2*pow(g.drstardr,3)*lambda*(-(dlambdadr*g.drstardr*g.Dt) + g.dDtdr*g.drstardr*lambda + 4*g.ddrstardrdr*g.Dt*lambda)*nu*(-4 + 3*nu)*pow(prstar,4) + 2*pow(lambda,2)*(g.Dt + 2*pow(chiKerr,2)*pow(prstar,2))*r + lambda*(g.dDtdr*lambda - dlambdadr*(g.Dt + 2*pow(chiKerr,2)*pow(prstar,2)))*pow(r,2) + 4*lambda*(g.Dt*pow(pPhi,2) + lambda*pow(prstar,2))*pow(r,3) + ((-2*dlambdadr*g.Dt + g.dDtdr*lambda)*pow(pPhi,2) - dlambdadr*lambda*pow(prstar,2))*pow(r,4))/pow(lambda,3);
-  const double dHeffRadicanddprstar = (2*prstar*(2*pow(g.drstardr,4)*g.Dt*(8 - 6*nu)*nu*pow(prstar,2) + pow(pow(chiKerr,2) + pow(r,2),2)))/lambda;
-  const double dHeffRadicanddpPhi = (2*g.Dt*pPhi*pow(r,4))/pow(lambda,2);
-
-  const double dHeffdr = dHeffRadicanddr/(2.*sqrt(HeffRadicand)) - (4*aSSterm)/pow(r,5) + (dsigmadr*kappa*lambda*pPhi + (-(dlambdadr*kappa) + dkappadr*lambda)*pPhi*(chiKerr + sigma))/pow(lambda,2);
-  const double dHeffdprstar = dHeffRadicanddprstar/(2.*sqrt(HeffRadicand)) + (dsigmadprstar*kappa*pPhi)/lambda;
-  const double dHeffdpPhi = dHeffRadicanddpPhi/(2.*sqrt(HeffRadicand)) + (kappa*(chiKerr + dsigmadpPhi*pPhi + sigma))/lambda;
-
-  Heff = sqrt(HeffRadicand)
-    + pPhi*kappa*(chiKerr+sigma)/lambda
-    + aSSterm/fourth(r);
-  H = sqrt(1 + 2*nu*(Heff-1)); /// This is a temporary value; see below
-  dHdr = dHeffdr / H;
-  ///dHdPhi = 0.0;
-  dHdprstar = dHeffdprstar / H;
-  dHdpPhi = dHeffdpPhi / H;
+  const double lambda = -(chiKerr2*m.Dt) + S2;
+  const double lambdainv = 1.0/lambda;
+  const double lambdainv2 = lambdainv*lambdainv;
+  const double dlambdadr = -(chiKerr2*m.dDtdr) + 4*r*S;
+  const double kappa = chiKerr2 - m.Dt + r2;
+  const double dkappadr = -m.dDtdr + 2*r;
+
+  const double sigmaprstar = sigmapr + (m.Dr*sigmaprDr)*rinv2;
+  const double sigma = sigmaconst + (pPhi2*sigmapPhi)*rinv2 + sigmarinv*rinv + prstar2*sigmaprstar*q2;
+  const double dsigmadr = (-2*pPhi2*sigmapPhi)*rinv2*rinv + q2*prstar2*((-2*m.Dr*sigmaprDr)*rinv2*rinv + (m.dDrdr*sigmaprDr)*rinv2) + 2*m.ddrstardrdr*q*prstar2*sigmaprstar - sigmarinv*rinv2;
+  const double dsigmadprstar = 2*q2*prstar*sigmaprstar;
+  const double dsigmadpPhi = (2*pPhi*sigmapPhi)*rinv2;
+
+  const double HeffRadicand = (prstar2*S2 + (m.Dt*(2*q4*lambda*nuTerm*prstar4 + lambda*r2 + pPhi2*r4))*lambdainv)*lambdainv;
+
+  const double dHeffRadicanddr = (-(chiKerr4*dlambdadr*lambda*prstar2) + 2*q3*lambda*(-(dlambdadr*q*m.Dt) + m.dDtdr*q*lambda + 4*m.ddrstardrdr*m.Dt*lambda)*nuTerm*prstar4 + 2*lambda*lambda*(m.Dt + 2*chiKerr2*prstar2)*r + lambda*(m.dDtdr*lambda - dlambdadr*(m.Dt + 2*chiKerr2*prstar2))*r2 + 4*lambda*(m.Dt*pPhi2 + lambda*prstar2)*r3 + ((-2*dlambdadr*m.Dt + m.dDtdr*lambda)*pPhi2 - dlambdadr*lambda*prstar2)*r4)*lambdainv2*lambdainv;
+  const double dHeffRadicanddprstar = (2*prstar*(4*q4*m.Dt*nuTerm*prstar2 + S2))*lambdainv;
+  const double dHeffRadicanddpPhi = (2*m.Dt*pPhi*r4)*lambdainv2;
+
+  const double sqrtHeffRadicand = sqrt(HeffRadicand);
+  const double halfInvSqrtHeffRadicand = 0.5/sqrtHeffRadicand;
+  const double dHeffdr = dHeffRadicanddr*halfInvSqrtHeffRadicand - (4*aSSterm)*rinv4*rinv + (dsigmadr*kappa*lambda*pPhi + (-(dlambdadr*kappa) + dkappadr*lambda)*pPhi*(chiKerr + sigma))*lambdainv2;
+  const double dHeffdprstar = dHeffRadicanddprstar*halfInvSqrtHeffRadicand + (dsigmadprstar*kappa*pPhi)*lambdainv;
+  const double dHeffdpPhi = dHeffRadicanddpPhi*halfInvSqrtHeffRadicand + (kappa*(chiKerr + dsigmadpPhi*pPhi + sigma))*lambdainv;
+
+  h.Heff = sqrtHeffRadicand
+    + pPhi*kappa*(chiKerr+sigma)*lambdainv
+    + aSSterm*rinv4;
+  const double Hreal = sqrt(1 + 2*nu*(h.Heff-1));
+  const double Hrealinv = 1.0/Hreal;
+  h.dHdr = dHeffdr * Hrealinv;
+  h.dHdprstar = dHeffdprstar * Hrealinv;
+  h.dHdpPhi = dHeffdpPhi * Hrealinv;
+  h.H = (Hreal-1.0)/nu;
+  h.v = (h.dHdpPhi>0 ? pow(h.dHdpPhi, 1./3.) : -pow(-h.dHdpPhi, 1./3.));
 
-  H = (H-1.0)/nu;
+  return;
+}
+
+/// As above, evaluating the metric at r into local storage first
+void WaveformUtilities::EOBHamiltonianWithSpin::Evaluate(const double r, const double prstar, const double pPhi, EOBHamiltonianValues& h) const {
+  EOBMetricValues m;
+  g.Evaluate(r, m);
+  Evaluate(prstar, pPhi, m, h);
+  return;
+}
+
+void WaveformUtilities::EOBHamiltonianWithSpin::operator()(const double r_new, const double prstar_new, const double pPhi_new) const {
+  g(r_new);
+  if(r==r_new && prstar==prstar_new && pPhi==pPhi_new) { return; }
+  r = r_new;
+  prstar = prstar_new;
+  pPhi = pPhi_new;
 
-  v = (dHdpPhi>0 ? pow(dHdpPhi, 1./3.) : -pow(-dHdpPhi, 1./3.));
+  /// The metric was just evaluated by g(r_new) above
+  EOBMetricValues m;
+  m.r = r;
+  m.rinv = 1.0/r;
+  m.r2 = r*r;
+  m.Dt = g.Dt;
+  m.Dr = g.Dr;
+  m.dDtdr = g.dDtdr;
+  m.dDrdr = g.dDrdr;
+  m.drdrstar = g.drdrstar;
+  m.drstardr = g.drstardr;
+  m.ddrstardrdr = g.ddrstardrdr;
+  EOBHamiltonianValues h;
+  Evaluate(prstar, pPhi, m, h);
+  Heff = h.Heff;
+  H = h.H;
+  dHdr = h.dHdr;
+  ///dHdPhi = 0.0;
+  dHdprstar = h.dHdprstar;
+  dHdpPhi = h.dHdpPhi;
+  v = h.v;
 
   return;
 }
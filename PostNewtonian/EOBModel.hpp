@@ -55,6 +55,21 @@ namespace WaveformUtilities {
 
 
 
+  /// The metric functions at a single radius, together with the powers
+  /// of r shared with the Hamiltonian.  These are filled by
+  /// EOBMetricWithSpin::Evaluate, which does not modify the metric
+  /// object, so that a single metric may be used by several threads.
+  struct EOBMetricValues {
+    double r, rinv, r2;
+    double Dt, Dr, dDtdr, dDrdr, drdrstar, drstardr, ddrstardrdr;
+  };
+
+  /// The Hamiltonian and its derivatives at a single point of phase
+  /// space, as filled by EOBHamiltonianWithSpin::Evaluate.
+  struct EOBHamiltonianValues {
+    double Heff, H, dHdr, dHdprstar, dHdpPhi, v;
+  };
+
   class EOBMetricWithSpin {
   private:
     const double chiKerr;
@@ -64,6 +79,7 @@ namespace WaveformUtilities {
   public:
     //EOBMetricWithSpin(const double delta, const double chis, const double chia);
     EOBMetricWithSpin(const EOBParameters& Par);
+    void Evaluate(const double r, EOBMetricValues& m) const;
     void operator()(const double r_new) const;
     mutable double Dt;
     mutable double Dr;
@@ -84,6 +100,8 @@ namespace WaveformUtilities {
   public:
     EOBHamiltonianWithSpin(const EOBParameters& Par, const EOBMetricWithSpin& ig);
     //EOBHamiltonianWithSpin(const double delta, const double chis, const double chia, const EOBMetricWithSpin& ig);
+    void Evaluate(const double prstar, const double pPhi, const EOBMetricValues& m, EOBHamiltonianValues& h) const;
+    void Evaluate(const double r, const double prstar, const double pPhi, EOBHamiltonianValues& h) const;
     void operator()(const double r_new, const double prstar_new, const double pPhi_new) const;
     mutable double Heff;
     mutable double H;
@@ -31,10 +31,29 @@ WaveformUtilities::Flux_Taylor::Flux_Taylor(const double delta, const double chi
     F7(0.0012986080744005427*(-78168. + nu*(300643. + 154708.*nu)))
 { }
 
+double WaveformUtilities::Flux_Taylor::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  return F0*tenth(v)*(1 + v*v*(F2 + v*(F3 + v*(F4 + v*(F5 + v*(F6 + log(v)*F6lnv + v*F7) ) ) ) ) );
+}
+
 double WaveformUtilities::Flux_Taylor::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new) { return Flux; }
   v = v_new;
-  return Flux = F0*tenth(v)*(1 + v*v*(F2 + v*(F3 + v*(F4 + v*(F5 + v*(F6 + log(v)*F6lnv + v*F7) ) ) ) ) );
+  return Flux = Evaluate(v);
+}
+
+/// The logarithms are taken in a separate pass, so that the
+/// polynomial loop contains no calls and can be vectorized.
+void WaveformUtilities::Flux_Taylor::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                              std::vector<double>& Fluxes) const {
+  const unsigned int NPoints = v.size();
+  Fluxes.resize(NPoints);
+  for(unsigned int i=0; i<NPoints; ++i) {
+    Fluxes[i] = log(v[i]);
+  }
+  for(unsigned int i=0; i<NPoints; ++i) {
+    const double x = v[i];
+    Fluxes[i] = F0*tenth(x)*(1 + x*x*(F2 + x*(F3 + x*(F4 + x*(F5 + x*(F6 + Fluxes[i]*F6lnv + x*F7) ) ) ) ) );
+  }
 }
 
 
@@ -52,11 +71,29 @@ WaveformUtilities::Flux_Taylor8::Flux_Taylor8(const double delta, const double c
     F8lnv(52.74308390022676)
 { }
 
+double WaveformUtilities::Flux_Taylor8::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  const double lnv = log(v);
+  return F0*tenth(v)*(1 + v*v*(F2 + v*(F3 + v*(F4 + v*(F5 + v*(F6 + lnv*F6lnv + v*(F7 + v*(F8 + lnv*F8lnv) ) ) ) ) ) ) );
+}
+
 double WaveformUtilities::Flux_Taylor8::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new) { return Flux; }
   v = v_new;
-  const double lnv = log(v);
-  return Flux = F0*tenth(v)*(1 + v*v*(F2 + v*(F3 + v*(F4 + v*(F5 + v*(F6 + lnv*F6lnv + v*(F7 + v*(F8 + lnv*F8lnv) ) ) ) ) ) ) );
+  return Flux = Evaluate(v);
+}
+
+void WaveformUtilities::Flux_Taylor8::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                               std::vector<double>& Fluxes) const {
+  const unsigned int NPoints = v.size();
+  Fluxes.resize(NPoints);
+  for(unsigned int i=0; i<NPoints; ++i) {
+    Fluxes[i] = log(v[i]);
+  }
+  for(unsigned int i=0; i<NPoints; ++i) {
+    const double x = v[i];
+    const double lnv = Fluxes[i];
+    Fluxes[i] = F0*tenth(x)*(1 + x*x*(F2 + x*(F3 + x*(F4 + x*(F5 + x*(F6 + lnv*F6lnv + x*(F7 + x*(F8 + lnv*F8lnv) ) ) ) ) ) ) );
+  }
 }
 
 
@@ -105,12 +142,31 @@ WaveformUtilities::Flux_Pade44LogConst::Flux_Pade44LogConst(const double delta,
     FDen4lnv3(-1.*f2*pow(f6lnv,3))
 { }
 
+double WaveformUtilities::Flux_Pade44LogConst::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  const double lnv = log(v);
+  return N * tenth(v) * (FNum0 + lnv*(FNum0lnv + lnv*FNum0lnv2) + v*(FNum1 + lnv*(FNum1lnv + lnv*FNum1lnv2) + v*(FNum2 + lnv*(FNum2lnv + lnv*FNum2lnv2) + v*(FNum3 + lnv*(FNum3lnv + lnv*FNum3lnv2) + v*(FNum4 + lnv*(FNum4lnv +lnv*(FNum4lnv2 + lnv*FNum4lnv3) ) ) ) ) ) )
+    / (FDen0 + lnv*(FDen0lnv + lnv*FDen0lnv2) + v*(FDen1 +lnv*(FDen1lnv +lnv*FDen1lnv2) + v*(FDen2 + lnv*(FDen2lnv + lnv*FDen2lnv2) + v*(FDen3 + lnv*(FDen3lnv + lnv*FDen3lnv2) + v*(FDen4 + lnv*(FDen4lnv + lnv*(FDen4lnv2 + lnv*FDen4lnv3) ) ) ) ) ) );
+}
+
 double WaveformUtilities::Flux_Pade44LogConst::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new) { return Flux; }
   v = v_new;
-  const double lnv = log(v);
-  return Flux = N * pow(v,10) * (FNum0 + lnv*(FNum0lnv + lnv*FNum0lnv2) + v*(FNum1 + lnv*(FNum1lnv + lnv*FNum1lnv2) + v*(FNum2 + lnv*(FNum2lnv + lnv*FNum2lnv2) + v*(FNum3 + lnv*(FNum3lnv + lnv*FNum3lnv2) + v*(FNum4 + lnv*(FNum4lnv +lnv*(FNum4lnv2 + lnv*FNum4lnv3) ) ) ) ) ) )
-    / (FDen0 + lnv*(FDen0lnv + lnv*FDen0lnv2) + v*(FDen1 +lnv*(FDen1lnv +lnv*FDen1lnv2) + v*(FDen2 + lnv*(FDen2lnv + lnv*FDen2lnv2) + v*(FDen3 + lnv*(FDen3lnv + lnv*FDen3lnv2) + v*(FDen4 + lnv*(FDen4lnv + lnv*(FDen4lnv2 + lnv*FDen4lnv3) ) ) ) ) ) );
+  return Flux = Evaluate(v);
+}
+
+void WaveformUtilities::Flux_Pade44LogConst::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                                      std::vector<double>& Fluxes) const {
+  const unsigned int NPoints = v.size();
+  Fluxes.resize(NPoints);
+  for(unsigned int i=0; i<NPoints; ++i) {
+    Fluxes[i] = log(v[i]);
+  }
+  for(unsigned int i=0; i<NPoints; ++i) {
+    const double x = v[i];
+    const double lnv = Fluxes[i];
+    Fluxes[i] = N * tenth(x) * (FNum0 + lnv*(FNum0lnv + lnv*FNum0lnv2) + x*(FNum1 + lnv*(FNum1lnv + lnv*FNum1lnv2) + x*(FNum2 + lnv*(FNum2lnv + lnv*FNum2lnv2) + x*(FNum3 + lnv*(FNum3lnv + lnv*FNum3lnv2) + x*(FNum4 + lnv*(FNum4lnv +lnv*(FNum4lnv2 + lnv*FNum4lnv3) ) ) ) ) ) )
+      / (FDen0 + lnv*(FDen0lnv + lnv*FDen0lnv2) + x*(FDen1 +lnv*(FDen1lnv +lnv*FDen1lnv2) + x*(FDen2 + lnv*(FDen2lnv + lnv*FDen2lnv2) + x*(FDen3 + lnv*(FDen3lnv + lnv*FDen3lnv2) + x*(FDen4 + lnv*(FDen4lnv + lnv*(FDen4lnv2 + lnv*FDen4lnv3) ) ) ) ) ) );
+  }
 }
 
 
@@ -141,12 +197,31 @@ WaveformUtilities::Flux_Pade44LogFac::Flux_Pade44LogFac(const double delta, cons
     FDen4(pow(f5,4) - 3.*f4*pow(f5,2)*f6 + pow(f4,2)*pow(f6,2) + 2.*pow(f4,2)*f5*f7 - 1.*pow(f4,3)*f8 + pow(f3,2)*(pow(f7,2) - 1.*f6*f8) + f2*(-1.*pow(f6,3) + 2.*f5*f6*f7 - 1.*f4*pow(f7,2) - 1.*pow(f5,2)*f8 + f4*f6*f8) + f3*(-2.*pow(f5,2)*f7 - 2.*f4*f6*f7 + 2.*f5*(pow(f6,2) + f4*f8)))
 { }
 
+double WaveformUtilities::Flux_Pade44LogFac::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  return N * tenth(v) * (vPole/(vPole-v)) * (1.0 + log(v/vLSO)*sixth(v)*(flogfac6 + v*v*flogfac8))
+    * (FNum0 + v*(FNum1 + v*(FNum2 + v*(FNum3 + v*(FNum4)))))
+    / (FDen0 + v*(FDen1 + v*(FDen2 + v*(FDen3 + v*(FDen4)))));
+}
+
 double WaveformUtilities::Flux_Pade44LogFac::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new) { return Flux; }
   v = v_new;
-  return Flux = N * pow(v,10) * (vPole/(vPole-v)) * (1.0 + log(v/vLSO)*pow(v,6)*(flogfac6 + v*v*flogfac8))
-    * (FNum0 + v*(FNum1 + v*(FNum2 + v*(FNum3 + v*(FNum4)))))
-    / (FDen0 + v*(FDen1 + v*(FDen2 + v*(FDen3 + v*(FDen4)))));
+  return Flux = Evaluate(v);
+}
+
+void WaveformUtilities::Flux_Pade44LogFac::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                                    std::vector<double>& Fluxes) const {
+  const unsigned int NPoints = v.size();
+  Fluxes.resize(NPoints);
+  for(unsigned int i=0; i<NPoints; ++i) {
+    Fluxes[i] = log(v[i]/vLSO);
+  }
+  for(unsigned int i=0; i<NPoints; ++i) {
+    const double x = v[i];
+    Fluxes[i] = N * tenth(x) * (vPole/(vPole-x)) * (1.0 + Fluxes[i]*sixth(x)*(flogfac6 + x*x*flogfac8))
+      * (FNum0 + x*(FNum1 + x*(FNum2 + x*(FNum3 + x*(FNum4)))))
+      / (FDen0 + x*(FDen1 + x*(FDen2 + x*(FDen3 + x*(FDen4)))));
+  }
 }
 
 
@@ -155,8 +230,20 @@ WaveformUtilities::Flux_SumAmplitudes::Flux_SumAmplitudes(const double delta, co
     N(1.0/(16.0*M_PI))
 { }
 
+double WaveformUtilities::Flux_SumAmplitudes::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  return N*WaveformUtilities::sixth(v)*SumMMagSquared(v);
+}
+
 double WaveformUtilities::Flux_SumAmplitudes::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new) { return Flux; }
   v = v_new;
-  return Flux = N*WaveformUtilities::sixth(v)*SumMMagSquared(v);
+  return Flux = Evaluate(v);
+}
+
+void WaveformUtilities::Flux_SumAmplitudes::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                                     std::vector<double>& Fluxes) const {
+  Fluxes.resize(v.size());
+  for(unsigned int i=0; i<v.size(); ++i) {
+    Fluxes[i] = Evaluate(v[i]);
+  }
 }
@@ -4,9 +4,16 @@
 #include "WaveformAmplitudes.hpp"
 #include "WaveformAmplitudesResummed.hpp"
 #include "VectorFunctions.hpp"
+#include "Utilities.hpp"
 
 namespace WaveformUtilities {
 
+  /// Each flux has an `Evaluate` member, which returns the flux
+  /// without touching any mutable data, and so may be called by
+  /// several threads at once; `operator()` caches its last value in
+  /// the `Flux` member.  The overload of `Evaluate` taking vectors
+  /// fills `Fluxes` with the flux at every point of a trajectory;
+  /// arguments on which a flux does not depend may be empty.
   class Flux_Base {
   protected:
     mutable double v;
@@ -29,6 +36,9 @@ namespace WaveformUtilities {
     const double nu, F0, F2, F3, F4, F5, F6, F6lnv, F7;
   public:
     Flux_Taylor(const double delta, const double chis, const double chia);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -38,6 +48,9 @@ namespace WaveformUtilities {
     const double nu, F0, F2, F3, F4, F5, F6, F6lnv, F7, F8, F8lnv;
   public:
     Flux_Taylor8(const double delta, const double chis, const double chia);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -50,6 +63,9 @@ namespace WaveformUtilities {
     const double FDen0, FDen0lnv, FDen0lnv2, FDen1, FDen1lnv, FDen1lnv2, FDen2, FDen2lnv, FDen2lnv2, FDen3, FDen3lnv, FDen3lnv2, FDen4, FDen4lnv, FDen4lnv2, FDen4lnv3;
   public:
     Flux_Pade44LogConst(const double delta, const double chis, const double chia);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -63,6 +79,9 @@ namespace WaveformUtilities {
     const double FDen0, FDen1, FDen2, FDen3, FDen4;
   public:
     Flux_Pade44LogFac(const double delta, const double chis, const double chia);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -72,6 +91,9 @@ namespace WaveformUtilities {
     const double N;
   public:
     Flux_SumAmplitudes(const double delta, const double chis, const double chia);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -83,6 +105,9 @@ namespace WaveformUtilities {
     const double N;
   public:
     Flux_SumAmplitudesResummed(const double delta, const double chis, const double chia, const Metric& ig, const Hamiltonian& iH);
+    double Evaluate(const double v, const double r, const double prstar, const double pPhi) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Fluxes) const;
     double operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const;
   };
 
@@ -98,6 +123,9 @@ namespace WaveformUtilities {
     mutable double Torque;
     Torque_KFPhi(const double delta, const double chis, const double chia, const Flux& iF);
     template <class H> Torque_KFPhi(const double delta, const double chis, const double chia, const Flux& iF, const H& Ham);
+    double Evaluate(const double v, const double r=0.0, const double prstar=0.0, const double pPhi=0.0) const;
+    void Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                  std::vector<double>& Torques) const;
     double operator()(const double v_new, const double r_new=0.0, const double prstar_new=0.0, const double pPhi_new=0.0) const;
   };
 
@@ -4,6 +4,11 @@ Flux_SumAmplitudesResummed<Metric, Hamiltonian>::Flux_SumAmplitudesResummed(cons
     N(1.0/(16.0*M_PI))
 { }
 
+template <class Metric, class Hamiltonian>
+double Flux_SumAmplitudesResummed<Metric, Hamiltonian>::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  return N*WaveformUtilities::sixth(v)*WaveformUtilities::WaveformAmplitudesResummedSumMMagSquared<Metric, Hamiltonian>::SumMMagSquared(v, r, prstar, pPhi);
+}
+
 template <class Metric, class Hamiltonian>
 double Flux_SumAmplitudesResummed<Metric, Hamiltonian>::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new && r==r_new && prstar==prstar_new && pPhi==pPhi_new) { return Flux; }
@@ -11,7 +16,19 @@ double Flux_SumAmplitudesResummed<Metric, Hamiltonian>::operator()(const double
   r = r_new;
   prstar = prstar_new;
   pPhi = pPhi_new;
-  return Flux = N*WaveformUtilities::sixth(v)*WaveformUtilities::WaveformAmplitudesResummedSumMMagSquared<Metric, Hamiltonian>::SumMMagSquared(v, r, prstar, pPhi);
+  return Flux = Evaluate(v, r, prstar, pPhi);
+}
+
+template <class Metric, class Hamiltonian>
+void Flux_SumAmplitudesResummed<Metric, Hamiltonian>::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                                               std::vector<double>& Fluxes) const {
+  if(r.size()!=v.size() || prstar.size()!=v.size() || pPhi.size()!=v.size()) {
+    Throw1WithMessage("Flux_SumAmplitudesResummed needs r, prstar, and pPhi at every v.");
+  }
+  Fluxes.resize(v.size());
+  for(unsigned int i=0; i<v.size(); ++i) {
+    Fluxes[i] = Evaluate(v[i], r[i], prstar[i], pPhi[i]);
+  }
 }
 
 
@@ -27,6 +44,20 @@ Torque_KFPhi<Flux>::Torque_KFPhi(const double delta, const double chis, const do
     v(0.0), r(0.0), prstar(0.0), pPhi(0.0), Torque(0.0)
 { }
 
+template <class Flux>
+double Torque_KFPhi<Flux>::Evaluate(const double v, const double r, const double prstar, const double pPhi) const {
+  return -F.Evaluate(v, r, prstar, pPhi)/(nu*cube(v));
+}
+
+template <class Flux>
+void Torque_KFPhi<Flux>::Evaluate(const std::vector<double>& v, const std::vector<double>& r, const std::vector<double>& prstar, const std::vector<double>& pPhi,
+                                  std::vector<double>& Torques) const {
+  F.Evaluate(v, r, prstar, pPhi, Torques);
+  for(unsigned int i=0; i<v.size(); ++i) {
+    Torques[i] = -Torques[i]/(nu*cube(v[i]));
+  }
+}
+
 template <class Flux>
 double Torque_KFPhi<Flux>::operator()(const double v_new, const double r_new, const double prstar_new, const double pPhi_new) const {
   if(v==v_new && r==r_new && prstar==prstar_new && pPhi==pPhi_new) { return Torque; }
@@ -8,22 +8,48 @@
 #include "VectorFunctions.hpp"
 #include "EOBModel.hpp"
 #include "Flux.hpp"
+#include "EOBInitialDataCache.hpp"
 typedef int NRerror;
 
 namespace WaveformUtilities {
 
-  /// Call using pre-defined Metric, Hamiltonian, and Torque
+  /// If Trajectory is non-NULL, it is filled with the dense output of
+  /// the final integration, with time shifted to match t.  The
+  /// variables are (r, Phi, prstar, pPhi).
+  ///
+  /// If Cache is non-NULL, initial data stored there for the same
+  /// parameters are used without eccentricity reduction; otherwise the
+  /// newly reduced data are added to it.
+  ///
+  /// If Workspace is non-NULL, the storage for all the integrations
+  /// (including those of the eccentricity reduction) is taken from it,
+  /// and left there for the next call; otherwise a local workspace is
+  /// shared by the integrations of this call.
+  ///
+  /// If Statistics is non-NULL, the step counts and times are added to
+  /// its phases "EccentricityReduction", "Integration (r>15)", and
+  /// "Integration (r<15)".  By default, the last two use the
+  /// Bulirsch-Stoer and DOPR853 steppers, respectively; any other
+  /// choice of Stepper is used for both.
+
+  /// Call using pre-defined Metric, Hamiltonian, and Torque.  Only
+  /// their const Evaluate members are used, so one set of them may be
+  /// shared by concurrent calls (see Test/TestEOBRHS.cpp).
   template <class Metric, class Hamiltonian, class Torque>
   void EOB(const Metric& g, const Hamiltonian& H, const Torque& T,
            const double delta, const double chis, const double chia, const double v0,
            std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
            std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi,
-           const int nsave=40, const bool denseish=true, const double rtol=1e-9);
+           const int nsave=40, const bool denseish=true, const double rtol=1e-9,
+           DenseTrajectory* Trajectory=NULL, EOBInitialDataCache* Cache=NULL, ODEWorkspace* Workspace=NULL,
+           ODEStatistics* Statistics=NULL, const ODEStepper Stepper=DefaultStepper);
 
   /// Alternatively, just use my favorite choices, for a standard PN interface
   void EOB(const double delta, const double chis, const double chia, const double v0,
            std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
-           const int nsave=40, const bool denseish=true, const double rtol=1e-9);
+           const int nsave=40, const bool denseish=true, const double rtol=1e-9,
+           DenseTrajectory* Trajectory=NULL, EOBInitialDataCache* Cache=NULL, ODEWorkspace* Workspace=NULL,
+           ODEStatistics* Statistics=NULL, const ODEStepper Stepper=DefaultStepper);
 
   #include "OrbitalPhasing_EOB.tpp"
 
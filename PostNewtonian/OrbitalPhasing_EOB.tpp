@@ -12,36 +12,60 @@ private:
 public:
   EOBHamiltonEquations(const Metric& ig, const Hamiltonian& iH, const Torque& iT) : g(ig), H(iH), T(iT) { }
   void operator()(const double t, const std::vector<double>& y, std::vector<double>& dydt) const {
-    /// Refresh the Metric, Hamiltonian, and Torque objects
-    g(y[0]);
-    H(y[0], y[2], y[3]);
-    T(H.v, y[0], y[2], y[3]); /// (v, r, prstar, pPhi)
+    /// Evaluate the Metric, Hamiltonian, and Torque into local
+    /// storage, without touching the objects' cached values, so that
+    /// one set of objects may be shared by several integrations.
+    EOBMetricValues gv;
+    EOBHamiltonianValues Hv;
+    g.Evaluate(y[0], gv);
+    H.Evaluate(y[2], y[3], gv, Hv);
+    const double Tv = T.Evaluate(Hv.v, y[0], y[2], y[3]); /// (v, r, prstar, pPhi)
 
     /// Eqs. (10) of Pan et al., 2011:
-    dydt[0] = g.drdrstar * H.dHdprstar;
-    dydt[1] = H.dHdpPhi;
-    dydt[2] = -g.drdrstar * H.dHdr + (T.Torque * y[2] / y[3]);
-    dydt[3] = T.Torque;
+    dydt[0] = gv.drdrstar * Hv.dHdprstar;
+    dydt[1] = Hv.dHdpPhi;
+    dydt[2] = -gv.drdrstar * Hv.dHdr + (Tv * y[2] / y[3]);
+    dydt[3] = Tv;
   }
-  bool ContinueIntegratingEarly(const double& t, const std::vector<double>& y, const std::vector<double>& dydt) const {
-    return (y[0]>15.0); /// Ensures that r>15
+  /// Integration stops when these become non-positive
+  double StoppingEventEarly(const double& t, const std::vector<double>& y, const std::vector<double>& dydt) const {
+    return y[0]-15.0; /// Stops at r=15
   }
-  bool ContinueIntegrating(const double& t, const std::vector<double>& y, const std::vector<double>& dydt) const {
-    return (y[0]>1.5 && y[2]<0.0); /// Ensures that r>1.5 and prstar<0
+  double StoppingEvent(const double& t, const std::vector<double>& y, const std::vector<double>& dydt) const {
+    return std::min(y[0]-1.5, -y[2]); /// Stops at r=1.5 or prstar=0
   }
 };
 
 
+template <class Metric, class Hamiltonian, class Torque>
+std::vector<double> PostCircularInitialData(const Metric& g, const Hamiltonian& H, const Torque& T, const double r0);
+
+template <class Metric, class Hamiltonian, class HamiltonEquations>
+double MeasureEccentricity(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
+                           const std::vector<double>& ystart, const double v0, const double NOrbits, const int nsave,
+                           double& rtol, double& DeltarDot, double& DeltaPhiDot,
+                           ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL);
+
 template <class Metric, class Hamiltonian, class HamiltonEquations>
 std::vector<double> ReduceEccentricity(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
-                                  const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0);
+                                  const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0,
+                                  const double NOrbits=2.0, const int nsave=1000,
+                                  ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL);
+
+template <class Metric, class Hamiltonian, class HamiltonEquations>
+std::vector<double> ReduceEccentricityNewton(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
+                                             const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0,
+                                             const double NOrbits=2.0, const int nsave=1000,
+                                             ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL);
 
 
 template <class Hamiltonian, class HamiltonEquations>
 void EOBIntegration(const Hamiltonian& H, HamiltonEquations& d, std::vector<double>& y0,
                     const double tLength, const double rtol, const double h1, const int nsave, const bool denseish,
                     std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
-                    std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi);
+                    std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi,
+                    DenseTrajectory* Trajectory=NULL, ODEWorkspace* Workspace=NULL,
+                    ODEStatistics* Statistics=NULL, const ODEStepper Stepper=DefaultStepper);
 
 
 template <class Metric, class Hamiltonian, class Torque>
@@ -49,10 +73,16 @@ void EOB(const Metric& g, const Hamiltonian& H, const Torque& T,
          const double delta, const double chis, const double chia, const double v0,
          std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
          std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi,
-         const int nsave, const bool denseish, const double rtol)
+         const int nsave, const bool denseish, const double rtol,
+         DenseTrajectory* Trajectory, EOBInitialDataCache* Cache, ODEWorkspace* Workspace,
+         ODEStatistics* Statistics, const ODEStepper Stepper)
 {
   clock_t start,end;
 
+  /// All the integrations below share one workspace
+  ODEWorkspace LocalWorkspace;
+  if(Workspace==NULL) { Workspace = &LocalWorkspace; }
+
   /// Construct the physics object
   EOBHamiltonEquations<Metric, Hamiltonian, Torque> d(g, H, T);
 
@@ -63,47 +93,23 @@ void EOB(const Metric& g, const Hamiltonian& H, const Torque& T,
   const double r0 = 1.0/(v0*v0);
   const double h1=10*(2.0*M_PI/(v0*v0*v0))/4.0;
 
-  /// Set up initial conditions
-  std::vector<double> ystart(4, 0.0);
-  g(r0);
-  ystart[0] = r0;
-  ystart[1] = 0.0;
-  ystart[3] = r0*sqrt((r0*g.dDtdr - 2*g.Dt)/(-r0*g.dDtdr + 4*g.Dt));
-  H(r0, 0.0, ystart[3]);
-  T(v0, r0, 0.0, ystart[3]);
-  const double dpPhi0dr = (-8*::pow(g.Dt,2) + 7*g.dDtdr*g.Dt*r0 - 2*::pow(g.dDtdr,2)*::pow(r0,2))/(::pow(4*g.Dt - g.dDtdr*r0,1.5)*sqrt(-2*g.Dt + g.dDtdr*r0));
-  ystart[2] = nu * g.drstardr * T.Torque / dpPhi0dr;
-  if(ystart[2]>0.0) ystart[2] *= -1;
-  //std::cout << ystart << std::endl;
-
-  //// If spin is too large, build up to the goal gradually, reducing eccentricity at each step
-  std::vector<double> chisMax(10);
-  chisMax[0] = 0.1; chisMax[1] = 0.2; chisMax[2] = 0.3; chisMax[3] = 0.4; chisMax[4] = 0.45;
-  chisMax[5] = 0.5; chisMax[6] = 0.6; chisMax[7] = 0.7; chisMax[8] = 0.8; chisMax[9] = 0.9;
-  for(unsigned int i=0; i<chisMax.size(); ++i) {
-    const double chismax = chisMax[i];
-    if(fabs(chis)>chismax) {
-      double chisloc = (chis>0 ? chismax : -chismax);
-      //std::cout << "Reducing eccentricity with chis=" << chisloc << " ... " << std::flush;
-      Metric g(EOBParameters(delta, chisloc, chia));
-      Hamiltonian H(EOBParameters(delta, chisloc, chia), g);
-      Hamiltonian Hcirc(EOBParameters(delta, chisloc, chia), g);
-      typename Torque::FluxType F(delta, chisloc, chia); /// TODO: Fix this line to work with general Flux types
-      Torque T(delta, chisloc, chia, F, Hcirc);
-      EOBHamiltonEquations<Metric, Hamiltonian, Torque> d(g, H, T);
-      ystart = ReduceEccentricity(g, H, d, ystart, 1.e-10, v0);
-    }
+  /// Set up initial conditions, from the cache if possible
+  std::vector<double> ystart = PostCircularInitialData(g, H, T, r0);
+  if(Cache!=NULL && Cache->Find(delta, chis, chia, v0, ystart[2], ystart[3])) {
+    std::cout << "Using cached initial data ... " << std::flush;
+  } else {
+    std::cout << "Reducing eccentricity ... " << std::flush;
+    start = clock();
+    ODEStatistics ReductionStatistics;
+    ystart = ReduceEccentricityNewton(g, H, d, ystart, AcceptableEcc, v0, 2.0, 1000, Workspace, &ReductionStatistics);
+    end = clock();
+    if(Statistics!=NULL) { Statistics->Record("EccentricityReduction", ReductionStatistics); }
+    std::cout << "\nEccentricity reduction took " << std::setprecision(10) << double(end-start)/double(CLOCKS_PER_SEC) << " seconds." << std::flush;
+    if(Cache!=NULL) { Cache->Insert(delta, chis, chia, v0, ystart[2], ystart[3]); }
   }
 
-  //// Now reduce eccentricity with the real parameters
-  std::cout << "Reducing eccentricity ... " << std::flush;
   start = clock();
-  ystart = ReduceEccentricity(g, H, d, ystart, AcceptableEcc, v0);
-  end = clock();
-  std::cout << "\nEccentricity reduction took " << std::setprecision(10) << double(end-start)/double(CLOCKS_PER_SEC) << " seconds." << std::flush;
-
-  start = clock();
-  EOBIntegration(H, d, ystart, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi);
+  EOBIntegration(H, d, ystart, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi, Trajectory, Workspace, Statistics, Stepper);
   end = clock();
   std::cout << "\tEOBIntegration took " << std::setprecision(10) << double(end-start)/double(CLOCKS_PER_SEC) << " seconds." << std::endl;
 
@@ -115,48 +121,52 @@ template <class Hamiltonian, class HamiltonEquations>
 void EOBIntegration(const Hamiltonian& H, HamiltonEquations& d,
                     std::vector<double>& y0, const double tLength, const double rtol, const double h1, const int nsave, const bool denseish,
                     std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
-                    std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi)
+                    std::vector<double>& r, std::vector<double>& prstar, std::vector<double>& pPhi,
+                    DenseTrajectory* Trajectory, ODEWorkspace* Workspace,
+                    ODEStatistics* Statistics, const ODEStepper Stepper)
 {
   const double atol = 0.0;
   const double t0 = 0.0, t1 = tLength;
   const double hmin=1.0e-2;
-  Output out(nsave);
+  Output out(nsave, Workspace);
+  if(Trajectory!=NULL) { Trajectory->Clear(); out.trajectory = Trajectory; }
 
-  /// First pass, integrating until tLength or the 'Early' integration test fails
-  Odeint<StepperBS<HamiltonEquations> > odeA(y0, t0, t1, atol, rtol, h1, hmin, out, d, denseish, &HamiltonEquations::ContinueIntegratingEarly);
-  //Odeint<StepperDopr853<HamiltonEquations> > odeA(y0, t0, t1, atol, rtol, h1, hmin, out, d, denseish, &HamiltonEquations::ContinueIntegratingEarly);
+  /// First pass, integrating until tLength or the 'Early' stopping
+  /// event, by default with Bulirsch-Stoer
   try {
-    odeA.integrate();
+    IntegrateODE((Stepper==DefaultStepper ? BSStepper : Stepper), y0, t0, t1, atol, rtol, h1, hmin, out, d, denseish,
+                 &HamiltonEquations::StoppingEventEarly, Statistics, "Integration (r>15)");
   } catch(NRerror err) { }
 
-  /// Second pass, only if 'Early' integration test failed
+  /// Second pass, only if the 'Early' stopping event was reached
   {
     const double t0B = out.xsave[out.count-1];
     std::vector<double> dydt(out.ysave.nrows());
     d(t0B, y0, dydt);
-    if(! d.ContinueIntegratingEarly(t0B, y0, dydt) ) {
+    if(d.StoppingEventEarly(t0B, y0, dydt) <= 0.0) {
       --out.count;
-      const double h1 = MIN(nsave*(out.xsave[out.count-1]-out.xsave[out.count-2])/1.0, (t1-t0B)/100.0);
-      Odeint<StepperDopr853<HamiltonEquations> > odeB(y0, t0B, t1, atol, rtol, h1, hmin, out, d, denseish, &HamiltonEquations::ContinueIntegrating);
+      /// If the integration started inside r=15, the first pass took no steps
+      const double h1B = (out.count>=2 ? MIN(nsave*(out.xsave[out.count-1]-out.xsave[out.count-2])/1.0, (t1-t0B)/100.0) : h1);
       try {
-        odeB.integrate();
+        IntegrateODE((Stepper==DefaultStepper ? Dopr853Stepper : Stepper), y0, t0B, t1, atol, rtol, h1B, hmin, out, d, denseish,
+                     &HamiltonEquations::StoppingEvent, Statistics, "Integration (r<15)");
       } catch(NRerror err) { }
     }
   }
 
   /// Save the results
-  out.xsave.resize(out.count);
-  t.swap(out.xsave);
-  out.ysave.resize(out.ysave.nrows(), out.count);
-  r.swap(out.ysave[0]);
-  Phi.swap(out.ysave[1]);
-  prstar.swap(out.ysave[2]);
-  pPhi.swap(out.ysave[3]);
+  out.extract_x(t);
+  out.extract_y(0, r);
+  out.extract_y(1, Phi);
+  out.extract_y(2, prstar);
+  out.extract_y(3, pPhi);
   v.resize(out.count);
+  EOBHamiltonianValues h;
   for (int i=0;i<out.count;i++) {
-    H(r[i], prstar[i], pPhi[i]);
-    v[i] = H.v;
+    H.Evaluate(r[i], prstar[i], pPhi[i], h);
+    v[i] = h.v;
   }
+  if(Trajectory!=NULL) { Trajectory->ShiftTime(-t.back()); }
   t -= t.back();
 
   return;
@@ -172,39 +182,120 @@ void EOBIntegration(const Hamiltonian& H, HamiltonEquations& d,
 //// Eccentricity measurement and removal
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
+/// Solve \f$\partial H / \partial r (r, 0, p_{\Phi}) = 0\f$ for pPhi.
+template <class Metric, class Hamiltonian>
+double CircularpPhi(const Metric& g, const Hamiltonian& H, const double r, const double pPhiGuess) {
+  EOBMetricValues m;
+  EOBHamiltonianValues h, hp, hm;
+  g.Evaluate(r, m);
+  double pPhi = pPhiGuess;
+  for(unsigned int i=0; i<50; ++i) {
+    const double dpPhi = 1.e-6*pPhi;
+    H.Evaluate(0.0, pPhi, m, h);
+    H.Evaluate(0.0, pPhi+dpPhi, m, hp);
+    H.Evaluate(0.0, pPhi-dpPhi, m, hm);
+    const double Step = h.dHdr * (2*dpPhi) / (hp.dHdr-hm.dHdr);
+    pPhi -= Step;
+    if(fabs(Step)<=1.e-15*pPhi) { break; }
+  }
+  return pPhi;
+}
+
+/// Return initial data (r0, 0, prstar, pPhi) on an adiabatic
+/// inspiral through r0.
+template <class Metric, class Hamiltonian, class Torque>
+std::vector<double> PostCircularInitialData(const Metric& g, const Hamiltonian& H, const Torque& T, const double r0) {
+  /// The angular momentum is that of the circular orbit at r0,
+  /// \f$\partial H / \partial r = 0\f$, found by Newton's method from
+  /// the spin-free estimate.  The radial momentum is then chosen so
+  /// that \f$\dot{r}\f$ matches the adiabatic inspiral rate
+  /// \f$\dot{p}_{\Phi} / (dp_{\Phi}^{\mathrm{circ}}/dr)\f$ with the
+  /// full Hamiltonian and torque, as in Buonanno and Damour, PRD 62,
+  /// 064015 (2000).  This typically leaves an eccentricity of order
+  /// 1e-6 or less before any reduction.
+  EOBMetricValues m;
+  EOBHamiltonianValues h;
+  g.Evaluate(r0, m);
+  double pPhi0 = r0*sqrt((r0*m.dDtdr - 2*m.Dt)/(-r0*m.dDtdr + 4*m.Dt));
+  pPhi0 = CircularpPhi(g, H, r0, pPhi0);
+  const double dr = 1.e-4*r0;
+  const double dpPhidr = (CircularpPhi(g, H, r0+dr, pPhi0) - CircularpPhi(g, H, r0-dr, pPhi0)) / (2*dr);
+  double prstar0 = 0.0;
+  for(unsigned int i=0; i<10; ++i) {
+    EOBHamiltonianValues hp;
+    const double dprstar = 1.e-6;
+    H.Evaluate(prstar0, pPhi0, m, h);
+    H.Evaluate(prstar0+dprstar, pPhi0, m, hp);
+    const double rDotTarget = T.Evaluate(h.v, r0, prstar0, pPhi0) / dpPhidr;
+    const double rDot = m.drdrstar * h.dHdprstar;
+    const double drDotdprstar = m.drdrstar * (hp.dHdprstar-h.dHdprstar) / dprstar;
+    const double Step = (rDot-rDotTarget) / drDotdprstar;
+    prstar0 -= Step;
+    if(fabs(Step)<=1.e-14*fabs(prstar0)) { break; }
+  }
+  std::vector<double> ystart(4, 0.0);
+  ystart[0] = r0;
+  ystart[1] = 0.0;
+  ystart[2] = prstar0;
+  ystart[3] = pPhi0;
+  return ystart;
+}
+
+/// Integrate the first few orbits from ystart, and measure the
+/// eccentricity and the corrections to remove it.
+template <class Metric, class Hamiltonian, class HamiltonEquations>
+double MeasureEccentricity(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
+                           const std::vector<double>& ystart, const double v0, const double NOrbits, const int nsave,
+                           double& rtol, double& DeltarDot, double& DeltaPhiDot,
+                           ODEWorkspace* Workspace, ODEStatistics* Statistics)
+{
+  /// Only NOrbits orbits are integrated (rather than the whole
+  /// inspiral), and the tolerance rtol is loosened if the
+  /// integration fails; the corrections are those of
+  /// Eccentricity_rDot.
+  const double Omega0 = v0*v0*v0;
+  const double GuessedLength=NOrbits*(2.0*M_PI/Omega0);
+  const bool denseish=false;
+  const double h1=GuessedLength/double(nsave);
+  std::vector<double> y(ystart);
+  std::vector<double> t, Phi, v, r, prstar, pPhi;
+  EOBIntegration(H, d, y, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi, NULL, Workspace, Statistics);
+  while(t.size()<3 && rtol<1.0e-5) {
+    rtol *= 10.0;
+    y = ystart;
+    EOBIntegration(H, d, y, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi, NULL, Workspace, Statistics);
+  }
+  if(rtol >= 1.0e-5) {
+    Throw1WithMessage("Couldn't integrate the guessed EOB initial conditions.  Check the tolerances and reasonableness of inputs.");
+  }
+  EOBMetricValues m;
+  EOBHamiltonianValues h;
+  g.Evaluate(ystart[0], m);
+  H.Evaluate(ystart[2], ystart[3], m, h);
+  return Eccentricity_rDot(t, prstar, ystart[0], h.dHdpPhi, DeltarDot, DeltaPhiDot);
+}
+
 template <class Metric, class Hamiltonian, class HamiltonEquations>
 std::vector<double> ReduceEccentricity(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
-                                       const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0)
+                                       const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0,
+                                       const double NOrbits, const int nsave,
+                                       ODEWorkspace* Workspace, ODEStatistics* Statistics)
 {
   const unsigned int NMaxIterations=1000;
-  const double Omega0 = v0*v0*v0;
   const double r0 = 1.0/(v0*v0);
   double rtol=1.0e-10;
-  const double GuessedLength=2*(2.0*M_PI/Omega0);
-  const int nsave=1000;
-  const bool denseish=false;
-  const double h1=2*(2.0*M_PI/Omega0)/double(nsave);
   std::vector<double> ystart(ystartGuess);
   std::vector<double> ystartinitial(ystart);
   std::vector<double> Bestystart(ystart);
-  std::vector<double> t, Phi, v, r, prstar, pPhi;
 
   //// Reduce eccentricity
   double BestEcc=1.e100;
   //// Iterations of arXiv:1012.1549's method
   for(unsigned int i=0; i<NMaxIterations; ++i) {
     double DeltarDot=666, DeltaPhiDot=-666;
-    EOBIntegration(H, d, ystart, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi);
-    while(t.size()<3 && rtol<1.0e-5) {
-      rtol *= 10.0;
-      EOBIntegration(H, d, ystart, GuessedLength, rtol, h1, nsave, denseish, t, v, Phi, r, prstar, pPhi);
-    }
-    if(rtol >= 1.0e-5) {
-      Throw1WithMessage("Couldn't integrate the guessed EOB initial conditions.  Check the tolerances and reasonableness of inputs.");
-    }
-    g(ystartinitial[0]);
-    H(ystartinitial[0], ystartinitial[2], ystartinitial[3]);
-    double Ecc = Eccentricity_rDot(t, prstar, ystartinitial[0], H.dHdpPhi, DeltarDot, DeltaPhiDot);
+    double Ecc = MeasureEccentricity(g, H, d, ystart, v0, NOrbits, nsave, rtol, DeltarDot, DeltaPhiDot, Workspace, Statistics);
+    EOBMetricValues m;
+    g.Evaluate(ystartinitial[0], m);
 
     if(i==0) {
       BestEcc = Ecc;
@@ -222,7 +313,7 @@ std::vector<double> ReduceEccentricity(const Metric& g, const Hamiltonian& H, co
     double Multiplier(0.95);
     if(fabs(Ecc)<1e-10) { Multiplier = 0.05; }
     if(fabs(Ecc)<1e-12) { Multiplier = 0.01; }
-    ystart[2] += Multiplier*g.drdrstar * DeltarDot;
+    ystart[2] += Multiplier*m.drdrstar * DeltarDot;
     ystart[3] += Multiplier*r0*r0 * DeltaPhiDot;
     ystartinitial = ystart;
     //std::cout << "i: " << i << "\tEcc: " << Ecc << std::endl;
@@ -232,6 +323,76 @@ std::vector<double> ReduceEccentricity(const Metric& g, const Hamiltonian& H, co
 
   return Bestystart;
 }
+
+/// Reduce eccentricity by Newton's method on the measured corrections.
+template <class Metric, class Hamiltonian, class HamiltonEquations>
+std::vector<double> ReduceEccentricityNewton(const Metric& g, const Hamiltonian& H, const HamiltonEquations& d,
+                                             const std::vector<double>& ystartGuess, const double AcceptableEcc, const double& v0,
+                                             const double NOrbits, const int nsave,
+                                             ODEWorkspace* Workspace, ODEStatistics* Statistics)
+{
+  /// The corrections (DeltarDot, DeltaPhiDot) returned by
+  /// Eccentricity_rDot vanish with the eccentricity, and are nearly
+  /// linear in (prstar, pPhi) for small eccentricity.  So rather than
+  /// taking a fraction of the correction at each step, as in
+  /// ReduceEccentricity, this solves for their root with a Jacobian
+  /// found by finite differences.  Starting from
+  /// PostCircularInitialData, this usually needs only a few steps
+  /// (three short integrations each).  The measured eccentricity is
+  /// noisy below about 1e-10, so if Newton's method does not reach
+  /// AcceptableEcc, the best data found are passed on to
+  /// ReduceEccentricity for the last, small corrections.
+  const unsigned int NMaxSteps=8;
+  /// Smallest finite-difference steps, relative to the data
+  const double MinRelativedprstar=1.e-9, MinAbsolutedprstar=1.e-12;
+  const double MinRelativedpPhi=1.e-9;
+  const double r0 = ystartGuess[0];
+  double rtol=1.0e-10;
+  std::vector<double> ystart(ystartGuess);
+  std::vector<double> Bestystart(ystart);
+  double BestEcc=1.e100;
+  try {
+    double DeltarDot, DeltaPhiDot;
+    double Ecc = MeasureEccentricity(g, H, d, ystart, v0, NOrbits, nsave, rtol, DeltarDot, DeltaPhiDot, Workspace, Statistics);
+    BestEcc = Ecc;
+    EOBMetricValues m;
+    g.Evaluate(r0, m);
+    double dprstar = std::max(fabs(m.drdrstar * DeltarDot), MinRelativedprstar*fabs(ystart[2])+MinAbsolutedprstar);
+    double dpPhi = std::max(fabs(r0*r0 * DeltaPhiDot), MinRelativedpPhi*ystart[3]);
+    for(unsigned int i=0; i<NMaxSteps && fabs(BestEcc)>=AcceptableEcc; ++i) {
+      double DeltarDot1, DeltaPhiDot1, DeltarDot2, DeltaPhiDot2;
+      std::vector<double> y1(ystart), y2(ystart);
+      y1[2] += dprstar;
+      y2[3] += dpPhi;
+      MeasureEccentricity(g, H, d, y1, v0, NOrbits, nsave, rtol, DeltarDot1, DeltaPhiDot1, Workspace, Statistics);
+      MeasureEccentricity(g, H, d, y2, v0, NOrbits, nsave, rtol, DeltarDot2, DeltaPhiDot2, Workspace, Statistics);
+      const double J00 = (DeltarDot1-DeltarDot)/dprstar, J01 = (DeltarDot2-DeltarDot)/dpPhi;
+      const double J10 = (DeltaPhiDot1-DeltaPhiDot)/dprstar, J11 = (DeltaPhiDot2-DeltaPhiDot)/dpPhi;
+      const double Det = J00*J11 - J01*J10;
+      if(Det==0.0) { break; }
+      const double Stepprstar = -(J11*DeltarDot - J01*DeltaPhiDot) / Det;
+      const double SteppPhi = -(-J10*DeltarDot + J00*DeltaPhiDot) / Det;
+      ystart[2] += Stepprstar;
+      ystart[3] += SteppPhi;
+      Ecc = MeasureEccentricity(g, H, d, ystart, v0, NOrbits, nsave, rtol, DeltarDot, DeltaPhiDot, Workspace, Statistics);
+      if(fabs(Ecc)<fabs(BestEcc)) {
+        BestEcc = Ecc;
+        Bestystart = ystart;
+      }
+      dprstar = std::max(fabs(Stepprstar), MinRelativedprstar*fabs(ystart[2])+MinAbsolutedprstar);
+      dpPhi = std::max(fabs(SteppPhi), MinRelativedpPhi*ystart[3]);
+    }
+  } catch(NRerror err) { }
+  if(fabs(BestEcc)<AcceptableEcc) {
+    return Bestystart;
+  }
+  try {
+    return ReduceEccentricity(g, H, d, Bestystart, AcceptableEcc, v0, NOrbits, nsave, Workspace, Statistics);
+  } catch(NRerror err) { }
+  std::cerr << "!!! Did not achieve acceptable eccentricity reduction !!!" << std::endl
+            << "Proceeding anyway, with e=" << BestEcc << "." << std::endl;
+  return Bestystart;
+}
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
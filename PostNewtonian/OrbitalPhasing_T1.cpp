@@ -7,8 +7,9 @@
 namespace WU = WaveformUtilities;
 typedef int NRerror;
 using WaveformUtilities::Output;
-using WaveformUtilities::Odeint;
-using WaveformUtilities::StepperDopr853;
+using WaveformUtilities::ODEWorkspace;
+using WaveformUtilities::ODEStatistics;
+using WaveformUtilities::ODEStepper;
 using std::vector;
 
 using std::cerr;
@@ -39,7 +40,7 @@ public:
       dvdtDen6(-0.0038580246913580245*(10935. - 40149.69585598816*nu + 1674.*pow(nu,2) + 7.*pow(nu,3)))
   { }
 
-  void operator() (const double t, const vector<double>& y, vector<double>& dydt) {
+  void operator() (const double t, const vector<double>& y, vector<double>& dydt) const {
     const double& v=y[0];
     const double cubv=CUB(v);
     dydt[0] = (6.4*nu)*CUB(cubv)
@@ -48,37 +49,36 @@ public:
     dydt[1]=cubv;
   }
 
-  bool ContinueIntegrating(const double& t, const vector<double>& y, const vector<double>& dydt) const {
-    return (dydt[0]>0.0 && y[0]<1.0);
+  /// Integration stops when this becomes non-positive, at v=1 or dvdt=0
+  double StoppingEvent(const double& t, const vector<double>& y, const vector<double>& dydt) const {
+    return std::min(dydt[0], 1.0-y[0]);
   }
 
 };
 
-typedef bool (T1::*ContinueTest)(const double& t, const vector<double>& y, const vector<double>& dydt) const;
+typedef double (T1::*EventTest)(const double& t, const vector<double>& y, const vector<double>& dydt) const;
 
 void WU::TaylorT1(const double delta, const double chis, const double chia, const double v0,
                   vector<double>& t, vector<double>& v, vector<double>& Phi,
-                  const int nsave, const bool denseish)
+                  const int nsave, const bool denseish, ODEWorkspace* Workspace,
+                  ODEStatistics* Statistics, const ODEStepper Stepper, const double rtol)
 {
   const double nu( (1.0-delta*delta)/4.0 );
   const double GuessedLength = 1.1 * 5.0/(256.0*nu*pow(v0,8));
-  const double rtol=1.0e-11, atol=0.0, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
+  const double atol=0.0, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
   vector<double> ystart(2);
   ystart[0]=v0;
   ystart[1]=0.0;
-  Output out(nsave);
-  T1 d(delta, chis, chia);
-  ContinueTest test = &T1::ContinueIntegrating;
-  Odeint<StepperDopr853<T1> > ode(ystart,t0,t1,atol,rtol,h1,hmin,out,d,denseish,test);
+  Output out(nsave, Workspace);
+  const T1 d(delta, chis, chia);
+  EventTest test = &T1::StoppingEvent;
   try {
-    ode.integrate();
+    WU::IntegrateODE(Stepper, ystart, t0, t1, atol, rtol, h1, hmin, out, d, denseish, test, Statistics);
   } catch(NRerror err) { }
 
-  out.xsave.resize(out.count);
-  t.swap(out.xsave);
-  out.ysave.resize(out.ysave.nrows(), out.count);
-  v.swap(out.ysave[0]);
-  Phi.swap(out.ysave[1]);
+  out.extract_x(t);
+  out.extract_y(0, v);
+  out.extract_y(1, Phi);
   t -= t.back();
 
   return;
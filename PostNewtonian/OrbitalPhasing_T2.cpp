@@ -6,16 +6,13 @@
 #include "VectorFunctions.hpp"
 namespace WU = WaveformUtilities;
 typedef int NRerror;
-using WaveformUtilities::zbrak;
 using WaveformUtilities::zriddr;
-using WaveformUtilities::fifth;
-using WaveformUtilities::eighth;
 using std::vector;
 
 class T2 {
 private:
   double nu;
-  double Phi0;
+  double Phi0, tN, PhiN;
   double t2, t3, t4, t5, t6, t6Lnv, t7;
   double Phi2, Phi3, Phi4, Phi5, Phi5Lnv, Phi6, Phi6Lnv, Phi7;
 
@@ -38,25 +35,100 @@ public:
       Phi6Lnv(-81.52380952380952),
       Phi7(2.0503957755941882e-7*(5.812952347108797e8 - 1.0916842457081544e9*pow(chia,2) - 4.074790483e9*chia*delta + 3.52392768e8*pow(chia,3)*delta) + 2.0503957755941882e-7*(4.7946122512789154e8 + 4.290127562081168e9*pow(chia,2) - 4.10784696e8*chia*delta - 1.58678352e9*pow(chia,3)*delta)*nu + 2.0503957755941882e-7*(-1.8758414548746935e8 + 8.16654384e8*chia*delta + 5.1819264e7*pow(chia,3)*delta)*pow(nu,2) + pow(chis,3)*(72.25446428571429 - 55.539434523809526*nu + 37.708333333333336*pow(nu,2)) + pow(chis,2)*(2.0503957755941882e-7*(-1.0916842457081544e9 + 1.057178304e9*chia*delta) + 2.0503957755941882e-7*(7.660942075144944e7 - 7.18956e8*chia*delta)*nu + 31.875*chia*delta*pow(nu,2)) + chis*(2.0503957755941882e-7*(-4.074790483e9 + 2.44073088e8*pow(chia,2) - 2.183368491416309e9*chia*delta + 8.13105216e8*pow(chia,2)*pow(delta,2)) + 2.0503957755941882e-7*(3.478848284e9 - 1.601589024e9*pow(chia,2))*nu + 2.0503957755941882e-7*(2.255806224e9 + 1.815706368e9*pow(chia,2))*pow(nu,2) - 82.99189814814815*pow(nu,3)))
   {
-    double t;
-    (*this)(v0, t, Phi0);
-    Phi0 *= -1.0;
+    tN = -5/(256.*nu);
+    PhiN = -1/(32.*nu);
+    double t, Phi;
+    (*this)(v0, t, Phi);
+    Phi0 = -Phi;
   }
 
   /// Make this object a functor for finding the value of v for which t=0
   double operator()(const double v) const {
-    double t, Phi;
-    (*this)(v, t, Phi);
-    return t;
+    return time(v, log(v));
+  }
+
+  /// The time t(v), given also ln(v)
+  double time(const double v, const double lnv) const {
+    const double iv = 1.0/v;
+    const double iv2 = iv*iv;
+    const double iv8 = iv2*iv2*iv2*iv2;
+    return tN*iv8*(1.0 + v*v*(t2 + v*(t3 + v*(t4 + v*(t5 + v*(t6 + t6Lnv*lnv + v*(t7) ) ) ) ) ) );
+  }
+
+  /// The derivative dt/dv, for Newton's method
+  double dtdv(const double v, const double lnv) const {
+    const double iv = 1.0/v;
+    const double iv2 = iv*iv;
+    const double iv9 = iv2*iv2*iv2*iv2*iv;
+    return tN*iv9*(-8.0 + v*v*(-6.0*t2 + v*(-5.0*t3 + v*(-4.0*t4 + v*(-3.0*t5 + v*(t6Lnv - 2.0*(t6 + t6Lnv*lnv) + v*(-t7) ) ) ) ) ) );
   }
 
   /// This evaluates the approximant for values of v
   void operator()(const double v, double& t, double& Phi) const {
-    const double lnv = log(v);
-    const double vFifth = fifth(v);
-    const double vEighth = vFifth*v*v*v;
-    t = (-5/(256.*nu*vEighth))*(1.0 + v*v*(t2 + v*(t3 + v*(t4 + v*(t5 + v*(t6 + t6Lnv*lnv + v*(t7) ) ) ) ) ) );
-    Phi = Phi0-(1/(32.*nu*vFifth))*(1.0 + v*v*(Phi2 + v*(Phi3 + v*(Phi4 + v*(Phi5 + Phi5Lnv*lnv + v*(Phi6 + Phi6Lnv*lnv + v*(Phi7) ) ) ) ) ) );
+    Evaluate(1, &v, &t, &Phi);
+  }
+
+  /// Evaluate the approximant for N values of v.  The logarithms are
+  /// taken in one pass over a chunk, and the polynomials in a second
+  /// pass with no function calls, which the compiler can vectorize;
+  /// the chunks keep both passes in cache.
+  void Evaluate(const unsigned int N, const double* v, double* t, double* Phi) const {
+    const unsigned int NChunk = 512;
+    for(unsigned int i0=0; i0<N; i0+=NChunk) {
+      const unsigned int i1 = std::min(N, i0+NChunk);
+      for(unsigned int i=i0; i<i1; ++i) {
+        Phi[i] = log(v[i]);
+      }
+      for(unsigned int i=i0; i<i1; ++i) {
+        const double x = v[i];
+        const double lnv = Phi[i];
+        const double ix = 1.0/x;
+        const double ix2 = ix*ix;
+        const double ix5 = ix2*ix2*ix;
+        const double ix8 = ix5*ix2*ix;
+        t[i] = tN*ix8*(1.0 + x*x*(t2 + x*(t3 + x*(t4 + x*(t5 + x*(t6 + t6Lnv*lnv + x*(t7) ) ) ) ) ) );
+        Phi[i] = Phi0 + PhiN*ix5*(1.0 + x*x*(Phi2 + x*(Phi3 + x*(Phi4 + x*(Phi5 + Phi5Lnv*lnv + x*(Phi6 + Phi6Lnv*lnv + x*(Phi7) ) ) ) ) ) );
+      }
+    }
+  }
+
+  /// Solve t(v)=t[i] for each i by Newton's method on ln(t(v)/t[i]),
+  /// which is close to -8*ln(v/v[i]) and so converges in a few
+  /// iterations from the leading-order inversion.  The points are
+  /// iterated in chunks, each until all of its points converge.  Phi
+  /// is used for scratch space.
+  void Invert(const unsigned int N, const double* t, double* v, double* Phi) const {
+    const unsigned int NChunk = 512;
+    const double Tolerance = 1.e-14;
+    const unsigned int MaxIterations = 50;
+    for(unsigned int i0=0; i0<N; i0+=NChunk) {
+      const unsigned int i1 = std::min(N, i0+NChunk);
+      for(unsigned int i=i0; i<i1; ++i) {
+        v[i] = pow(tN/t[i], 0.125);
+      }
+      for(unsigned int Iteration=0; ; ++Iteration) {
+        if(Iteration==MaxIterations) {
+          Throw1WithMessage("TaylorT2 failed to invert t(v); are all the times negative and before the maximum of v?");
+        }
+        double MaxCorrection = 0.0;
+        for(unsigned int i=i0; i<i1; ++i) {
+          Phi[i] = log(v[i]);
+        }
+        for(unsigned int i=i0; i<i1; ++i) {
+          const double tv = time(v[i], Phi[i]);
+          const double Ratio = tv/t[i];
+          if(!(Ratio>0.0)) { // Past t=0, so step back
+            v[i] *= 0.9;
+            MaxCorrection = 1.0;
+            continue;
+          }
+          const double Correction = log(Ratio) * tv / dtdv(v[i], Phi[i]);
+          v[i] -= Correction;
+          MaxCorrection = std::max(MaxCorrection, std::abs(Correction)/v[i]);
+        }
+        if(MaxCorrection<Tolerance) { break; }
+      }
+    }
   }
 };
 
@@ -65,18 +137,47 @@ void WU::TaylorT2(const double delta, const double chis, const double chia, cons
                   const int NPoints)
 {
   T2 d(delta, chis, chia, v0);
-  int nroot;
-  vector<double>xb1(1),xb2(1);
-  zbrak(d,0.1,1.0,10000,xb1,xb2,nroot);
+
+  // Find the first v at which t=0 by scanning as zbrak would, but
+  // stopping at the first sign change
+  const int NScan = 10000;
+  const double vScan0 = 0.1, dvScan = (1.0-vScan0)/NScan;
   double vMax=0.999;
-  if(nroot>0) { vMax=zriddr(d,xb1[0],xb2[0],fabs(1.0-xb1[0])*1.e-8); }
+  double vScan=vScan0, tPrev=d(vScan0);
+  for(int i=0; i<NScan; ++i) {
+    const double tNext = d(vScan += dvScan);
+    if(tNext*tPrev <= 0.0) {
+      vMax = zriddr(d, vScan-dvScan, vScan, fabs(1.0-(vScan-dvScan))*1.e-8);
+      break;
+    }
+    tPrev = tNext;
+  }
+
   const double dv = (vMax-v0)/double(NPoints-1);
   v.resize(NPoints);
   t.resize(NPoints);
   Phi.resize(NPoints);
   for(int i=0; i<NPoints; ++i) {
     v[i] = v0+i*dv;
-    d(v[i],t[i],Phi[i]);
+  }
+  d.Evaluate(NPoints, &v[0], &t[0], &Phi[0]);
+  return;
+}
+
+void WU::TaylorT2(const double delta, const double chis, const double chia,
+                  const vector<double>& t, vector<double>& v, vector<double>& Phi)
+{
+  if(t.size()==0) { v.clear(); Phi.clear(); return; }
+  const T2 d(delta, chis, chia, 1.0);
+  const unsigned int N = t.size();
+  v.resize(N);
+  Phi.resize(N);
+  d.Invert(N, &t[0], &v[0], &Phi[0]);
+  vector<double> tEvaluated(N);
+  d.Evaluate(N, &v[0], &tEvaluated[0], &Phi[0]);
+  const double Phi0 = Phi[0];
+  for(unsigned int i=0; i<N; ++i) {
+    Phi[i] -= Phi0;
   }
   return;
 }
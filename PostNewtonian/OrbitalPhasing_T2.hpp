@@ -9,6 +9,12 @@ namespace WaveformUtilities {
                 std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
                 const int NPoints=5000);
 
+  /// Evaluate TaylorT2 at the given times, which are measured from the
+  /// formal coalescence (so are negative), by inverting t(v) with
+  /// Newton's method.  Phi is zero at t[0].
+  void TaylorT2(const double delta, const double chis, const double chia,
+                const std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi);
+
 }
 
 #endif // ORBITALPHASING_T2_HPP
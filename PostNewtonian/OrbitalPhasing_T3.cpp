@@ -46,6 +46,32 @@ public:
     Phi = (-1.0/(nu*pow(taum8,5)))*(1.0 + taum8*taum8*(Phi2 + taum8*(Phi3 + taum8*(Phi4 + taum8*(Phi5lntau*lntau + taum8*(Phi6 + Phi6lntau*lntau + taum8*(Phi7) ) ) ) ) ) );
   }
 
+  /// Evaluate the approximant at the N times t=-5/(256*nu*u^8), for
+  /// which tau^(-1/8)=2u exactly, so that only one logarithm per point
+  /// is needed.  The logarithms are taken in one pass over a chunk, and
+  /// the polynomials in a second pass with no function calls, which
+  /// the compiler can vectorize; the chunks keep both passes in cache.
+  void Evaluate(const unsigned int N, const double* u, double* t, double* v, double* Phi) const {
+    const unsigned int NChunk = 512;
+    const double tN = -5.0/(256.0*nu);
+    for(unsigned int i0=0; i0<N; i0+=NChunk) {
+      const unsigned int i1 = std::min(N, i0+NChunk);
+      for(unsigned int i=i0; i<i1; ++i) {
+        Phi[i] = log(2.0*u[i]);
+      }
+      for(unsigned int i=i0; i<i1; ++i) {
+        const double taum8 = 2.0*u[i];
+        const double lntau = -8.0*Phi[i];
+        const double iu = 1.0/u[i];
+        const double iu2 = iu*iu;
+        const double taum5 = taum8*taum8*taum8*taum8*taum8;
+        t[i] = tN*(iu2*iu2*iu2*iu2);
+        v[i] = 0.5*taum8*(1.0 + taum8*taum8*(v2 + taum8*(v3 + taum8*(v4 + taum8*(v5 + taum8*(v6 + v6lntau*lntau + taum8*(v7) ) ) ) ) ) );
+        Phi[i] = (-1.0/(nu*taum5))*(1.0 + taum8*taum8*(Phi2 + taum8*(Phi3 + taum8*(Phi4 + taum8*(Phi5lntau*lntau + taum8*(Phi6 + Phi6lntau*lntau + taum8*(Phi7) ) ) ) ) ) );
+      }
+    }
+  }
+
   double operator()(const double t) const {
     double v, Phi;
     (*this)(v, t, Phi);
@@ -99,14 +125,14 @@ void WU::TaylorT3(const double delta, const double chis, const double chia, cons
   t.resize(NPoints);
   v.resize(NPoints);
   Phi.resize(NPoints);
-  t[0] = (-5.0/(256.0*nu))*pow(v0Bad,-8);
-  d(v[0], t[0], Phi[0]);
-  for(int i=1; i<NPoints; ++i) {
-    t[i] = (-5.0/(256.0*nu))*pow(v0Bad + (v1Bad-v0Bad)*i/double(NPoints-1),-8);
-    d(v[i], t[i], Phi[i]);
-    Phi[i] = Phi[i]-Phi[0];
+  for(int i=0; i<NPoints; ++i) {
+    v[i] = v0Bad + (v1Bad-v0Bad)*i/double(NPoints-1);
+  }
+  d.Evaluate(NPoints, &v[0], &t[0], &v[0], &Phi[0]);
+  const double Phi0 = Phi[0];
+  for(int i=0; i<NPoints; ++i) {
+    Phi[i] -= Phi0;
   }
-  Phi[0] = 0.0;
 
   //// If we couldn't find the max of v(t), remove v>1 from the data
   if(BadPoints) {
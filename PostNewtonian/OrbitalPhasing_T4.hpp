@@ -2,12 +2,25 @@
 #define ORBITALPHASING_T4_HPP
 
 #include <vector>
+#include "ODEStatistics.hpp"
 
 namespace WaveformUtilities {
 
+  class DenseTrajectory;
+  class ODEWorkspace;
+
+  /// If Trajectory is non-NULL, it is filled with the dense output of
+  /// the integration of (v, Phi), with time shifted to match t.  If
+  /// Workspace is non-NULL, the integrator's storage is taken from it
+  /// and left there for the next integration.  If Statistics is
+  /// non-NULL, the step counts and time are added to its
+  /// "Integration" phase.  The relative tolerance rtol applies to the
+  /// chosen Stepper.
   void TaylorT4(const double delta, const double chis, const double chia, const double v0,
                 std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
-                const int nsave=500, const bool denseish=true);
+                const int nsave=500, const bool denseish=true, DenseTrajectory* Trajectory=NULL,
+                ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL,
+                const ODEStepper Stepper=DefaultStepper, const double rtol=1.0e-11);
 
 }
 
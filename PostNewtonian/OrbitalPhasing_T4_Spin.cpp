@@ -9,8 +9,10 @@ typedef int NRerror;
 using WaveformUtilities::cumtrapz;
 using WaveformUtilities::dydx;
 using WaveformUtilities::Output;
-using WaveformUtilities::Odeint;
-using WaveformUtilities::StepperDopr853;
+using WaveformUtilities::DenseTrajectory;
+using WaveformUtilities::ODEWorkspace;
+using WaveformUtilities::ODEStatistics;
+using WaveformUtilities::ODEStepper;
 using std::vector;
 
 inline double SQR(const double x) { return x*x; }
@@ -18,16 +20,23 @@ inline double CUB(const double x) { return x*x*x; }
 
 namespace T4SpinLocal {
 
-  void cross(double& x, double& y, double& z, const vector<double>& a, const vector<double>& b) {
-    vector<double> c = WaveformUtilities::cross(a, b);
-    x=c[0];
-    y=c[1];
-    z=c[2];
-    return;
-  }
-
-  double dot(const vector<double>& a, const vector<double>& b) {
-    return a[0]*b[0]+a[1]*b[1]+a[2]*b[2];
+  /// A 3-vector of fixed size, kept on the stack, so that the
+  /// right-hand side below makes no heap allocations.
+  struct ThreeVector {
+    double x, y, z;
+    ThreeVector(const double ix, const double iy, const double iz) : x(ix), y(iy), z(iz) { }
+  };
+
+  inline ThreeVector operator+(const ThreeVector& a, const ThreeVector& b) { return ThreeVector(a.x+b.x, a.y+b.y, a.z+b.z); }
+  inline ThreeVector operator-(const ThreeVector& a, const ThreeVector& b) { return ThreeVector(a.x-b.x, a.y-b.y, a.z-b.z); }
+  inline ThreeVector operator*(const double s, const ThreeVector& a) { return ThreeVector(s*a.x, s*a.y, s*a.z); }
+  inline double dot(const ThreeVector& a, const ThreeVector& b) { return a.x*b.x+a.y*b.y+a.z*b.z; }
+
+  /// Write the cross product a x b into x, y, z (e.g., elements of dydt).
+  inline void cross(double& x, double& y, double& z, const ThreeVector& a, const ThreeVector& b) {
+    x = a.y*b.z-a.z*b.y;
+    y = a.z*b.x-a.x*b.z;
+    z = a.x*b.y-a.y*b.x;
   }
 
   vector<double> dot(const vector<double>& x1, const vector<double>& y1, const vector<double>& z1,
@@ -40,95 +49,80 @@ namespace T4SpinLocal {
   }
 }
 
-class T4Spin {
-private:
-  double delta, nu;
-  vector<double> chis, chia;
-  double chischis, chischia, chiachia, chisLNHat, chiaLNHat;
-  double dvdt2, dvdt3, dvdt4, dvdt5, dvdt6, dvdt6Ln4v, dvdt7;
-
-public:
-  T4Spin(const double idelta, const vector<double>& chi1, const vector<double>& chi2)
-    : delta(idelta),
-      nu((1.0-delta*delta)/4.0),
-      chis(0.5*(chi1+chi2)),
-      chia(0.5*(chi1-chi2)),
-      chischis(T4SpinLocal::dot(chis,chis)),
-      chischia(T4SpinLocal::dot(chis,chia)),
-      chiachia(T4SpinLocal::dot(chia,chia)),
-      chisLNHat(chis[2]),
-      chiaLNHat(chia[2]),
-      dvdt2(-2.2113095238095237 - 2.75*nu),
-      dvdt3(0.08333333333333333*(150.79644737231007 - 113.*chisLNHat - 113.*chiaLNHat*delta + 76.*chisLNHat*nu)),
-      dvdt4(0.00005511463844797178*(34103. - 44037.*chiachia + 135891.*pow(chiaLNHat,2) - 44037.*chischis + 135891.*pow(chisLNHat,2) - 88074.*chischia*delta + 271782.*chiaLNHat*chisLNHat*delta + 122949.*nu + 181440.*chiachia*nu - 544320.*pow(chiaLNHat,2)*nu - 5292.*chischis*nu + 756.*pow(chisLNHat,2)*nu + 59472.*pow(nu,2))),
-      dvdt5(0.000496031746031746*(-39197.65153883985 - 63142.*chisLNHat - 4536.*chiachia*chisLNHat - 1512.*chischis*chisLNHat - 63142.*chiaLNHat*delta - 1512.*chiachia*chiaLNHat*delta - 4536.*chiaLNHat*chischis*delta - 149627.77490517468*nu + 185312.*chisLNHat*nu + 13608.*chiachia*chisLNHat*nu + 4536.*chischis*chisLNHat*nu + 97860.*chiaLNHat*delta*nu + 1512.*chiachia*chiaLNHat*delta*nu + 4536.*chiaLNHat*chischis*delta*nu - 53088.*chisLNHat*pow(nu,2))),
-      dvdt6(2.385915084327783e-9*(6.745934508094527e10 - 1.3565475e8*chiachia + 5.3794125e8*pow(chiaLNHat,2) - 1.3565475e8*chischis - 4.937716571870764e10*chisLNHat + 2.684976525e10*pow(chisLNHat,2) - 4.937716571870764e10*chiaLNHat*delta - 2.713095e8*chischia*delta + 5.36995305e10*chiaLNHat*chisLNHat*delta + 2.6311824e10*pow(chiaLNHat,2)*pow(delta,2) - 6.931556164404614e10*nu + 2.28534075e9*chiachia*nu - 6.84146925e9*pow(chiaLNHat,2)*nu + 1.37598615e9*chischis*nu + 3.247920233941658e10*chisLNHat*nu - 3.548967345e10*pow(chisLNHat,2)*nu + 3.1187079e9*chischia*delta*nu - 4.01793777e10*chiaLNHat*chisLNHat*delta*nu + 2.53066275e8*pow(nu,2) - 6.2170416e9*chiachia*pow(nu,2) + 1.86511248e10*pow(chiaLNHat,2)*pow(nu,2) - 2.03742e7*chischis*pow(nu,2) + 8.8511346e9*pow(chisLNHat,2)*pow(nu,2) - 9.063285e8*pow(nu,3))),
-      dvdt6Ln4v(-16.304761904761904),
-      dvdt7(-3.440012789087038 - 18.84955592153876*(chiachia + chischis - 3.*pow(chisLNHat,2) + 2.*chischia*delta - 3.*chiaLNHat*(chiaLNHat + 2.*chisLNHat*delta)) + 0.000036743092298647854*(-2.512188e6*pow(chisLNHat,3) - 7.536564e6*chiaLNHat*pow(chisLNHat,2)*delta + chiaLNHat*delta*(-2.529407e6 + 794178.*chiachia - 2.512188e6*pow(chiaLNHat,2) + 732942.*chischis + 1.649592e6*chischia*delta) + chisLNHat*(-2.529407e6 + 732942.*chiachia + 794178.*chischis + 1.649592e6*chischia*delta - 2.512188e6*pow(chiaLNHat,2)*(1. + 2.*pow(delta,2)))) + (186.31130043424588 + 75.39822368615503*chiachia - 226.1946710584651*pow(chiaLNHat,2) + 53.1875*pow(chisLNHat,3) + 369.5*pow(chiaLNHat,3)*delta + 0.00016534391534391533*chiaLNHat*(845827. - 738864.*chiachia + 29904.*chischis)*delta + 106.65277777777777*chiaLNHat*pow(chisLNHat,2)*delta - 0.000018371546149323927*chisLNHat*(-1.0772921e7 + 7.13097e6*chiachia - 2.3022846e7*pow(chiaLNHat,2) + 674730.*chischis + 1.914948e6*chischia*delta))*nu + 0.00016534391534391533*(1.1497600793607924e6 + 3.*(-398017. + 146076.*chiachia - 431424.*pow(chiaLNHat,2) - 1204.*chischis)*chisLNHat + 840.*pow(chisLNHat,3) + 7.*chiaLNHat*(-41551. + 108.*chiachia + 324.*chischis)*delta)*pow(nu,2) + 9.467592592592593*chisLNHat*pow(nu,3))
-  { }
-
-  void operator() (const double t, const vector<double>& y, vector<double>& dydt) {
-    const double& v=y[0];
-    vector<double> S1(3, 0.0), S2(3, 0.0), LN(3, 0.0);
-    S1[0] = y[2]; S1[1] = y[3]; S1[2] = y[4];
-    S2[0] = y[5]; S2[1] = y[6]; S2[2] = y[7];
-    LN[0] = y[8]; LN[1] = y[9]; LN[2] = y[10];
-    const vector<double> LNHat = LN / sqrt(T4SpinLocal::dot(LN,LN));
-    const vector<double> chi1 = S1/SQR((1+delta)/2.);
-    const vector<double> chi2 = S2/SQR((1-delta)/2.);
-    chis = (0.5*(chi1+chi2));
-    chia = (0.5*(chi1-chi2));
-    chischis = (T4SpinLocal::dot(chis,chis));
-    chischia = (T4SpinLocal::dot(chis,chia));
-    chiachia = (T4SpinLocal::dot(chia,chia));
-    chisLNHat = (T4SpinLocal::dot(chis,LNHat));
-    chiaLNHat = (T4SpinLocal::dot(chia,LNHat));
-    dvdt2 = (-2.2113095238095237 - 2.75*nu);
-    dvdt3 = (0.08333333333333333*(150.79644737231007 - 113.*chisLNHat - 113.*chiaLNHat*delta + 76.*chisLNHat*nu));
-    dvdt4 = (0.00005511463844797178*(34103. - 44037.*chiachia + 135891.*pow(chiaLNHat,2) - 44037.*chischis + 135891.*pow(chisLNHat,2) - 88074.*chischia*delta + 271782.*chiaLNHat*chisLNHat*delta + 122949.*nu + 181440.*chiachia*nu - 544320.*pow(chiaLNHat,2)*nu - 5292.*chischis*nu + 756.*pow(chisLNHat,2)*nu + 59472.*pow(nu,2)));
-    dvdt5 = (0.000496031746031746*(-39197.65153883985 - 63142.*chisLNHat - 4536.*chiachia*chisLNHat - 1512.*chischis*chisLNHat - 63142.*chiaLNHat*delta - 1512.*chiachia*chiaLNHat*delta - 4536.*chiaLNHat*chischis*delta - 149627.77490517468*nu + 185312.*chisLNHat*nu + 13608.*chiachia*chisLNHat*nu + 4536.*chischis*chisLNHat*nu + 97860.*chiaLNHat*delta*nu + 1512.*chiachia*chiaLNHat*delta*nu + 4536.*chiaLNHat*chischis*delta*nu - 53088.*chisLNHat*pow(nu,2)));
-    dvdt6 = (2.385915084327783e-9*(6.745934508094527e10 - 1.3565475e8*chiachia + 5.3794125e8*pow(chiaLNHat,2) - 1.3565475e8*chischis - 4.937716571870764e10*chisLNHat + 2.684976525e10*pow(chisLNHat,2) - 4.937716571870764e10*chiaLNHat*delta - 2.713095e8*chischia*delta + 5.36995305e10*chiaLNHat*chisLNHat*delta + 2.6311824e10*pow(chiaLNHat,2)*pow(delta,2) - 6.931556164404614e10*nu + 2.28534075e9*chiachia*nu - 6.84146925e9*pow(chiaLNHat,2)*nu + 1.37598615e9*chischis*nu + 3.247920233941658e10*chisLNHat*nu - 3.548967345e10*pow(chisLNHat,2)*nu + 3.1187079e9*chischia*delta*nu - 4.01793777e10*chiaLNHat*chisLNHat*delta*nu + 2.53066275e8*pow(nu,2) - 6.2170416e9*chiachia*pow(nu,2) + 1.86511248e10*pow(chiaLNHat,2)*pow(nu,2) - 2.03742e7*chischis*pow(nu,2) + 8.8511346e9*pow(chisLNHat,2)*pow(nu,2) - 9.063285e8*pow(nu,3)));
-    dvdt6Ln4v = (-16.304761904761904);
-    dvdt7 = (-3.440012789087038 - 18.84955592153876*(chiachia + chischis - 3.*pow(chisLNHat,2) + 2.*chischia*delta - 3.*chiaLNHat*(chiaLNHat + 2.*chisLNHat*delta)) + 0.000036743092298647854*(-2.512188e6*pow(chisLNHat,3) - 7.536564e6*chiaLNHat*pow(chisLNHat,2)*delta + chiaLNHat*delta*(-2.529407e6 + 794178.*chiachia - 2.512188e6*pow(chiaLNHat,2) + 732942.*chischis + 1.649592e6*chischia*delta) + chisLNHat*(-2.529407e6 + 732942.*chiachia + 794178.*chischis + 1.649592e6*chischia*delta - 2.512188e6*pow(chiaLNHat,2)*(1. + 2.*pow(delta,2)))) + (186.31130043424588 + 75.39822368615503*chiachia - 226.1946710584651*pow(chiaLNHat,2) + 53.1875*pow(chisLNHat,3) + 369.5*pow(chiaLNHat,3)*delta + 0.00016534391534391533*chiaLNHat*(845827. - 738864.*chiachia + 29904.*chischis)*delta + 106.65277777777777*chiaLNHat*pow(chisLNHat,2)*delta - 0.000018371546149323927*chisLNHat*(-1.0772921e7 + 7.13097e6*chiachia - 2.3022846e7*pow(chiaLNHat,2) + 674730.*chischis + 1.914948e6*chischia*delta))*nu + 0.00016534391534391533*(1.1497600793607924e6 + 3.*(-398017. + 146076.*chiachia - 431424.*pow(chiaLNHat,2) - 1204.*chischis)*chisLNHat + 840.*pow(chisLNHat,3) + 7.*chiaLNHat*(-41551. + 108.*chiachia + 324.*chischis)*delta)*pow(nu,2) + 9.467592592592593*chisLNHat*pow(nu,3));
-    dydt[0] = (6.4*nu)*CUB(CUB(v))
-      * (1.0 + v*v*(dvdt2 + v*(dvdt3 + v*(dvdt4 + v*(dvdt5 + v*(dvdt6 + dvdt6Ln4v*log(4.0*v) + v*(dvdt7) ) ) ) ) ) );
-    dydt[1]=CUB(v);
-    const double powv5 = v*v*dydt[1];
+WU::TaylorT4SpinEquations::TaylorT4SpinEquations(const double idelta)
+  : delta(idelta),
+    nu((1.0-delta*delta)/4.0),
+    m1Squared(SQR((1+delta)/2.)),
+    m2Squared(SQR((1-delta)/2.)),
+    m2overm1((1-delta)/(1+delta)),
+    m1overm2((1+delta)/(1-delta)),
+    dvdt2(-2.2113095238095237 - 2.75*nu),
+    dvdt6Ln4v(-16.304761904761904),
     // Omega_{1,2} taken from Eq. (4.5) of http://arxiv.org/abs/1212.5520v1
-    const double Omega1 = powv5 * (0.75*(1-delta) + 0.5*nu
-                                   + v*v*(0.5625*(1-delta)+1.25*nu*(1+0.5*delta)-0.041666666666666667*nu*nu
-                                          + v*v*(0.84375 + delta*(-0.84375 + (4.875 - 0.15625*nu)*nu) + nu*(0.1875 + (-3.28125 - 0.020833333333333332*nu)*nu))));
-    const double Omega2 = powv5 * (0.75*(1+delta) + 0.5*nu
-                                   + v*v*(0.5625*(1+delta)+1.25*nu*(1-0.5*delta)-0.041666666666666667*nu*nu
-                                          + v*v*(0.84375 - delta*(-0.84375 + (4.875 - 0.15625*nu)*nu) + nu*(0.1875 + (-3.28125 - 0.020833333333333332*nu)*nu))));
-    const double m2overm1 = (1-delta)/(1+delta);
-    const double S2Mag = sqrt(T4SpinLocal::dot(S2,S2));
-    const double chi2LNHat = chisLNHat - chiaLNHat;
-    const double m1overm2 = (1+delta)/(1-delta);
-    const double S1Mag = sqrt(T4SpinLocal::dot(S1,S1));
-    const double chi1LNHat = chisLNHat + chiaLNHat;
-    const vector<double> OmegaLN = v*powv5 * ((2+1.5*m2overm1-1.5*(v/nu)*(S2Mag*chi2LNHat)) * S1 + (2+1.5*m1overm2-1.5*(v/nu)*(S1Mag*chi1LNHat)) * S2);
-    T4SpinLocal::cross(dydt[2], dydt[3], dydt[4], Omega1*LNHat, S1);
-    T4SpinLocal::cross(dydt[5], dydt[6], dydt[7], Omega2*LNHat, S2);
-    T4SpinLocal::cross(dydt[8], dydt[9], dydt[10], OmegaLN, LN);
-  }
-
-  bool ContinueIntegrating(const double& t, const vector<double>& y, const vector<double>& dydt) const {
-    return (dydt[0]>0.0 && y[0]<1.0);
-  }
+    Omega1_0(0.75*(1-delta) + 0.5*nu),
+    Omega1_2(0.5625*(1-delta)+1.25*nu*(1+0.5*delta)-0.041666666666666667*nu*nu),
+    Omega1_4(0.84375 + delta*(-0.84375 + (4.875 - 0.15625*nu)*nu) + nu*(0.1875 + (-3.28125 - 0.020833333333333332*nu)*nu)),
+    Omega2_0(0.75*(1+delta) + 0.5*nu),
+    Omega2_2(0.5625*(1+delta)+1.25*nu*(1-0.5*delta)-0.041666666666666667*nu*nu),
+    Omega2_4(0.84375 - delta*(-0.84375 + (4.875 - 0.15625*nu)*nu) + nu*(0.1875 + (-3.28125 - 0.020833333333333332*nu)*nu))
+{ }
+
+void WU::TaylorT4SpinEquations::operator() (const double t, const vector<double>& y, vector<double>& dydt) const {
+  using T4SpinLocal::ThreeVector;
+  using T4SpinLocal::dot;
+  using T4SpinLocal::cross;
+  const double& v=y[0];
+  const ThreeVector S1(y[2], y[3], y[4]);
+  const ThreeVector S2(y[5], y[6], y[7]);
+  const ThreeVector LN(y[8], y[9], y[10]);
+  const ThreeVector LNHat = (1.0/sqrt(dot(LN,LN))) * LN;
+  const ThreeVector chi1 = (1.0/m1Squared) * S1;
+  const ThreeVector chi2 = (1.0/m2Squared) * S2;
+  const ThreeVector chis = 0.5*(chi1+chi2);
+  const ThreeVector chia = 0.5*(chi1-chi2);
+  const double chischis = dot(chis,chis);
+  const double chischia = dot(chis,chia);
+  const double chiachia = dot(chia,chia);
+  const double chisLNHat = dot(chis,LNHat);
+  const double chiaLNHat = dot(chia,LNHat);
+  const double dvdt3 = (0.08333333333333333*(150.79644737231007 - 113.*chisLNHat - 113.*chiaLNHat*delta + 76.*chisLNHat*nu));
+  const double dvdt4 = (0.00005511463844797178*(34103. - 44037.*chiachia + 135891.*SQR(chiaLNHat) - 44037.*chischis + 135891.*SQR(chisLNHat) - 88074.*chischia*delta + 271782.*chiaLNHat*chisLNHat*delta + 122949.*nu + 181440.*chiachia*nu - 544320.*SQR(chiaLNHat)*nu - 5292.*chischis*nu + 756.*SQR(chisLNHat)*nu + 59472.*SQR(nu)));
+  const double dvdt5 = (0.000496031746031746*(-39197.65153883985 - 63142.*chisLNHat - 4536.*chiachia*chisLNHat - 1512.*chischis*chisLNHat - 63142.*chiaLNHat*delta - 1512.*chiachia*chiaLNHat*delta - 4536.*chiaLNHat*chischis*delta - 149627.77490517468*nu + 185312.*chisLNHat*nu + 13608.*chiachia*chisLNHat*nu + 4536.*chischis*chisLNHat*nu + 97860.*chiaLNHat*delta*nu + 1512.*chiachia*chiaLNHat*delta*nu + 4536.*chiaLNHat*chischis*delta*nu - 53088.*chisLNHat*SQR(nu)));
+  const double dvdt6 = (2.385915084327783e-9*(6.745934508094527e10 - 1.3565475e8*chiachia + 5.3794125e8*SQR(chiaLNHat) - 1.3565475e8*chischis - 4.937716571870764e10*chisLNHat + 2.684976525e10*SQR(chisLNHat) - 4.937716571870764e10*chiaLNHat*delta - 2.713095e8*chischia*delta + 5.36995305e10*chiaLNHat*chisLNHat*delta + 2.6311824e10*SQR(chiaLNHat)*SQR(delta) - 6.931556164404614e10*nu + 2.28534075e9*chiachia*nu - 6.84146925e9*SQR(chiaLNHat)*nu + 1.37598615e9*chischis*nu + 3.247920233941658e10*chisLNHat*nu - 3.548967345e10*SQR(chisLNHat)*nu + 3.1187079e9*chischia*delta*nu - 4.01793777e10*chiaLNHat*chisLNHat*delta*nu + 2.53066275e8*SQR(nu) - 6.2170416e9*chiachia*SQR(nu) + 1.86511248e10*SQR(chiaLNHat)*SQR(nu) - 2.03742e7*chischis*SQR(nu) + 8.8511346e9*SQR(chisLNHat)*SQR(nu) - 9.063285e8*CUB(nu)));
+  const double dvdt7 = (-3.440012789087038 - 18.84955592153876*(chiachia + chischis - 3.*SQR(chisLNHat) + 2.*chischia*delta - 3.*chiaLNHat*(chiaLNHat + 2.*chisLNHat*delta)) + 0.000036743092298647854*(-2.512188e6*CUB(chisLNHat) - 7.536564e6*chiaLNHat*SQR(chisLNHat)*delta + chiaLNHat*delta*(-2.529407e6 + 794178.*chiachia - 2.512188e6*SQR(chiaLNHat) + 732942.*chischis + 1.649592e6*chischia*delta) + chisLNHat*(-2.529407e6 + 732942.*chiachia + 794178.*chischis + 1.649592e6*chischia*delta - 2.512188e6*SQR(chiaLNHat)*(1. + 2.*SQR(delta)))) + (186.31130043424588 + 75.39822368615503*chiachia - 226.1946710584651*SQR(chiaLNHat) + 53.1875*CUB(chisLNHat) + 369.5*CUB(chiaLNHat)*delta + 0.00016534391534391533*chiaLNHat*(845827. - 738864.*chiachia + 29904.*chischis)*delta + 106.65277777777777*chiaLNHat*SQR(chisLNHat)*delta - 0.000018371546149323927*chisLNHat*(-1.0772921e7 + 7.13097e6*chiachia - 2.3022846e7*SQR(chiaLNHat) + 674730.*chischis + 1.914948e6*chischia*delta))*nu + 0.00016534391534391533*(1.1497600793607924e6 + 3.*(-398017. + 146076.*chiachia - 431424.*SQR(chiaLNHat) - 1204.*chischis)*chisLNHat + 840.*CUB(chisLNHat) + 7.*chiaLNHat*(-41551. + 108.*chiachia + 324.*chischis)*delta)*SQR(nu) + 9.467592592592593*chisLNHat*CUB(nu));
+  const double v2 = v*v;
+  dydt[0] = (6.4*nu)*CUB(CUB(v))
+    * (1.0 + v2*(dvdt2 + v*(dvdt3 + v*(dvdt4 + v*(dvdt5 + v*(dvdt6 + dvdt6Ln4v*log(4.0*v) + v*(dvdt7) ) ) ) ) ) );
+  dydt[1]=CUB(v);
+  const double powv5 = v2*dydt[1];
+  const double Omega1 = powv5 * (Omega1_0 + v2*(Omega1_2 + v2*Omega1_4));
+  const double Omega2 = powv5 * (Omega2_0 + v2*(Omega2_2 + v2*Omega2_4));
+  const double S2Mag = sqrt(dot(S2,S2));
+  const double chi2LNHat = chisLNHat - chiaLNHat;
+  const double S1Mag = sqrt(dot(S1,S1));
+  const double chi1LNHat = chisLNHat + chiaLNHat;
+  const ThreeVector OmegaLN = (v*powv5) * ((2+1.5*m2overm1-1.5*(v/nu)*(S2Mag*chi2LNHat)) * S1 + (2+1.5*m1overm2-1.5*(v/nu)*(S1Mag*chi1LNHat)) * S2);
+  cross(dydt[2], dydt[3], dydt[4], Omega1*LNHat, S1);
+  cross(dydt[5], dydt[6], dydt[7], Omega2*LNHat, S2);
+  cross(dydt[8], dydt[9], dydt[10], OmegaLN, LN);
+}
 
-};
+/// Integration stops when this becomes non-positive, at v=1 or dvdt=0
+double WU::TaylorT4SpinEquations::StoppingEvent(const double& t, const vector<double>& y, const vector<double>& dydt) const {
+  return std::min(dydt[0], 1.0-y[0]);
+}
 
-typedef bool (T4Spin::*ContinueTest)(const double& t, const vector<double>& y, const vector<double>& dydt) const;
+typedef double (WU::TaylorT4SpinEquations::*EventTest)(const double& t, const vector<double>& y, const vector<double>& dydt) const;
 
 void WU::TaylorT4Spin(const double delta, const vector<double>& chi1, const vector<double>& chi2, const double v0,
                       vector<double>& t, vector<double>& v, vector<double>& Phi,
                       vector<double>& chis, vector<double>& chia, vector<double>& alpha, vector<double>& beta, vector<double>& gamma,
-                      const int nsave, const bool denseish)
+                      const int nsave, const bool denseish, DenseTrajectory* Trajectory, ODEWorkspace* Workspace,
+                      ODEStatistics* Statistics, const ODEStepper Stepper, const double rtol)
 {
   const double nu( (1.0-delta*delta)/4.0 );
   const double GuessedLength = 1.1 * 5.0/(256.0*nu*pow(v0,8));
-  const double rtol=1.0e-10, atol=1.0e-15, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
+  const double atol=1.0e-15, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
   vector<double> ystart(11);
   ystart[0]=v0;                          // v
   ystart[1]=0.0;                         // Phi
@@ -142,33 +136,35 @@ void WU::TaylorT4Spin(const double delta, const vector<double>& chi1, const vect
   ystart[9] = 0.0;                       // LNHat_y
   ystart[10] = 1;                        // LNHat_z
   //std::cerr << "Initial conditions: " << ystart << std::endl;
-  Output out(nsave);
-  T4Spin d(delta, chi1, chi2);
-  ContinueTest test = &T4Spin::ContinueIntegrating;
-  Odeint<StepperDopr853<T4Spin> > ode(ystart,t0,t1,atol,rtol,h1,hmin,out,d,denseish,test);
+  Output out(nsave, Workspace);
+  if(Trajectory!=NULL) { Trajectory->Clear(); out.trajectory = Trajectory; }
+  const WU::TaylorT4SpinEquations d(delta);
+  EventTest test = &WU::TaylorT4SpinEquations::StoppingEvent;
   try {
-    ode.integrate();
+    WU::IntegrateODE(Stepper, ystart, t0, t1, atol, rtol, h1, hmin, out, d, denseish, test, Statistics);
   } catch(NRerror err) { }
 
-  out.xsave.resize(out.count);
-  t.swap(out.xsave);
+  out.extract_x(t);
+  if(Trajectory!=NULL) { Trajectory->ShiftTime(-t.back()); }
   t -= t.back();
-  out.ysave.resize(out.ysave.nrows(), out.count);
-  v.swap(out.ysave[0]);
-  Phi.swap(out.ysave[1]);
-
-  out.ysave[2] *= 2/SQR(1+delta);
-  out.ysave[3] *= 2/SQR(1+delta);
-  out.ysave[4] *= 2/SQR(1+delta);
-  out.ysave[5] *= 2/SQR(1-delta);
-  out.ysave[6] *= 2/SQR(1-delta);
-  out.ysave[7] *= 2/SQR(1-delta);
-  chis = T4SpinLocal::dot(out.ysave[8], out.ysave[9], out.ysave[10], out.ysave[2]+out.ysave[5], out.ysave[3]+out.ysave[6], out.ysave[4]+out.ysave[7]);
-  chia = T4SpinLocal::dot(out.ysave[8], out.ysave[9], out.ysave[10], out.ysave[2]-out.ysave[5], out.ysave[3]-out.ysave[6], out.ysave[4]-out.ysave[7]);
-
-  alpha = WaveformUtilities::Unwrap(atan2(out.ysave[9], out.ysave[8]));
-  beta = WaveformUtilities::Unwrap(acos(out.ysave[10]));
-  gamma = -alpha*out.ysave[10] + cumtrapz(t, dydx(out.ysave[10], t)*alpha);
+  out.extract_y(0, v);
+  out.extract_y(1, Phi);
+
+  /// Rows 2 through 10 of y are (chi1, chi2, LNHat)
+  vector<vector<double> > y(11);
+  for(unsigned int i=2; i<11; ++i) { out.extract_y(i, y[i]); }
+  y[2] *= 2/SQR(1+delta);
+  y[3] *= 2/SQR(1+delta);
+  y[4] *= 2/SQR(1+delta);
+  y[5] *= 2/SQR(1-delta);
+  y[6] *= 2/SQR(1-delta);
+  y[7] *= 2/SQR(1-delta);
+  chis = T4SpinLocal::dot(y[8], y[9], y[10], y[2]+y[5], y[3]+y[6], y[4]+y[7]);
+  chia = T4SpinLocal::dot(y[8], y[9], y[10], y[2]-y[5], y[3]-y[6], y[4]-y[7]);
+
+  alpha = WaveformUtilities::Unwrap(atan2(y[9], y[8]));
+  beta = WaveformUtilities::Unwrap(acos(y[10]));
+  gamma = -alpha*y[10] + cumtrapz(t, dydx(y[10], t)*alpha);
 
   return;
 }
@@ -177,11 +173,12 @@ void WU::TaylorT4Spin(const double delta, const vector<double>& chi1, const vect
 void WU::TaylorT4Spin(const double delta, const vector<double>& chi1, const vector<double>& chi2, const double v0,
                       vector<double>& t, vector<double>& v, vector<double>& Phi,
                       vector<vector<double> >& S1, vector<vector<double> >& S2, vector<vector<double> >& LNHat,
-                      const int nsave, const bool denseish)
+                      const int nsave, const bool denseish, DenseTrajectory* Trajectory, ODEWorkspace* Workspace,
+                      ODEStatistics* Statistics, const ODEStepper Stepper, const double rtol)
 {
   const double nu( (1.0-delta*delta)/4.0 );
   const double GuessedLength = 1.1 * 5.0/(256.0*nu*pow(v0,8));
-  const double rtol=1.0e-10, atol=1.0e-15, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
+  const double atol=1.0e-15, h1=1.0e2, hmin=1.0e-3, t0=-GuessedLength, t1=0.0;
   vector<double> ystart(11);
   ystart[0]=v0;                          // v
   ystart[1]=0.0;                         // Phi
@@ -195,33 +192,28 @@ void WU::TaylorT4Spin(const double delta, const vector<double>& chi1, const vect
   ystart[9] = 0.0;                       // LNHat_y
   ystart[10] = 1;                        // LNHat_z
   //std::cerr << "Initial conditions: " << ystart << std::endl;
-  Output out(nsave);
-  T4Spin d(delta, chi1, chi2);
-  ContinueTest test = &T4Spin::ContinueIntegrating;
-  Odeint<StepperDopr853<T4Spin> > ode(ystart,t0,t1,atol,rtol,h1,hmin,out,d,denseish,test);
+  Output out(nsave, Workspace);
+  if(Trajectory!=NULL) { Trajectory->Clear(); out.trajectory = Trajectory; }
+  const WU::TaylorT4SpinEquations d(delta);
+  EventTest test = &WU::TaylorT4SpinEquations::StoppingEvent;
   try {
-    ode.integrate();
+    WU::IntegrateODE(Stepper, ystart, t0, t1, atol, rtol, h1, hmin, out, d, denseish, test, Statistics);
   } catch(NRerror err) { }
 
-  out.xsave.resize(out.count);
-  t.swap(out.xsave);
+  out.extract_x(t);
+  if(Trajectory!=NULL) { Trajectory->ShiftTime(-t.back()); }
   t -= t.back();
-  out.ysave.resize(out.ysave.nrows(), out.count);
-  v.swap(out.ysave[0]);
-  Phi.swap(out.ysave[1]);
+  out.extract_y(0, v);
+  out.extract_y(1, Phi);
 
   S1.resize(3);
-  S1[0].swap(out.ysave[2]);
-  S1[1].swap(out.ysave[3]);
-  S1[2].swap(out.ysave[4]);
   S2.resize(3);
-  S2[0].swap(out.ysave[5]);
-  S2[1].swap(out.ysave[6]);
-  S2[2].swap(out.ysave[7]);
   LNHat.resize(3);
-  LNHat[0].swap(out.ysave[8]);
-  LNHat[1].swap(out.ysave[9]);
-  LNHat[2].swap(out.ysave[10]);
+  for(unsigned int i=0; i<3; ++i) {
+    out.extract_y(2+i, S1[i]);
+    out.extract_y(5+i, S2[i]);
+    out.extract_y(8+i, LNHat[i]);
+  }
 
   return;
 }
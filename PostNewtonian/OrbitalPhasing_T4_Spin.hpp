@@ -2,18 +2,50 @@
 #define ORBITALPHASING_T4_SPIN_HPP
 
 #include <vector>
+#include "ODEStatistics.hpp"
 
 namespace WaveformUtilities {
 
+  class DenseTrajectory;
+  class ODEWorkspace;
+
+  /// Right-hand side of the precessing TaylorT4 equations, for the
+  /// variables y = (v, Phi, S1, S2, LN), with the spins in units of
+  /// M^2.  Everything that depends only on the masses is computed
+  /// once in the constructor; the 3-vectors are kept on the stack, so
+  /// that a call makes no heap allocations.
+  class TaylorT4SpinEquations {
+  private:
+    double delta, nu, m1Squared, m2Squared, m2overm1, m1overm2;
+    double dvdt2, dvdt6Ln4v;
+    double Omega1_0, Omega1_2, Omega1_4, Omega2_0, Omega2_2, Omega2_4;
+  public:
+    TaylorT4SpinEquations(const double idelta);
+    void operator() (const double t, const std::vector<double>& y, std::vector<double>& dydt) const;
+    double StoppingEvent(const double& t, const std::vector<double>& y, const std::vector<double>& dydt) const;
+  };
+
+  /// If Trajectory is non-NULL, it is filled with the dense output of
+  /// the integration, with time shifted to match t.  The variables are
+  /// (v, Phi, S1, S2, LNHat), where the spins are in units of M^2.  If
+  /// Workspace is non-NULL, the integrator's storage is taken from it
+  /// and left there for the next integration.  If Statistics is
+  /// non-NULL, the step counts and time are added to its
+  /// "Integration" phase.  The relative tolerance rtol applies to the
+  /// chosen Stepper.
   void TaylorT4Spin(const double delta, const std::vector<double>& chi1, const std::vector<double>& chi2, const double v0,
                     std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
                     std::vector<double>& chis, std::vector<double>& chia, std::vector<double>& alpha, std::vector<double>& beta, std::vector<double>& gamma,
-                    const int nsave=500, const bool denseish=true);
+                    const int nsave=500, const bool denseish=true, DenseTrajectory* Trajectory=NULL,
+                    ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL,
+                    const ODEStepper Stepper=DefaultStepper, const double rtol=1.0e-10);
 
   void TaylorT4Spin(const double delta, const std::vector<double>& chi1, const std::vector<double>& chi2, const double v0,
                     std::vector<double>& t, std::vector<double>& v, std::vector<double>& Phi,
                     std::vector<std::vector<double> >& S1, std::vector<std::vector<double> >& S2, std::vector<std::vector<double> >& LNHat,
-                    const int nsave=500, const bool denseish=true);
+                    const int nsave=500, const bool denseish=true, DenseTrajectory* Trajectory=NULL,
+                    ODEWorkspace* Workspace=NULL, ODEStatistics* Statistics=NULL,
+                    const ODEStepper Stepper=DefaultStepper, const double rtol=1.0e-10);
 
 }
 
@@ -1,83 +1,222 @@
 #include "NumericalRecipes.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 #include "QNMs.hpp"
 
-#include "Interpolate.hpp"
 #include "Utilities.hpp"
 using WaveformUtilities::Matrix;
-using WaveformUtilities::Interpolate;
+using WaveformUtilities::QNMTable;
 using std::vector;
+using std::string;
 using std::cerr;
 using std::endl;
 
-//// We have the following (l,m) modes at present:
+//// The built-in data contain the following (l,m) modes:
 ////   [0] = 2,2
 ////   [1] = 2,1
 ////   [2] = 3,3
 ////   [3] = 3,2
 ////   [4] = 4,4
-//// We have the 8 overtones 0 through 7
+//// with the 8 overtones 0 through 7.  More may be added with
+//// ReadQNMTable.
 
 Matrix<int> WaveformUtilities::QNMLMs() {
-  Matrix<int> LMs(10, 2);
-  LMs[0][0] = 2; LMs[0][1] = -2;
-  LMs[1][0] = 2; LMs[1][1] = -1;
-  LMs[2][0] = 2; LMs[2][1] =  1;
-  LMs[3][0] = 2; LMs[3][1] =  2;
-  LMs[4][0] = 3; LMs[4][1] = -3;
-  LMs[5][0] = 3; LMs[5][1] = -2;
-  LMs[6][0] = 3; LMs[6][1] =  2;
-  LMs[7][0] = 3; LMs[7][1] =  3;
-  LMs[8][0] = 4; LMs[8][1] = -4;
-  LMs[9][0] = 4; LMs[9][1] =  4;
-  return LMs;
+  return QNMTable::Instance().LMs();
 }
 
-void Initialize();
-bool Initialized=false;
-vector<double> EvaluatedSpins(21);
-vector<vector<vector<double> > > omegasRe(5, vector<vector<double> >(8, vector<double>(21, 0.0)));
-vector<vector<vector<double> > > omegasIm(5, vector<vector<double> >(8, vector<double>(21, 0.0)));
-
 void WaveformUtilities::QNM(const int L, const int M, const int N, const double chi, double& omegaRe, double& omegaIm) {
-  if(N>7) {
-    std::cerr << "N=" << N << " has not been included in the data." << std::endl;
-    Throw1WithMessage("Bad overtone N request.");
+  QNMTable::Instance().Evaluate(L, M, N, chi, omegaRe, omegaIm);
+}
+
+void WaveformUtilities::QNMOvertones(const int L, const int M, const double chi, std::vector<double>& omegaRe, std::vector<double>& omegaIm) {
+  QNMTable::Instance().EvaluateOvertones(L, M, chi, omegaRe, omegaIm);
+}
+
+void WaveformUtilities::ReadQNMTable(const std::string& FileName) {
+  QNMTable::Instance().Read(FileName);
+}
+
+
+/// Return the single instance of the table, constructing it on first use.
+QNMTable& QNMTable::Instance() {
+  /// The built-in data are loaded when this is first called.  The
+  /// compiler guarantees that a function-local static is initialized
+  /// exactly once, even when several threads call this function at
+  /// the same time.
+  static QNMTable Table;
+  return Table;
+}
+
+/// Store the data for one overtone, and compute the second
+/// derivatives of the natural cubic splines through them.
+void QNMTable::Add(const int L, const int M, const int N, const std::vector<double>& Spins,
+                   const std::vector<double>& OmegaRe, const std::vector<double>& OmegaIm)
+{
+  if(N<0) { Throw1WithMessage("Negative overtone index"); }
+  if(Spins.size()<2 || OmegaRe.size()!=Spins.size() || OmegaIm.size()!=Spins.size()) {
+    cerr << "(L,M,N)=(" << L << "," << M << "," << N << ") has " << Spins.size() << " spins, "
+         << OmegaRe.size() << " real and " << OmegaIm.size() << " imaginary parts." << endl;
+    Throw1WithMessage("Bad QNM data");
+  }
+  for(unsigned int i=1; i<Spins.size(); ++i) {
+    if(Spins[i]<=Spins[i-1]) { Throw1WithMessage("QNM spins must be strictly increasing"); }
   }
+  vector<Series>& Overtones = Modes[std::make_pair(L, abs(M))];
+  if(Overtones.size()<=(unsigned int)(N)) { Overtones.resize(N+1); }
+  Series& S = Overtones[N];
+  S.Spins = Spins;
+  S.Re = OmegaRe;
+  S.Im = OmegaIm;
+  Spline(S.Spins, S.Re, S.Re2);
+  Spline(S.Spins, S.Im, S.Im2);
+}
 
-  if(!Initialized) Initialize();
+/// Second derivatives of the natural cubic spline through (x,y).
+void QNMTable::Spline(const std::vector<double>& x, const std::vector<double>& y, std::vector<double>& y2) {
+  /// This is the same computation as SplineInterpolator::sety2, so
+  /// that the results are identical to those of Interpolate.
+  const unsigned int n = x.size();
+  vector<double> u(n-1);
+  y2.resize(n);
+  y2[0] = u[0] = 0.0;
+  for(unsigned int i=1; i<n-1; ++i) {
+    const double sig = (x[i]-x[i-1])/(x[i+1]-x[i-1]);
+    const double p = sig*y2[i-1]+2.0;
+    y2[i] = (sig-1.0)/p;
+    u[i] = (y[i+1]-y[i])/(x[i+1]-x[i]) - (y[i]-y[i-1])/(x[i]-x[i-1]);
+    u[i] = (6.0*u[i]/(x[i+1]-x[i-1])-sig*u[i-1])/p;
+  }
+  y2[n-1] = 0.0;
+  for(int k=n-2; k>=0; --k) {
+    y2[k] = y2[k]*y2[k+1]+u[k];
+  }
+}
 
-  //// Find the right pair of vectors
-  unsigned int i=0;
-  if(L==2 && abs(M)==2) {
-    i=0;
-  } else if(L==2 && abs(M)==1) {
-    i=1;
-  } else if(L==3 && abs(M)==3) {
-    i=2;
-  } else if(L==3 && abs(M)==2) {
-    i=3;
-  } else if(L==4 && abs(M)==4) {
-    i=4;
-  } else {
+const std::vector<QNMTable::Series>& QNMTable::Overtones(const int L, const int M) const {
+  std::map<std::pair<int,int>, std::vector<Series> >::const_iterator it = Modes.find(std::make_pair(L, abs(M)));
+  if(it==Modes.end()) {
     cerr << "(L,M)=(" << L << "," << M << ") has not been included in the data." << endl;
     Throw1WithMessage("Bad (L,M) request");
   }
+  return it->second;
+}
+
+/// Evaluate the spline of one overtone at chi.
+void QNMTable::Evaluate(const Series& S, const double chi, double& omegaRe, double& omegaIm) {
+  /// The interval is guessed assuming nearly uniform spacing, then
+  /// corrected, which takes O(1) steps for the built-in data.  Spins
+  /// outside the data are extrapolated with the end intervals, as
+  /// Interpolate does.
+  const vector<double>& x = S.Spins;
+  const int n = x.size();
+  if(n<2) { Throw1WithMessage("Missing QNM overtone in the data"); }
+  int j = int((chi-x[0])*(n-1)/(x[n-1]-x[0]));
+  j = std::max(0, std::min(n-2, j));
+  while(j>0 && chi<x[j]) { --j; }
+  while(j<n-2 && chi>=x[j+1]) { ++j; }
+  const double h = x[j+1]-x[j];
+  const double a = (x[j+1]-chi)/h;
+  const double b = (chi-x[j])/h;
+  const double ca = (a*a*a-a)*(h*h)/6.0;
+  const double cb = (b*b*b-b)*(h*h)/6.0;
+  omegaRe = a*S.Re[j] + b*S.Re[j+1] + ca*S.Re2[j] + cb*S.Re2[j+1];
+  omegaIm = a*S.Im[j] + b*S.Im[j+1] + ca*S.Im2[j] + cb*S.Im2[j+1];
+}
 
-  //// Interpolate each to the desired spin
-  omegaRe = Interpolate(EvaluatedSpins, omegasRe[i][N], chi);
-  omegaIm = Interpolate(EvaluatedSpins, omegasIm[i][N], chi);
+/// Replace the last two arguments with the real and imaginary parts of omegalmn.
+void QNMTable::Evaluate(const int L, const int M, const int N, const double chi, double& omegaRe, double& omegaIm) const {
+  const vector<Series>& S = Overtones(L, M);
+  if(N<0 || (unsigned int)(N)>=S.size()) {
+    cerr << "N=" << N << " has not been included in the data." << endl;
+    Throw1WithMessage("Bad overtone N request.");
+  }
+  Evaluate(S[N], chi, omegaRe, omegaIm);
   if(M>0) omegaRe *= -1.0; // ensures negative frequencies for positive M; spin is s=-2
+}
+
+/// Fill the last two arguments with omegalmn for every overtone n in the data.
+void QNMTable::EvaluateOvertones(const int L, const int M, const double chi, std::vector<double>& omegaRe, std::vector<double>& omegaIm) const {
+  const vector<Series>& S = Overtones(L, M);
+  omegaRe.resize(S.size());
+  omegaIm.resize(S.size());
+  for(unsigned int N=0; N<S.size(); ++N) {
+    Evaluate(S[N], chi, omegaRe[N], omegaIm[N]);
+    if(M>0) omegaRe[N] *= -1.0;
+  }
+}
 
-  return;
+/// Number of overtones in the data for this (l,m).
+unsigned int QNMTable::NOvertones(const int L, const int M) const {
+  std::map<std::pair<int,int>, std::vector<Series> >::const_iterator it = Modes.find(std::make_pair(L, abs(M)));
+  return (it==Modes.end() ? 0 : it->second.size());
 }
 
+/// Return every (l,m) in the data, with both signs of m, ordered by l then m.
+WaveformUtilities::Matrix<int> QNMTable::LMs() const {
+  vector<std::pair<int,int> > Pairs;
+  for(std::map<std::pair<int,int>, std::vector<Series> >::const_iterator it=Modes.begin(); it!=Modes.end(); ++it) {
+    Pairs.push_back(std::make_pair(it->first.first, -it->first.second));
+    if(it->first.second!=0) { Pairs.push_back(it->first); }
+  }
+  std::sort(Pairs.begin(), Pairs.end());
+  Matrix<int> LMs(Pairs.size(), 2);
+  for(unsigned int i=0; i<Pairs.size(); ++i) {
+    LMs[i][0] = Pairs[i].first;
+    LMs[i][1] = Pairs[i].second;
+  }
+  return LMs;
+}
+
+/// Add the QNM frequencies in a text file to the table.
+void QNMTable::Read(const std::string& FileName) {
+  /// Each line of the file should contain
+  ///
+  ///   l m n chi omegaRe omegaIm
+  ///
+  /// using the conventions of the built-in data: omegaRe is the
+  /// (positive) frequency of the (l,-|m|) mode, so only |m| matters,
+  /// and omegaIm is the (positive) inverse damping time.  Lines
+  /// beginning with '#' are ignored.  Rows for each (l,|m|,n) must be
+  /// sorted by chi, and replace any existing data for that overtone.
+  ///
+  /// This modifies the shared table, so it should be called before
+  /// the table is used from several threads.
+  std::ifstream ifs(FileName.c_str());
+  if(!ifs.is_open()) {
+    cerr << "\nFailed to open '" << FileName << "' for reading." << endl;
+    Throw1WithMessage("Unreadable file");
+  }
+  typedef std::pair<std::pair<int,int>, int> LMN;
+  std::map<LMN, std::vector<std::vector<double> > > Data; // (chi, omegaRe, omegaIm) for each (l,|m|,n)
+  string Line;
+  while(getline(ifs, Line)) {
+    const string::size_type First = Line.find_first_not_of(" \t");
+    if(First==string::npos || Line[First]=='#') { continue; }
+    std::istringstream iss(Line);
+    int l, m, n;
+    double chi, Re, Im;
+    if(!(iss >> l >> m >> n >> chi >> Re >> Im)) {
+      cerr << "Could not parse the line\n" << Line << "\nin '" << FileName << "'." << endl;
+      Throw1WithMessage("Bad QNM table");
+    }
+    std::vector<std::vector<double> >& D = Data[LMN(std::make_pair(l, abs(m)), n)];
+    D.resize(3);
+    D[0].push_back(chi);
+    D[1].push_back(Re);
+    D[2].push_back(Im);
+  }
+  for(std::map<LMN, std::vector<std::vector<double> > >::const_iterator it=Data.begin(); it!=Data.end(); ++it) {
+    Add(it->first.first.first, it->first.first.second, it->first.second, it->second[0], it->second[1], it->second[2]);
+  }
+}
 
 
-void Initialize() {
-  //// Set the values of EvaluatedSpins, omegasRe, and omegasIm
+/// Load the built-in data.
+QNMTable::QNMTable() : Modes() {
   const double EvaluatedSpinsArray[] = {0., 0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5, 0.55, 0.6, 0.65, 0.7, 0.75, 0.8, 0.85, 0.9, 0.95, 0.998};
-  EvaluatedSpins.assign(EvaluatedSpinsArray, EvaluatedSpinsArray+21);
 
   const double omegasReArray[5][8][21] = {
     {
@@ -172,13 +311,6 @@ void Initialize() {
     }
   };
 
-  for(unsigned int i=0; i<5; ++i) {
-    for(unsigned int j=0; j<8; ++j) {
-      omegasRe[i][j].assign(&omegasReArray[i][j][0], &omegasReArray[i][j][21]);
-    }
-  }
-
-
   const double omegasImArray[5][8][21] = {
     {
       {0.088962316, 0.0888481566875, 0.088705699, 0.0885287623125, 0.088311166, 0.0880485175625, 0.087729272, 0.0873469440625, 0.086881962, 0.0889623160, 0.0889623161,
@@ -278,13 +410,14 @@ void Initialize() {
     }
   };
 
+  const int Ls[5] = {2, 2, 3, 3, 4};
+  const int Ms[5] = {2, 1, 3, 2, 4};
+  const vector<double> EvaluatedSpins(EvaluatedSpinsArray, EvaluatedSpinsArray+21);
   for(unsigned int i=0; i<5; ++i) {
     for(unsigned int j=0; j<8; ++j) {
-      omegasIm[i][j].assign(&omegasImArray[i][j][0], &omegasImArray[i][j][21]);
+      Add(Ls[i], Ms[i], j, EvaluatedSpins,
+          vector<double>(&omegasReArray[i][j][0], &omegasReArray[i][j][21]),
+          vector<double>(&omegasImArray[i][j][0], &omegasImArray[i][j][21]));
     }
   }
-
-
-  Initialized = true;
-  return;
 }
@@ -1,6 +1,9 @@
 #ifndef QNMS_HPP
 #define QNMS_HPP
 
+#include <map>
+#include <string>
+#include <vector>
 #include "Matrix.hpp"
 
 /// omegalmn = omegaRe + i*omegaIm
@@ -11,8 +14,51 @@ namespace WaveformUtilities {
   /// This function replaces the last two arguments with the real and imaginary parts of omegalmn
   void QNM(const int L, const int M, const int N, const double chi, double& omegaRe, double& omegaIm);
 
+  /// This function fills the last two arguments with omegalmn for all overtones n in the data
+  void QNMOvertones(const int L, const int M, const double chi, std::vector<double>& omegaRe, std::vector<double>& omegaIm);
+
   WaveformUtilities::Matrix<int> QNMLMs();
 
+  /// Add (l,m,n) data from a text file; see QNMTable::Read
+  void ReadQNMTable(const std::string& FileName);
+
+
+  /// This class holds the QNM frequencies as functions of the final
+  /// spin chi, tabulated for each (l,|m|,n), along with the second
+  /// derivatives of natural cubic splines through them.  The splines
+  /// are set up once, when the data are loaded, so evaluation at any
+  /// chi is O(1).
+  ///
+  /// There is a single instance, which is created with the built-in
+  /// data the first time it is used, and may be extended with
+  /// ReadQNMTable.  Once any tables have been read, evaluation is
+  /// safe from several threads at once.
+  class QNMTable {
+  private:
+    struct Series {
+      std::vector<double> Spins, Re, Im, Re2, Im2;
+    };
+    std::map<std::pair<int,int>, std::vector<Series> > Modes;
+
+  private:
+    QNMTable();
+    QNMTable(const QNMTable&);
+    QNMTable& operator=(const QNMTable&);
+    static void Spline(const std::vector<double>& x, const std::vector<double>& y, std::vector<double>& y2);
+    static void Evaluate(const Series& S, const double chi, double& omegaRe, double& omegaIm);
+    const std::vector<Series>& Overtones(const int L, const int M) const;
+
+  public:
+    static QNMTable& Instance();
+    void Add(const int L, const int M, const int N, const std::vector<double>& Spins,
+             const std::vector<double>& OmegaRe, const std::vector<double>& OmegaIm);
+    void Read(const std::string& FileName);
+    void Evaluate(const int L, const int M, const int N, const double chi, double& omegaRe, double& omegaIm) const;
+    void EvaluateOvertones(const int L, const int M, const double chi, std::vector<double>& omegaRe, std::vector<double>& omegaIm) const;
+    unsigned int NOvertones(const int L, const int M) const;
+    WaveformUtilities::Matrix<int> LMs() const;
+  };
+
 }
 
 #endif // QNMS_HPP
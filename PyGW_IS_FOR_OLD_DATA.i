@@ -26,6 +26,8 @@
   #include "Objects/WaveformAtAPoint.hpp"
   #include "Objects/WaveformAtAPointFT.hpp"
   #include "Objects/Waveforms.hpp"
+  #include "Objects/PNWaveformCache.hpp"
+  #include "Objects/HybridPipeline.hpp"
   #include "Utilities/NoiseCurves.hpp"
   #include "Utilities/Quaternions.hpp"
   #include "Utilities/SWSHs.hpp"
@@ -170,6 +172,20 @@ namespace std {
  };
 
 
+///////////////////////////////////////////
+//// Read in the PNWaveformCache class ////
+///////////////////////////////////////////
+//// Parse the header file to generate wrappers
+%include "Objects/PNWaveformCache.hpp"
+
+
+//////////////////////////////////////////
+//// Read in the HybridPipeline class ////
+//////////////////////////////////////////
+//// Parse the header file to generate wrappers
+%include "Objects/HybridPipeline.hpp"
+
+
 ////////////////////////////////////////////
 //// Read in the WaveformAtAPoint class ////
 ////////////////////////////////////////////
@@ -1121,6 +1121,7 @@ Transform the Waveform back to the original frame.
     const double chiKerr
     double dt = 0.0
     const double TLength = 500.0
+    const unsigned int NOvertones = 1
   
   Returns
   -------
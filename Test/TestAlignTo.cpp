@@ -0,0 +1,56 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "VectorFunctions.hpp"
+using namespace std;
+using WaveformObjects::Waveform;
+
+/// Align a copy of a TaylorT4 waveform, shifted in time and phase, to
+/// the original over several windows, reporting the time per
+/// alignment, the number of evaluations of the objective, and the
+/// errors in the recovered shifts.  Then do the
+/// same with the FFT-based AlignTo_FFT.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.0, v0=0.1;
+  const double Shift=37.3, PhaseShift=0.3;
+  clock_t start, end;
+
+  const Waveform A("TaylorT4", delta, chis, chia, v0);
+  Waveform B0(A);
+  B0.AddToTime(Shift);
+  for(unsigned int i=0; i<B0.NModes(); ++i) {
+    B0.ArgRef(i) += PhaseShift*B0.M(i);
+  }
+
+  const double Fractions[][2] = { {0.1, 0.3}, {0.3, 0.5}, {0.5, 0.9}, {0.9, 0.99} };
+  cout << "# t1 t2 Seconds NEvaluations TimeError PhaseError" << endl;
+  for(unsigned int i=0; i<4; ++i) {
+    const double t1 = A.T(0) + Fractions[i][0]*(A.T().back()-A.T(0));
+    const double t2 = A.T(0) + Fractions[i][1]*(A.T().back()-A.T(0));
+    Waveform B(B0);
+    unsigned int NEvaluations = 0;
+    start = clock();
+    B.AlignTo(A, t1, t2, &NEvaluations);
+    end = clock();
+    cout << setprecision(8) << t1 << " " << t2 << " " << double(end-start)/double(CLOCKS_PER_SEC) << " "
+         << NEvaluations << " "
+         << setprecision(4) << B.T(0)-A.T(0) << " " << B.Arg(0,0)-A.Arg(0,0) << endl;
+  }
+
+  cout << "# AlignTo_FFT\n# t1 t2 Seconds TimeError PhaseError" << endl;
+  for(unsigned int i=0; i<4; ++i) {
+    const double t1 = A.T(0) + Fractions[i][0]*(A.T().back()-A.T(0));
+    const double t2 = A.T(0) + Fractions[i][1]*(A.T().back()-A.T(0));
+    Waveform B(B0);
+    start = clock();
+    B.AlignTo_FFT(A, t1, t2);
+    end = clock();
+    cout << setprecision(8) << t1 << " " << t2 << " " << double(end-start)/double(CLOCKS_PER_SEC) << " "
+         << setprecision(4) << B.T(0)-A.T(0) << " " << B.Arg(0,0)-A.Arg(0,0) << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "PostNewtonian.hpp"
+#include "QNMs.hpp"
+using namespace std;
+using WaveformObjects::Waveform;
+namespace WU = WaveformUtilities;
+
+/// Largest step in the phase of any mode after the peak, which should
+/// be small if the ringdown is attached continuously.
+double MaxPhaseStep(const Waveform& W) {
+  double MaxStep = 0.0;
+  for(unsigned int i=W.NTimes()/2+1; i<W.NTimes(); ++i) {
+    for(unsigned int m=0; m<W.NModes(); ++m) {
+      MaxStep = max(MaxStep, fabs(W.Arg(m,i)-W.Arg(m,i-1)));
+    }
+  }
+  return MaxStep;
+}
+
+/// Time ringdown attachment with the n=0 mode alone, and with a
+/// least-squares fit of several overtones.
+int main() {
+  const double q=3.0, chis=0.4;
+  const double delta = (q-1.0)/(q+1.0);
+  const double chiKerr = WU::FinalSpinApproximation(delta, chis);
+  const Waveform Inspiral("EOB", delta, chis, 0.0, 0.2, WU::QNMLMs(), 5, true);
+  clock_t start, end;
+
+  const unsigned int NAttachments = 20;
+  const unsigned int Overtones[3] = {1, 3, 8};
+  for(unsigned int k=0; k<3; ++k) {
+    Waveform W;
+    double Seconds = 0.0;
+    for(unsigned int i=0; i<NAttachments; ++i) {
+      W = Inspiral;
+      start = clock();
+      W.AttachQNMs(delta, chiKerr, 0.0, 500.0, Overtones[k]);
+      end = clock();
+      Seconds += double(end-start)/double(CLOCKS_PER_SEC);
+    }
+    cout << setprecision(8) << Overtones[k] << " overtone(s): " << Seconds/NAttachments << " seconds per attachment to "
+         << W.NModes() << " modes; max phase step after the peak " << MaxPhaseStep(W)
+         << "; final |h22| " << W.Mag(W.FindModeIndex(2,2), W.NTimes()-1) << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "OrbitalPhasing_T2.hpp"
+#include "OrbitalPhasing_T3.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Time the closed-form TaylorT2 and TaylorT3 approximants at large
+/// NPoints, and check that TaylorT2 evaluated at its own times
+/// recovers v and Phi.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.05, v0=0.1;
+  vector<double> t, v, Phi;
+  clock_t start, end;
+
+  const int NPoints = 1000000;
+  start = clock();
+  WU::TaylorT2(delta, chis, chia, v0, t, v, Phi, NPoints);
+  end = clock();
+  cout << setprecision(16) << "TaylorT2: " << NPoints/(double(end-start)/double(CLOCKS_PER_SEC)) << " points/sec; Phi=" << Phi.back() << endl;
+
+  /// Invert at the times TaylorT2 returned, stopping short of vMax where dt/dv vanishes
+  const unsigned int NInvert = NPoints*9/10;
+  const vector<double> tInvert(t.begin(), t.begin()+NInvert);
+  vector<double> vInvert, PhiInvert;
+  start = clock();
+  WU::TaylorT2(delta, chis, chia, tInvert, vInvert, PhiInvert);
+  end = clock();
+  double vErr=0.0, PhiErr=0.0;
+  for(unsigned int i=0; i<NInvert; ++i) {
+    vErr = max(vErr, fabs(vInvert[i]-v[i]));
+    PhiErr = max(PhiErr, fabs(PhiInvert[i]-Phi[i]));
+  }
+  cout << "TaylorT2 at given times: " << NInvert/(double(end-start)/double(CLOCKS_PER_SEC)) << " points/sec; "
+       << "max v error " << vErr << "; max Phi error " << PhiErr << endl;
+
+  start = clock();
+  WU::TaylorT3(delta, chis, chia, v0, t, v, Phi, NPoints);
+  end = clock();
+  cout << "TaylorT3: " << NPoints/(double(end-start)/double(CLOCKS_PER_SEC)) << " points/sec; Phi=" << Phi.back() << endl;
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <fstream>
+#include <ctime>
+#include <cstring>
+
+#include "Waveform.hpp"
+#include "FloatCompression.hpp"
+using namespace std;
+using namespace WaveformObjects;
+namespace WU = WaveformUtilities;
+
+double FileSize(const string& FileName) {
+  ifstream ifs(FileName.c_str(), ifstream::in | ifstream::binary);
+  ifs.seekg(0, ios_base::end);
+  return double(ifs.tellg());
+}
+
+/// Whether every element of a and b has the same bits
+bool Identical(const vector<double>& a, const vector<double>& b) {
+  return a.size()==b.size() && (a.size()==0 || memcmp(&a[0], &b[0], a.size()*sizeof(double))==0);
+}
+
+/// Write a PN waveform with all modes up to l=4 losslessly, read it
+/// back, and check that it is identical and that the file is in
+/// little-endian order; time the decoding; then
+/// write it within tolerances, and check the errors.
+int main() {
+  const double MagTol = 1.e-5, ArgTol = 1.e-5;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  WU::Matrix<int> LM(21, 2);
+  for(int l=2, k=0; l<=4; ++l) {
+    for(int m=-l; m<=l; ++m, ++k) {
+      LM[k][0] = l;
+      LM[k][1] = m;
+    }
+  }
+  const Waveform W("TaylorT4", 0.2, 0.0, 0.0, 0.05, LM);
+  const double RawBytes = 8.0*W.NTimes()*(1+2*W.NModes());
+  cout << W.NTimes() << " times and " << W.NModes() << " modes; " << RawBytes/1.e6 << " MB of raw data" << endl;
+
+  Output("TestCompression.dat", W);
+  cout << "ASCII output:      " << FileSize("TestCompression.dat")/1.e6 << " MB" << endl;
+
+  // Lossless
+  W.OutputToCompressedFormat("TestCompression.twc");
+  const double LosslessBytes = FileSize("TestCompression.twc");
+  cout << "Lossless:          " << LosslessBytes/1.e6 << " MB (" << RawBytes/LosslessBytes << "x smaller than raw)" << endl;
+  const Waveform WLossless("TestCompression.twc", "Compressed");
+  bool Same = Identical(W.T(), WLossless.T()) && W.NModes()==WLossless.NModes()
+    && W.TypeIndex()==WLossless.TypeIndex() && W.TimeScale()==WLossless.TimeScale();
+  for(unsigned int mode=0; Same && mode<W.NModes(); ++mode) {
+    Same = W.L(mode)==WLossless.L(mode) && W.M(mode)==WLossless.M(mode)
+      && Identical(W.Mag(mode), WLossless.Mag(mode)) && Identical(W.Arg(mode), WLossless.Arg(mode));
+  }
+  cout << "Data read back " << (Same ? "is identical" : "DIFFERS") << endl;
+
+  // The format version follows the magic string, least significant byte first
+  char Header[12];
+  ifstream Raw("TestCompression.twc", ifstream::in | ifstream::binary);
+  Raw.read(Header, sizeof(Header));
+  const bool LittleEndian = Raw && Header[8]==1 && Header[9]==0 && Header[10]==0 && Header[11]==0;
+  cout << "Header " << (LittleEndian ? "is little-endian" : "is NOT little-endian") << endl;
+
+  // Decoding speed, without the disk
+  string Bytes;
+  for(unsigned int mode=0; mode<W.NModes(); ++mode) {
+    WU::CompressSeries(W.Mag(mode), Bytes);
+    WU::CompressSeries(W.Arg(mode), Bytes);
+  }
+  vector<double> x;
+  unsigned int NRepeats = 0;
+  start = clock();
+  do {
+    const char* p = Bytes.data();
+    while(p!=Bytes.data()+Bytes.size()) {
+      if(!WU::DecompressSeries(p, Bytes.data()+Bytes.size(), x)) { cout << "Decoding FAILED" << endl; return 1; }
+    }
+    ++NRepeats;
+    end = clock();
+  } while(end-start < CLOCKS_PER_SEC/2);
+  const double ModeBytes = 16.0*W.NTimes()*W.NModes();
+  cout << "Lossless decoding: " << NRepeats*ModeBytes/1.e6/(double(end-start)/double(CLOCKS_PER_SEC)) << " MB/s of doubles" << endl;
+
+  // Within tolerances
+  W.OutputToCompressedFormat("TestCompression.twc", MagTol, ArgTol);
+  const double BoundedBytes = FileSize("TestCompression.twc");
+  cout << "Within tolerances: " << BoundedBytes/1.e6 << " MB (" << RawBytes/BoundedBytes << "x smaller than raw)" << endl;
+  const Waveform WBounded("TestCompression.twc", "Compressed");
+  double MagErr = 0.0, ArgErr = 0.0;
+  for(unsigned int mode=0; mode<W.NModes(); ++mode) {
+    for(unsigned int i=0; i<W.NTimes(); ++i) {
+      MagErr = max(MagErr, fabs(WBounded.Mag(mode,i)-W.Mag(mode,i))/W.Mag(mode,i));
+      ArgErr = max(ArgErr, fabs(WBounded.Arg(mode,i)-W.Arg(mode,i)));
+    }
+  }
+  cout << "Largest errors: " << MagErr << " (Mag, relative), " << ArgErr << " (Arg); time "
+       << (Identical(W.T(), WBounded.T()) ? "is identical" : "DIFFERS") << endl;
+
+  Bytes.clear();
+  for(unsigned int mode=0; mode<W.NModes(); ++mode) {
+    WU::CompressSeries(W.Mag(mode), Bytes, MagTol, true);
+    WU::CompressSeries(W.Arg(mode), Bytes, ArgTol, false);
+  }
+  NRepeats = 0;
+  start = clock();
+  do {
+    const char* p = Bytes.data();
+    while(p!=Bytes.data()+Bytes.size()) {
+      if(!WU::DecompressSeries(p, Bytes.data()+Bytes.size(), x)) { cout << "Decoding FAILED" << endl; return 1; }
+    }
+    ++NRepeats;
+    end = clock();
+  } while(end-start < CLOCKS_PER_SEC/2);
+  cout << "Bounded decoding:  " << NRepeats*ModeBytes/1.e6/(double(end-start)/double(CLOCKS_PER_SEC)) << " MB/s of doubles" << endl;
+
+  // A truncated series is rejected
+  const char* p = Bytes.data();
+  WU::DecompressSeries(p, Bytes.data()+Bytes.size(), x);
+  const char* Truncated = Bytes.data() + (p-Bytes.data())/2;
+  p = Bytes.data();
+  cout << "Truncated series " << (WU::DecompressSeries(p, Truncated, x) ? "ACCEPTED" : "rejected") << endl;
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "ODEIntegrator.hpp"
+#include "DenseTrajectory.hpp"
+#include "Interpolate.hpp"
+#include "VectorFunctions.hpp"
+#include "OrbitalPhasing_T4.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+typedef int NRerror;
+
+class HarmonicOscillator {
+public:
+  HarmonicOscillator() { }
+  void operator() (const double x, const std::vector<double>& y, std::vector<double>& dydx) {
+    dydx[0]=y[1];
+    dydx[1]=-y[0];
+  }
+};
+
+template <class Stepper>
+void OscillatorTest(const string& Name) {
+  const double atol=0.0, rtol=1.0e-10, h1=0.1, hmin=0.0, x1=0.0, x2=50.0;
+  vector<double> ystart(2);
+  ystart[0] = 1.0;
+  ystart[1] = 0.0;
+  HarmonicOscillator d;
+  WU::DenseTrajectory Trajectory;
+  WU::Output out(1);
+  out.trajectory = &Trajectory;
+  WU::Odeint<Stepper> ode(ystart, x1, x2, atol, rtol, h1, hmin, out, d, true);
+  ode.integrate();
+  const vector<double> t = Trajectory.UniformTime(100001);
+  const vector<double> y = Trajectory.Evaluate(0, t);
+  const vector<double> dydt = Trajectory.EvaluateDerivative(0, t);
+  double MaxErr=0.0, MaxErrDeriv=0.0;
+  for(unsigned int i=0; i<t.size(); ++i) {
+    MaxErr = max(MaxErr, fabs(y[i]-cos(t[i])));
+    MaxErrDeriv = max(MaxErrDeriv, fabs(dydt[i]+sin(t[i])));
+  }
+  cout << Name << ": " << Trajectory.NSteps() << " steps on [" << Trajectory.TMin() << "," << Trajectory.TMax() << "]"
+       << "\n\tmax |y-cos(t)| = " << MaxErr << "\tmax |dydt+sin(t)| = " << MaxErrDeriv << endl;
+}
+
+int main() {
+  cout << setprecision(6);
+
+  OscillatorTest<WU::StepperDopr853<HarmonicOscillator> >("Dopr853");
+  OscillatorTest<WU::StepperBS<HarmonicOscillator> >("BS");
+
+  /// Compare the dense output of TaylorT4 to a spline through its
+  /// samples, using samples at a denser output as truth
+  const double delta=0.2, chis=0.1, chia=0.05, v0=0.3;
+  vector<double> t, v, Phi, tDense, vDense, PhiDense;
+  WU::DenseTrajectory Trajectory;
+  WU::TaylorT4(delta, chis, chia, v0, t, v, Phi, 2, true, &Trajectory);
+  WU::TaylorT4(delta, chis, chia, v0, tDense, vDense, PhiDense, 500, true);
+  cout << "TaylorT4: " << Trajectory.NSteps() << " steps on [" << Trajectory.TMin() << "," << Trajectory.TMax() << "]"
+       << "; sparse output has " << t.size() << " points" << endl;
+
+  clock_t start, end;
+  start = clock();
+  const vector<double> PhiTrajectory = Trajectory.Evaluate(1, tDense);
+  end = clock();
+  const double TrajectoryTime = double(end-start)/double(CLOCKS_PER_SEC);
+  start = clock();
+  const vector<double> PhiSpline = WU::Interpolate(t, Phi, tDense);
+  end = clock();
+  const double SplineTime = double(end-start)/double(CLOCKS_PER_SEC);
+  double MaxErrTrajectory=0.0, MaxErrSpline=0.0;
+  for(unsigned int i=0; i<tDense.size(); ++i) {
+    MaxErrTrajectory = max(MaxErrTrajectory, fabs(PhiTrajectory[i]-PhiDense[i]));
+    MaxErrSpline = max(MaxErrSpline, fabs(PhiSpline[i]-PhiDense[i]));
+  }
+  cout << "\tmax Phi error with DenseTrajectory: " << MaxErrTrajectory << " (" << TrajectoryTime << " seconds for " << tDense.size() << " points)"
+       << "\n\tmax Phi error with spline:          " << MaxErrSpline << " (" << SplineTime << " seconds)" << endl;
+
+  const vector<double> tN = Trajectory.NSamplesPerCycle22(16);
+  cout << "\tNSamplesPerCycle22(16) gives " << tN.size() << " times" << endl;
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include "NumericalRecipes.hpp"
+
+#include <unistd.h>
+
+#include <iomanip>
+#include <ctime>
+#include <cstdio>
+
+#include "OrbitalPhasing_EOB.hpp"
+#include "EOBInitialDataCache.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Time the construction of EOB initial data with and without a
+/// cache of previously reduced data, and check that the cached data
+/// reproduce the same inspiral.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.0, v0=0.15;
+  vector<double> t, v, Phi, tCached, vCached, PhiCached;
+  WU::EOBInitialDataCache Cache;
+  clock_t start, end;
+
+  start = clock();
+  WU::EOB(delta, chis, chia, v0, t, v, Phi, 40, true, 1e-9, NULL, &Cache);
+  end = clock();
+  cout << "\nFirst call: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; cache has " << Cache.size() << " entries" << endl;
+
+  start = clock();
+  WU::EOB(delta, chis, chia, v0, tCached, vCached, PhiCached, 40, true, 1e-9, NULL, &Cache);
+  end = clock();
+  cout << "\nCached call: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+  cout << setprecision(14) << "Phi at end: " << Phi.back() << " and " << PhiCached.back() << endl;
+
+  /// Round trip through a temporary file
+  char FileName[] = "/tmp/EOBInitialDataCacheXXXXXX";
+  const int fd = mkstemp(FileName);
+  if(fd<0) { cerr << "Couldn't create a temporary file" << endl; return 1; }
+  close(fd);
+  Cache.Write(FileName);
+  WU::EOBInitialDataCache Cache2;
+  Cache2.Read(FileName);
+  remove(FileName);
+  double prstar=0.0, pPhi=0.0;
+  const bool Found = Cache2.Find(delta, chis, chia, v0, prstar, pPhi);
+  cout << setprecision(14) << "Reread cache has " << Cache2.size() << " entries; found=" << Found
+       << " prstar=" << prstar << " pPhi=" << pPhi << endl;
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "OrbitalPhasing_EOB.hpp"
+#include "EOBModel.hpp"
+#include "Flux.hpp"
+using namespace std;
+using WaveformUtilities::EOBParameters;
+
+typedef WaveformUtilities::EOBMetricWithSpin Met;
+typedef WaveformUtilities::EOBHamiltonianWithSpin Ham;
+typedef WaveformUtilities::Flux_Pade44LogFac Flu;
+typedef WaveformUtilities::Torque_KFPhi<Flu> Tor;
+typedef WaveformUtilities::EOBHamiltonEquations<Met, Ham, Tor> HamEqn;
+
+/// Wrappers exposing only the const Evaluate members, so that EOB()
+/// fails to compile if it uses the caching operator() interfaces or
+/// reads the cached values.
+struct MetricEvaluateOnly {
+  const Met& g;
+  MetricEvaluateOnly(const Met& ig) : g(ig) { }
+  void Evaluate(const double r, WaveformUtilities::EOBMetricValues& m) const { g.Evaluate(r, m); }
+};
+struct HamiltonianEvaluateOnly {
+  const Ham& H;
+  HamiltonianEvaluateOnly(const Ham& iH) : H(iH) { }
+  void Evaluate(const double prstar, const double pPhi, const WaveformUtilities::EOBMetricValues& m,
+                WaveformUtilities::EOBHamiltonianValues& h) const { H.Evaluate(prstar, pPhi, m, h); }
+  void Evaluate(const double r, const double prstar, const double pPhi,
+                WaveformUtilities::EOBHamiltonianValues& h) const { H.Evaluate(r, prstar, pPhi, h); }
+};
+
+/// Time evaluations of the right-hand side of the EOB equations,
+/// comparing the chain of caching functors (which store their results
+/// in mutable members) to the stateless Evaluate path used by the
+/// integrator.
+int main() {
+  const double delta=0.2, chis=0.3, chia=0.1;
+  const Met g(EOBParameters(delta, chis, chia));
+  const Ham H(EOBParameters(delta, chis, chia), g);
+  const Flu F(delta, chis, chia);
+  const Tor T(delta, chis, chia, F);
+  const HamEqn d(g, H, T);
+
+  const unsigned int N = 2000000;
+  vector<double> y(4, 0.0), dydt(4);
+  double SumFunctors=0.0, SumEvaluate=0.0, MaxDiff=0.0;
+  clock_t start, end;
+
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    const double r=3.0+20.0*i/N, prstar=-0.01*(1+1e-7*i), pPhi=4.0+1e-7*i;
+    g(r);
+    H(r, prstar, pPhi);
+    T(H.v, r, prstar, pPhi);
+    SumFunctors += g.drdrstar*H.dHdprstar + H.dHdpPhi + (-g.drdrstar*H.dHdr + T.Torque*prstar/pPhi) + T.Torque;
+  }
+  end = clock();
+  const double TimeFunctors = double(end-start)/double(CLOCKS_PER_SEC);
+
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    y[0] = 3.0+20.0*i/N;
+    y[2] = -0.01*(1+1e-7*i);
+    y[3] = 4.0+1e-7*i;
+    d(0.0, y, dydt);
+    SumEvaluate += dydt[0] + dydt[1] + dydt[2] + dydt[3];
+  }
+  end = clock();
+  const double TimeEvaluate = double(end-start)/double(CLOCKS_PER_SEC);
+
+  /// Check that the two paths agree point by point on a coarser grid
+  for(unsigned int i=0; i<N; i+=1000) {
+    y[0] = 3.0+20.0*i/N;
+    y[2] = -0.01*(1+1e-7*i);
+    y[3] = 4.0+1e-7*i;
+    d(0.0, y, dydt);
+    g(y[0]);
+    H(y[0], y[2], y[3]);
+    T(H.v, y[0], y[2], y[3]);
+    MaxDiff = max(MaxDiff, fabs(dydt[0]-g.drdrstar*H.dHdprstar));
+    MaxDiff = max(MaxDiff, fabs(dydt[1]-H.dHdpPhi));
+    MaxDiff = max(MaxDiff, fabs(dydt[2]-(-g.drdrstar*H.dHdr + T.Torque*y[2]/y[3])));
+    MaxDiff = max(MaxDiff, fabs(dydt[3]-T.Torque));
+  }
+
+  /// Run a whole EOB evolution through the wrappers, and check that
+  /// the caches of the shared objects are untouched
+  {
+    g(10.0);
+    H(10.0, -0.001, 4.0);
+    const double CachedDt=g.Dt, Cacheddrdrstar=g.drdrstar, CachedH=H.H, Cachedv=H.v;
+    vector<double> t, v, Phi, r, prstar, pPhi;
+    WaveformUtilities::EOB(MetricEvaluateOnly(g), HamiltonianEvaluateOnly(H), T, delta, chis, chia, 0.15,
+                           t, v, Phi, r, prstar, pPhi);
+    const bool Untouched = (g.Dt==CachedDt && g.drdrstar==Cacheddrdrstar && H.H==CachedH && H.v==Cachedv);
+    cout << "EOB through Evaluate only: " << t.size() << " steps; cached values "
+         << (Untouched ? "untouched" : "MODIFIED") << endl;
+  }
+
+  cout << setprecision(16)
+       << "Functors: " << N/TimeFunctors << " RHS calls/sec (sum=" << SumFunctors << ")\n"
+       << "Evaluate: " << N/TimeEvaluate << " RHS calls/sec (sum=" << SumEvaluate << ")\n"
+       << "Max difference: " << MaxDiff << endl;
+
+  return 0;
+}
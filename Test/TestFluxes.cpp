@@ -0,0 +1,68 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Flux.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Evaluate a flux at each point separately and as a batch, and
+/// report calls per second for both, along with the largest relative
+/// difference between them.
+template <class Flux>
+void TimeFlux(const string& Name, const Flux& F, const vector<double>& v, const unsigned int NRepeats) {
+  const vector<double> Empty;
+  vector<double> Scalar(v.size()), Batch;
+  clock_t start, end;
+
+  start = clock();
+  for(unsigned int k=0; k<NRepeats; ++k) {
+    for(unsigned int i=0; i<v.size(); ++i) {
+      Scalar[i] = F.Evaluate(v[i]);
+    }
+  }
+  end = clock();
+  const double TimeScalar = double(end-start)/double(CLOCKS_PER_SEC);
+
+  start = clock();
+  for(unsigned int k=0; k<NRepeats; ++k) {
+    F.Evaluate(v, Empty, Empty, Empty, Batch);
+  }
+  end = clock();
+  const double TimeBatch = double(end-start)/double(CLOCKS_PER_SEC);
+
+  double MaxDiff = 0.0;
+  for(unsigned int i=0; i<v.size(); ++i) {
+    MaxDiff = max(MaxDiff, fabs(Batch[i]-Scalar[i])/fabs(Scalar[i]));
+  }
+  const double NCalls = double(NRepeats)*v.size();
+  cout << setw(28) << left << Name << right << setw(14) << NCalls/TimeScalar << " (scalar)  "
+       << setw(14) << NCalls/TimeBatch << " (batch) calls/sec;  max rel. diff. " << MaxDiff << endl;
+}
+
+int main() {
+  const double delta=0.2, chis=0.3, chia=-0.1;
+  const unsigned int N=100000, NRepeats=20;
+  vector<double> v(N);
+  for(unsigned int i=0; i<N; ++i) {
+    v[i] = 0.05 + 0.35*i/double(N);
+  }
+  cout << setprecision(4);
+
+  const WU::Flux_Taylor Taylor(delta, chis, chia);
+  const WU::Flux_Taylor8 Taylor8(delta, chis, chia);
+  const WU::Flux_Pade44LogConst Pade44LogConst(delta, chis, chia);
+  const WU::Flux_Pade44LogFac Pade44LogFac(delta, chis, chia);
+  const WU::Flux_SumAmplitudes SumAmplitudes(delta, chis, chia);
+  const WU::Torque_KFPhi<WU::Flux_Pade44LogFac> Torque(delta, chis, chia, Pade44LogFac);
+
+  TimeFlux("Flux_Taylor", Taylor, v, NRepeats);
+  TimeFlux("Flux_Taylor8", Taylor8, v, NRepeats);
+  TimeFlux("Flux_Pade44LogConst", Pade44LogConst, v, NRepeats);
+  TimeFlux("Flux_Pade44LogFac", Pade44LogFac, v, NRepeats);
+  TimeFlux("Flux_SumAmplitudes", SumAmplitudes, v, NRepeats);
+  TimeFlux("Torque_KFPhi<Pade44LogFac>", Torque, v, NRepeats);
+
+  return 0;
+}
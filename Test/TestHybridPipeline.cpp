@@ -0,0 +1,63 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "HybridPipeline.hpp"
+using namespace std;
+using WaveformObjects::Waveform;
+using WaveformObjects::HybridPipeline;
+
+double MaxDifference(const Waveform& a, const Waveform& b) {
+  if(a.NTimes()!=b.NTimes() || a.NModes()!=b.NModes()) { return 1e300; }
+  double Diff = 0.0;
+  for(unsigned int i=0; i<a.NTimes(); ++i) {
+    Diff = max(Diff, fabs(a.T(i)-b.T(i)));
+    for(unsigned int m=0; m<a.NModes(); ++m) {
+      Diff = max(Diff, fabs(a.Mag(m,i)-b.Mag(m,i)));
+      Diff = max(Diff, fabs(a.Arg(m,i)-b.Arg(m,i)));
+    }
+  }
+  return Diff;
+}
+
+/// Hybridize several PN waveforms with one stand-in for an NR
+/// waveform (a short TaylorT4 waveform), both with HybridizeWith_F and
+/// with a HybridPipeline, and compare the results and timings.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.0, v0=0.1;
+  const double omega=0.04, DeltaT=200.0;
+  clock_t start, end;
+
+  const Waveform NR("TaylorT4", delta, chis, chia, 0.2);
+  const string Approximants[] = { "TaylorT1", "TaylorT4", "TaylorT4", "TaylorT1" };
+  const double v0s[] = { v0, v0, 1.1*v0, 1.2*v0 };
+  vector<Waveform> PN(4);
+  for(unsigned int i=0; i<4; ++i) {
+    PN[i] = Waveform(Approximants[i], delta, chis, chia, v0s[i]);
+  }
+
+  vector<Waveform> Old(4);
+  start = clock();
+  for(unsigned int i=0; i<4; ++i) {
+    Old[i] = PN[i].HybridizeWith_F(NR, omega, -1e300, 1e300, DeltaT);
+  }
+  end = clock();
+  cout << "HybridizeWith_F: " << double(end-start)/double(CLOCKS_PER_SEC)/4 << " seconds per variant" << endl;
+
+  start = clock();
+  const HybridPipeline Pipeline(NR, omega, -1e300, 1e300, DeltaT);
+  end = clock();
+  cout << "HybridPipeline setup: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+  Waveform Hybrid;
+  for(unsigned int i=0; i<4; ++i) {
+    start = clock();
+    Pipeline.Hybridize(PN[i], Hybrid);
+    end = clock();
+    cout << Approximants[i] << " v0=" << v0s[i] << ": " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; "
+         << Hybrid.NTimes() << " times; max difference " << MaxDifference(Old[i], Hybrid) << endl;
+  }
+
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <cmath>
 #include "VectorFunctions.hpp"
 using namespace std;
 namespace WU = WaveformUtilities;
@@ -116,5 +117,33 @@ int main() {
   }
   ofsuac.close();
 
+  // The intersection of several sequences at once, which for two
+  // sequences should be the same as above
+  {
+    vector<vector<double> > Times(2);
+    Times[0] = xb;
+    Times[1] = xc;
+    cerr << "Intersection(Times) "
+         << (WU::Intersection(Times, MinStep, MinTime)==WU::Intersection(xb, xc, MinStep, MinTime) ? "agrees" : "DISAGREES")
+         << " with Intersection(xb, xc)" << endl;
+  }
+  ofstream ofsubcd("TestIntersections_ibcd.dat", ofstream::out);
+  ofsubcd << "# [1] = Index\n"
+          << "# [2] = Time\n"
+          << setprecision(8) << flush;
+  {
+    vector<vector<double> > Times(3);
+    Times[0] = xb;
+    Times[1] = xc;
+    for(unsigned int i=0; i<2*Nc; ++i) {
+      Times[2].push_back(xcI + i*dxc/2.0 + 0.05*sin(double(i)));
+    }
+    T = WU::Intersection(Times, MinStep, MinTime);
+  }
+  for(unsigned int i=0; i<T.size(); ++i) {
+    ofsubcd << i << " " << T[i] << endl;
+  }
+  ofsubcd.close();
+
   return 0;
 }
@@ -0,0 +1,92 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "MinimalGrid.hpp"
+using namespace std;
+using namespace WaveformObjects;
+namespace WU = WaveformUtilities;
+
+/// The largest errors of linear interpolation of W's data between the
+/// kept times, relative in the magnitude and absolute in the phase
+void MaxErrors(const Waveform& W, const vector<unsigned int>& Kept, double& MagErr, double& ArgErr) {
+  MagErr = 0.0;
+  ArgErr = 0.0;
+  for(unsigned int k=0; k+1<Kept.size(); ++k) {
+    const unsigned int I0 = Kept[k], I1 = Kept[k+1];
+    for(unsigned int i=I0+1; i<I1; ++i) {
+      const double s = (W.T(i)-W.T(I0))/(W.T(I1)-W.T(I0));
+      for(unsigned int mode=0; mode<W.NModes(); ++mode) {
+        const double Mag = W.Mag(mode,I0) + s*(W.Mag(mode,I1)-W.Mag(mode,I0));
+        const double Arg = W.Arg(mode,I0) + s*(W.Arg(mode,I1)-W.Arg(mode,I0));
+        MagErr = max(MagErr, fabs(1-Mag/W.Mag(mode,i)));
+        ArgErr = max(ArgErr, fabs(Arg-W.Arg(mode,i)));
+      }
+    }
+  }
+}
+
+/// Compress a PN waveform with all modes up to l=4, both all at once
+/// and while it is being "generated" in chunks, and check that linear
+/// interpolation of every mode between the kept times is within the
+/// tolerances.
+int main() {
+  const double MagTol = 1.e-5, ArgTol = 1.e-5;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  WU::Matrix<int> LM(21, 2);
+  for(int l=2, k=0; l<=4; ++l) {
+    for(int m=-l; m<=l; ++m, ++k) {
+      LM[k][0] = l;
+      LM[k][1] = m;
+    }
+  }
+  const Waveform W("TaylorT4", 0.2, 0.0, 0.0, 0.05, LM);
+  cout << W.NTimes() << " times and " << W.NModes() << " modes" << endl;
+
+  // All at once, through the Waveform member
+  Waveform WMinimal(W);
+  start = clock();
+  WMinimal.MinimalGrid(MagTol, ArgTol);
+  end = clock();
+  cout << "MinimalGrid: " << WMinimal.NTimes() << " times kept in " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+
+  // In chunks of 1000 times, taking the indices as they are found
+  WU::MinimalGridCompressor Compressor(W.NModes(), MagTol, ArgTol);
+  vector<double> Mag(W.NModes()), Arg(W.NModes());
+  vector<unsigned int> Kept, NewlyKept;
+  unsigned int MaxNewlyKept = 0;
+  start = clock();
+  for(unsigned int i=0; i<W.NTimes(); ++i) {
+    for(unsigned int mode=0; mode<W.NModes(); ++mode) {
+      Mag[mode] = W.Mag(mode, i);
+      Arg[mode] = W.Arg(mode, i);
+    }
+    Compressor.Add(W.T(i), Mag, Arg);
+    if(i%1000==999) {
+      Compressor.TakeIndices(NewlyKept);
+      MaxNewlyKept = max(MaxNewlyKept, (unsigned int)(NewlyKept.size()));
+      Kept.insert(Kept.end(), NewlyKept.begin(), NewlyKept.end());
+    }
+  }
+  Compressor.Finish();
+  Compressor.TakeIndices(NewlyKept);
+  Kept.insert(Kept.end(), NewlyKept.begin(), NewlyKept.end());
+  end = clock();
+  cout << "Streaming: " << Kept.size() << " times kept in " << double(end-start)/double(CLOCKS_PER_SEC)
+       << " seconds; at most " << MaxNewlyKept << " per chunk" << endl;
+
+  bool Same = (Kept.size()==WMinimal.NTimes());
+  for(unsigned int i=0; Same && i<Kept.size(); ++i) { Same = (W.T(Kept[i])==WMinimal.T(i)); }
+  cout << "Kept times " << (Same ? "agree" : "DISAGREE") << "; first " << Kept[0] << ", last " << Kept.back()
+       << " of " << W.NTimes() << endl;
+
+  double MagErr, ArgErr;
+  MaxErrors(W, Kept, MagErr, ArgErr);
+  cout << "Largest interpolation errors: " << MagErr << " (Mag, relative), " << ArgErr << " (Arg)" << endl;
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "Interpolate.hpp"
+#include "VectorFunctions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+using WaveformObjects::Waveform;
+
+/// Interpolate every mode of a TaylorT4 waveform to a uniform time grid,
+/// once with a separate SplineInterpolator for each mode and once with
+/// Waveform::Interpolate, which shares one MultiSplineInterpolator
+/// between the modes.  Report the times and the largest difference.
+int main() {
+  const Waveform W("TaylorT4", 0.2, 0.1, 0.0, 0.1);
+  clock_t start, end;
+
+  vector<double> NewTime(W.NTimes());
+  for(unsigned int i=0; i<NewTime.size(); ++i) {
+    NewTime[i] = W.T(0) + (W.T().back()-W.T(0))*double(i)/double(NewTime.size()-1);
+  }
+  cout << W.NModes() << " modes; " << W.NTimes() << " times -> " << NewTime.size() << " times" << endl;
+
+  WU::Matrix<double> Mag(W.NModes(), NewTime.size()), Arg(W.NModes(), NewTime.size());
+  start = clock();
+  for(unsigned int i=0; i<W.NModes(); ++i) {
+    Mag[i] = WU::Interpolate(W.T(), W.Mag(i), NewTime);
+    Arg[i] = WU::Interpolate(W.T(), W.Arg(i), NewTime);
+  }
+  end = clock();
+  const double TimeSeparate = double(end-start)/double(CLOCKS_PER_SEC);
+
+  Waveform V(W);
+  start = clock();
+  V.Interpolate(NewTime);
+  end = clock();
+  const double TimeShared = double(end-start)/double(CLOCKS_PER_SEC);
+
+  double MaxDiff = 0.0;
+  for(unsigned int i=0; i<W.NModes(); ++i) {
+    for(unsigned int j=0; j<NewTime.size(); ++j) {
+      MaxDiff = max(MaxDiff, fabs(V.Mag(i,j)-Mag[i][j])/max(1.0, fabs(Mag[i][j])));
+      MaxDiff = max(MaxDiff, fabs(V.Arg(i,j)-Arg[i][j])/max(1.0, fabs(Arg[i][j])));
+    }
+  }
+  cout << "Separate splines: " << TimeSeparate << " seconds\n"
+       << "Shared spline:    " << TimeShared << " seconds\n"
+       << "Largest relative difference: " << MaxDiff << endl;
+
+  /// Extrapolation beyond the data, and unsorted times
+  vector<double> Outside(3);
+  Outside[0] = W.T(0)-100.0; Outside[1] = W.T().back()+100.0; Outside[2] = 0.5*(W.T(0)+W.T().back());
+  V = W;
+  V.Interpolate(Outside, 0.0);
+  cout << "Extrapolated to " << Outside << ":\n\tMag(0)=" << V.Mag(0) << "\n\tArg(0)=" << V.Arg(0)
+       << "\n\tExpected Arg(0)=" << W.Arg(0).back() << " " << W.Arg(0).back() << " " << WU::Interpolate(W.T(), W.Arg(0), Outside[2]) << endl;
+
+  return 0;
+}
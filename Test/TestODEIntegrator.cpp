@@ -25,6 +25,9 @@ public:
   double amplitude(const double t) const {
     return Initialy*exp(-DampingCoefficient*t);
   }
+  double Position(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const {
+    return y[0];
+  }
 };
 
 int main() {
@@ -99,5 +102,20 @@ int main() {
 
   cout << "t1==t2 = " << (t1==t2) << "\ttrue=" << true << endl;
 
+  {
+  /// Stop at the first zero of the position, which should be the last point saved
+  const int nvar=2;
+  const double atol=0.0, rtol=1.0e-13, h1=0.01, hmin=0.0, x1=0.0, x2=2000.0;
+  std::vector<double> ystart(nvar);
+  ystart[0]=2.0;
+  ystart[1]=0.0;
+  WU::Output out(20);
+  DampedHarmonicOscillator d(1, 1, 0.05, ystart[0], ystart[1]);
+  WU::Odeint< WU::StepperDopr853<DampedHarmonicOscillator> > ode(ystart,x1,x2,atol,rtol,h1,hmin,out,d,true,&DampedHarmonicOscillator::Position);
+  ode.integrate();
+  const double T = out.xsave[out.count-1];
+  cout << setprecision(16) << "Event at t=" << T << "\ty=" << out.ysave[0][out.count-1] << "\tExacty=" << d.y(T) << endl;
+  }
+
   return 0;
 }
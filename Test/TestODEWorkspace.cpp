@@ -0,0 +1,63 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+#include <cstdlib>
+#include <new>
+
+#include "ODEIntegrator.hpp"
+#include "OrbitalPhasing_T4.hpp"
+#include "OrbitalPhasing_EOB.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Count the heap allocations
+static unsigned long NAllocations = 0;
+void* operator new(size_t n) throw(std::bad_alloc) {
+  ++NAllocations;
+  void* p = malloc(n>0 ? n : 1);
+  if(p==0) { throw std::bad_alloc(); }
+  return p;
+}
+void operator delete(void* p) throw() { free(p); }
+
+/// Time repeated TaylorT4 integrations with and without a workspace,
+/// count the allocations made by one integration once the workspace
+/// has grown, and check that an EOB integration is unchanged by it.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.05, v0=0.08;
+  const unsigned int N = 20;
+  clock_t start, end;
+
+  vector<double> t, v, Phi, tW, vW, PhiW;
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    WU::TaylorT4(delta, chis, chia, v0, t, v, Phi);
+  }
+  end = clock();
+  cout << setprecision(6) << "TaylorT4 without workspace: " << double(end-start)/double(CLOCKS_PER_SEC)/N << " seconds per integration" << endl;
+
+  WU::ODEWorkspace Workspace;
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    WU::TaylorT4(delta, chis, chia, v0, tW, vW, PhiW, 500, true, 0, &Workspace);
+  }
+  end = clock();
+  cout << "TaylorT4 with workspace: " << double(end-start)/double(CLOCKS_PER_SEC)/N << " seconds per integration" << endl;
+  cout << "\t" << t.size() << " steps; results " << (t==tW && v==vW && Phi==PhiW ? "match" : "DIFFER") << endl;
+
+  NAllocations = 0;
+  WU::TaylorT4(delta, chis, chia, v0, tW, vW, PhiW, 500, true, 0, &Workspace);
+  const unsigned long NWith = NAllocations;
+  NAllocations = 0;
+  WU::TaylorT4(delta, chis, chia, v0, t, v, Phi);
+  const unsigned long NWithout = NAllocations;
+  cout << "Allocations per integration: " << NWith << " with workspace; " << NWithout << " without" << endl;
+
+  vector<double> r, prstar, pPhi, rW, prstarW, pPhiW;
+  WU::EOB(delta, chis, chia, 0.1, t, v, Phi);
+  WU::EOB(delta, chis, chia, 0.1, tW, vW, PhiW, 40, true, 1e-9, 0, 0, &Workspace);
+  cout << "\nEOB results with workspace " << (t==tW && v==vW && Phi==PhiW ? "match" : "DIFFER") << endl;
+
+  return 0;
+}
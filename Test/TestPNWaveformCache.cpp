@@ -0,0 +1,81 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Waveform.hpp"
+#include "PNWaveformCache.hpp"
+using namespace std;
+using WaveformObjects::Waveform;
+using WaveformObjects::PNWaveformCache;
+
+double MaxDifference(const Waveform& a, const Waveform& b) {
+  if(a.NTimes()!=b.NTimes() || a.NModes()!=b.NModes()) { return 1e300; }
+  double Diff = 0.0;
+  for(unsigned int i=0; i<a.NTimes(); ++i) {
+    Diff = max(Diff, fabs(a.T(i)-b.T(i)));
+    for(unsigned int m=0; m<a.NModes(); ++m) {
+      Diff = max(Diff, fabs(a.Mag(m,i)-b.Mag(m,i)));
+      Diff = max(Diff, fabs(a.Arg(m,i)-b.Arg(m,i)));
+    }
+  }
+  return Diff;
+}
+
+/// Time the PN constructors with the cache disabled, then filling the
+/// disk store, then reading from disk, then from the memo.
+int main() {
+  const double delta=0.2, chis=0.1, chia=0.0, v0=0.1;
+  clock_t start, end;
+
+  start = clock();
+  const Waveform Uncached("TaylorT4", delta, chis, chia, v0);
+  end = clock();
+  cout << "Uncached: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds for "
+       << Uncached.NTimes() << " times and " << Uncached.NModes() << " modes" << endl;
+
+  PNWaveformCache::SetDirectory("PNWaveformCache");
+  PNWaveformCache::SetMaxMemoryEntries(2);
+
+  start = clock();
+  const Waveform Cold("TaylorT4", delta, chis, chia, v0);
+  end = clock();
+  cout << "Cold (computed and stored): " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+
+  PNWaveformCache::ClearMemory();
+  start = clock();
+  const Waveform Disk("TaylorT4", delta, chis, chia, v0);
+  end = clock();
+  cout << "Read from disk: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference "
+       << MaxDifference(Uncached, Disk) << endl;
+
+  start = clock();
+  const Waveform Memo("TaylorT4", delta, chis, chia, v0);
+  end = clock();
+  cout << "Read from memory: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference "
+       << MaxDifference(Uncached, Memo) << endl;
+
+  /// Changing any parameter must miss
+  const Waveform Other("TaylorT4", delta, chis, chia, v0*(1+1e-15));
+  cout << "Hits: " << PNWaveformCache::Hits() << "; misses: " << PNWaveformCache::Misses() << endl;
+
+  /// Precessing systems also return S1, S2, and LNHat
+  vector<double> chi1(3, 0.0), chi2(3, 0.0);
+  chi1[0] = 0.3; chi1[2] = 0.2; chi2[1] = -0.1;
+  vector<vector<double> > S1, S2, LNHat, S1Cached, S2Cached, LNHatCached;
+  const Waveform Precessing("TaylorT4Spin", delta, chi1, chi2, v0, S1, S2, LNHat);
+  PNWaveformCache::ClearMemory();
+  const Waveform PrecessingCached("TaylorT4Spin", delta, chi1, chi2, v0, S1Cached, S2Cached, LNHatCached);
+  cout << "Precessing: max difference " << MaxDifference(Precessing, PrecessingCached)
+       << "; LNHat " << (LNHat==LNHatCached ? "matches" : "DIFFERS") << endl;
+
+  /// A small size cap leaves only the most recent entry on disk
+  PNWaveformCache::SetMaxBytes(1.0);
+  const Waveform Evicting("TaylorT4", delta, chis, chia, 1.01*v0);
+  PNWaveformCache::ClearMemory();
+  const unsigned int HitsBefore = PNWaveformCache::Hits();
+  const Waveform Evicted("TaylorT4", delta, chis, chia, v0);
+  cout << "After eviction, original entry was " << (PNWaveformCache::Hits()==HitsBefore ? "recomputed" : "STILL CACHED") << endl;
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <ctime>
+
+#include "Interpolate.hpp"
+#include "Quaternions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+namespace WaveformUtilities {
+  /// Serialize from inside the library's namespace, where other
+  /// operator<< overloads (e.g., Quaternion's) hide any global one
+  std::string Serialize(const PiecewiseCubic& P) {
+    std::ostringstream Stream;
+    Stream << P;
+    return Stream.str();
+  }
+}
+
+/// Fit a PiecewiseCubic to sin(x) on nonuniform knots, and report the
+/// largest errors in its value, derivatives and integral at many
+/// points, the time for each kind of query, and whether it survives a
+/// round trip through a stream unchanged.
+int main() {
+  const unsigned int N1 = 10000, N2 = 1000000;
+  vector<double> X1(N1), Y1(N1), X2(N2);
+  for(unsigned int i=0; i<N1; ++i) {
+    const double s = double(i)/double(N1-1);
+    X1[i] = 20.0*(s+0.1*sin(3.0*s));
+    Y1[i] = sin(X1[i]);
+  }
+  for(unsigned int i=0; i<N2; ++i) {
+    X2[i] = X1[0] + (X1.back()-X1[0])*double(i)/double(N2-1);
+  }
+
+  clock_t start, end;
+  start = clock();
+  const WU::PiecewiseCubic P(X1, Y1);
+  end = clock();
+  cout << setprecision(4) << "Fit " << N1 << " knots: " << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+
+  const char* Names[] = { "Value", "Derivative", "SecondDerivative", "Integral" };
+  for(unsigned int q=0; q<4; ++q) {
+    vector<double> Y2;
+    start = clock();
+    if(q==0) { P.Value(X2, Y2); }
+    if(q==1) { P.Derivative(X2, Y2); }
+    if(q==2) { P.SecondDerivative(X2, Y2); }
+    if(q==3) { P.Integral(X2, Y2); }
+    end = clock();
+    double MaxError = 0.0;
+    for(unsigned int i=0; i<N2; ++i) {
+      const double Exact = (q==0 ? sin(X2[i]) : (q==1 ? cos(X2[i]) : (q==2 ? -sin(X2[i]) : cos(X1[0])-cos(X2[i]))));
+      MaxError = max(MaxError, fabs(Y2[i]-Exact));
+    }
+    cout << setw(17) << left << Names[q] << N2 << " points: " << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max error " << MaxError << endl;
+  }
+
+  /// The errors in the derivatives near the ends are dominated by the
+  /// natural boundary conditions, so look at the middle too
+  const double xMid = 0.5*(X1[0]+X1.back());
+  cout << "At x=" << xMid << ": derivative error " << P.Derivative(xMid)-cos(xMid)
+       << "; second derivative error " << P.SecondDerivative(xMid)+sin(xMid) << endl;
+
+  stringstream Stream(WU::Serialize(P));
+  WU::PiecewiseCubic Q;
+  Stream >> Q;
+  bool Same = (Q.Knots()==P.Knots());
+  for(unsigned int i=0; i<N2 && Same; i+=997) {
+    Same = (Q.Value(X2[i])==P.Value(X2[i]) && Q.Integral(X2[i])==P.Integral(X2[i]));
+  }
+  cout << "Round trip through a stream: " << (Same ? "identical" : "DIFFERENT") << endl;
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include "NumericalRecipes.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <ctime>
+
+#include "QNMs.hpp"
+#include "VectorFunctions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Time QNM frequency lookups, and add a mode to the table from a file.
+int main() {
+  cout << setprecision(12);
+
+  const unsigned int N = 1000000;
+  double omegaRe, omegaIm, Sum=0.0;
+  clock_t start, end;
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    WU::QNM(2, 2, 0, 0.95*i/N, omegaRe, omegaIm);
+    Sum += omegaRe;
+  }
+  end = clock();
+  cout << "QNM: " << N/(double(end-start)/double(CLOCKS_PER_SEC)) << " calls/sec (sum=" << Sum << ")" << endl;
+
+  vector<double> OvertonesRe, OvertonesIm;
+  WU::QNMOvertones(2, 2, 0.7, OvertonesRe, OvertonesIm);
+  cout << "(2,2) overtones at chi=0.7:\n\tRe: " << OvertonesRe << "\n\tIm: " << OvertonesIm << endl;
+  cout << "QNMLMs():\n" << WU::QNMLMs() << endl;
+
+  /// Tabulate a (5,5,0) mode, linear in chi, and read it back in
+  {
+    ofstream ofs("TestQNMs.dat");
+    ofs << "# l m n chi omegaRe omegaIm\n";
+    for(unsigned int i=0; i<=10; ++i) {
+      const double chi = 0.09*i;
+      ofs << setprecision(17) << "5 5 0 " << chi << " " << 1.0+chi << " " << 0.1*(1+chi) << "\n";
+    }
+  }
+  WU::ReadQNMTable("TestQNMs.dat");
+  WU::QNM(5, 5, 0, 0.5, omegaRe, omegaIm);
+  cout << "(5,5,0) at chi=0.5 from file: " << omegaRe << " " << omegaIm << " (expected -1.5 0.15)" << endl;
+  WU::QNM(5, -5, 0, 0.5, omegaRe, omegaIm);
+  cout << "(5,-5,0) at chi=0.5 from file: " << omegaRe << " " << omegaIm << " (expected 1.5 0.15)" << endl;
+  cout << "(5,5) has " << WU::QNMTable::Instance().NOvertones(5, 5) << " overtone(s)" << endl;
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Quaternions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+using WU::Quaternion;
+using WU::QuaternionSeries;
+
+double MaxDifference(const vector<Quaternion>& P, const QuaternionSeries& Q) {
+  double Max = 0.0;
+  for(unsigned int i=0; i<P.size(); ++i) { Max = max(Max, (P[i]-Q[i]).abs()); }
+  return Max;
+}
+
+/// For a precessing frame with N=10^6 points, compare the time taken
+/// and the results of expressions built from the std::vector<Quaternion>
+/// operators and from the in-place QuaternionSeries operations.  The
+/// differences should all be exactly zero.
+int main() {
+  const unsigned int N = 1000000;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  vector<double> t(N), a(N);
+  vector<Quaternion> R(N);
+  for(unsigned int i=0; i<N; ++i) {
+    t[i] = 0.01*i;
+    R[i] = Quaternion(0.05*t[i], 0.3+0.1*sin(0.01*t[i]), -0.04*t[i]);
+    a[i] = 0.002*t[i];
+  }
+  const Quaternion Q(0.1, 0.2, 0.3);
+  const Quaternion z(0., 0., 0., 1.);
+
+  start = clock();
+  QuaternionSeries S(R);
+  end = clock();
+  cout << setw(36) << left << "Conversion to QuaternionSeries" << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+  vector<Quaternion> RBack;
+  start = clock();
+  S.Quaternions(RBack);
+  end = clock();
+  cout << setw(36) << left << "Conversion back" << double(end-start)/double(CLOCKS_PER_SEC)
+       << " seconds; max difference " << MaxDifference(R, S) << endl;
+
+  {
+    /// Note that the operator Quaternion*vector<Quaternion> multiplies
+    /// each element on the right, so the comparison is with a loop
+    start = clock();
+    vector<Quaternion> V(N);
+    for(unsigned int i=0; i<N; ++i) { V[i] = Q * R[i]; }
+    end = clock();
+    const double TimeVector = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    S.LeftMultiply(Q);
+    end = clock();
+    cout << setw(36) << left << "Q*R[i]" << TimeVector << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(V, S) << endl;
+  }
+
+  {
+    S = R;
+    start = clock();
+    const vector<double> V = WU::Component0(WU::conjugate(R) * WU::CenteredDifferencing(R, t) * z);
+    end = clock();
+    const double TimeVector = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    const QuaternionSeries Sdot = WU::CenteredDifferencing(S, t);
+    S.Conjugate().RightMultiply(Sdot).RightMultiply(z);
+    end = clock();
+    double Max = 0.0;
+    for(unsigned int i=0; i<N; ++i) { Max = max(Max, fabs(V[i]-S.Component0()[i])); }
+    cout << setw(36) << left << "Component0(conjugate(R)*Rdot*z)" << TimeVector << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << Max << endl;
+  }
+
+  {
+    S = R;
+    start = clock();
+    vector<Quaternion> V(R);
+    for(unsigned int i=0; i<N; ++i) { V[i] = V[i] * (a[i]*z).exp(); }
+    end = clock();
+    const double TimeVector = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    S.RightMultiplyByExp(a, z);
+    end = clock();
+    cout << setw(36) << left << "R*exp(a*z)" << TimeVector << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(V, S) << endl;
+  }
+
+  {
+    S = R;
+    start = clock();
+    const vector<Quaternion> V = WU::normalized(WU::pow(WU::conjugate(R) * Q, 0.5));
+    end = clock();
+    const double TimeVector = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    S.Conjugate().RightMultiply(Q).Pow(0.5).Normalize();
+    end = clock();
+    cout << setw(36) << left << "normalized(pow(conjugate(R)*Q, 0.5))" << TimeVector << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(V, S) << endl;
+  }
+
+  {
+    vector<double> tOut(N/2);
+    for(unsigned int i=0; i<N/2; ++i) { tOut[i] = 1.0 + 0.019*i; }
+    const WU::SquadInterpolator Interpolator(R, t);
+    vector<Quaternion> V;
+    Interpolator(tOut, V);
+    Interpolator(tOut, S);
+    cout << setw(36) << left << "SquadInterpolator" << "max difference " << MaxDifference(V, S) << endl;
+  }
+
+  return 0;
+}
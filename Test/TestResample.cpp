@@ -0,0 +1,62 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Interpolate.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Resample a chirp with N=10^6 points, from uniform and from
+/// nonuniform abscissas, onto a uniform grid with N points.  Compare
+/// the time taken and the largest error for the generic
+/// SplineInterpolator (hunting for each point), Resample with the
+/// natural spline, Resample with the Catmull-Rom spline, and a
+/// MultiSplineInterpolator (its setup, and then each series).
+double f(const double x) { return sin(x*(200.0+100.0*x)); }
+
+int main() {
+  const unsigned int N = 1000000;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  for(unsigned int Uniform=1; ; Uniform=0) {
+    vector<double> X1(N), Y1(N), X2(N), Y2(N), Exact(N);
+    for(unsigned int i=0; i<N; ++i) {
+      const double s = double(i)/double(N-1);
+      X1[i] = (Uniform ? s : s+0.2*s*(1-s)*sin(40.0*s));
+      Y1[i] = f(X1[i]);
+      X2[i] = 0.01 + 0.98*s;
+      Exact[i] = f(X2[i]);
+    }
+    cout << (Uniform ? "Uniform" : "Nonuniform") << " input:" << endl;
+
+    for(unsigned int Method=0; Method<4; ++Method) {
+      start = clock();
+      if(Method==0) {
+        WU::SplineInterpolator Spline(X1, Y1);
+        for(unsigned int i=0; i<N; ++i) { Y2[i] = Spline.interp(X2[i]); }
+      } else if(Method==1) {
+        WU::Resample(X1, Y1, X2, Y2, WU::NaturalCubicSpline);
+      } else if(Method==2) {
+        WU::Resample(X1, Y1, X2, Y2, WU::CatmullRomSpline);
+      } else {
+        WU::MultiSplineInterpolator Spline(X1, X2);
+        end = clock();
+        cout << "\t" << setw(32) << left << "MultiSplineInterpolator setup" << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+        start = clock();
+        Spline(Y1, Y2);
+      }
+      end = clock();
+      double MaxError = 0.0;
+      for(unsigned int i=0; i<N; ++i) { MaxError = max(MaxError, fabs(Y2[i]-Exact[i])); }
+      const char* Names[] = { "SplineInterpolator", "Resample(NaturalCubicSpline)", "Resample(CatmullRomSpline)", "MultiSplineInterpolator series" };
+      cout << "\t" << setw(32) << left << Names[Method] << double(end-start)/double(CLOCKS_PER_SEC)
+           << " seconds; max error " << MaxError << endl;
+    }
+
+    if(!Uniform) { break; }
+  }
+
+  return 0;
+}
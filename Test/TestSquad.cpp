@@ -0,0 +1,112 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "Quaternions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+using WU::Quaternion;
+
+/// Squad as it was written before SquadInterpolator, building every
+/// rotor with Quaternion arithmetic, for comparison.
+vector<Quaternion> SquadReference(const vector<Quaternion>& RIn, const vector<double>& tIn, const vector<double>& tOut) {
+  vector<Quaternion> ROut(tOut.size());
+  unsigned int iIn = 0;
+  unsigned int iOut = 0;
+  while(iOut<tOut.size() && iIn<tIn.size() && tIn[tIn.size()-1]>=tOut[iOut]) {
+    double Dtim1, Dti, Dtip1;
+    Quaternion Qim1, Qi, Qip1, Qip2, Ai, Bip1;
+    while(iIn+1<tIn.size() && tIn[iIn+1]<tOut[iOut]) { iIn += 1; }
+    Dti = tIn[iIn+1]-tIn[iIn];
+    Dtim1 = (iIn==0 ? Dti : tIn[iIn]-tIn[iIn-1]);
+    Dtip1 = (iIn+2==tIn.size() ? Dti : tIn[iIn+2]-tIn[iIn+1]);
+    Qi = RIn[iIn];
+    Qip1 = RIn[iIn+1];
+    Qim1 = (iIn==0 ? Qi*Qip1.conjugate()*Qi : RIn[iIn-1]);
+    Qip2 = (iIn+2==tIn.size() ? Qip1*Qi.conjugate()*Qip1 : RIn[iIn+2]);
+    Ai = Qi * WU::exp((WU::log(Qi.conjugate()*Qip1) + (Dti/Dtim1)*WU::log(Qim1.conjugate()*Qi)
+                       - 2*WU::log(Qip1*Qi.conjugate()))*0.25);
+    Bip1 = Qip1 * WU::exp(((Dti/Dtip1)*WU::log(Qip1.conjugate()*Qip2) + WU::log(Qi.conjugate()*Qip1)
+                           - 2*WU::log(Qip1*Qi.conjugate()))*-0.25);
+    while(iOut<tOut.size() && tOut[iOut]<=tIn[iIn+1]) {
+      const double taui = (tOut[iOut]-tIn[iIn]) / Dti;
+      ROut[iOut] = WU::Slerp(2*taui*(1-taui), WU::Slerp(taui, Qi, Qip1), WU::Slerp(taui, Ai, Bip1));
+      iOut += 1;
+    }
+    iIn += 1;
+  }
+  return ROut;
+}
+
+double MaxDifference(const vector<Quaternion>& P, const vector<Quaternion>& Q) {
+  double Max = 0.0;
+  for(unsigned int i=0; i<P.size(); ++i) { Max = max(Max, (P[i]-Q[i]).abs()); }
+  return Max;
+}
+
+/// Interpolate a precessing frame with N=10^4 nonuniform samples onto
+/// 10^6 uniform and 10^6 nonuniform times, comparing the time taken
+/// and the results of the reference Squad, the Squad function, and a
+/// SquadInterpolator (its setup, and then the evaluation).
+int main() {
+  const unsigned int NIn = 10000, NOut = 1000000;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  vector<double> tIn(NIn);
+  vector<Quaternion> RIn(NIn);
+  for(unsigned int i=0; i<NIn; ++i) {
+    const double s = double(i)/double(NIn-1);
+    tIn[i] = 2000.0*(s+0.1*s*(1-s)*sin(20.0*s));
+    RIn[i] = Quaternion(0.05*tIn[i], 0.3+0.1*sin(0.01*tIn[i]), -0.04*tIn[i]);
+  }
+
+  for(unsigned int Uniform=1; ; Uniform=0) {
+    vector<double> tOut(NOut);
+    for(unsigned int i=0; i<NOut; ++i) {
+      const double s = double(i)/double(NOut-1);
+      tOut[i] = 1999.0*(Uniform ? s : s+0.05*s*(1-s)*sin(30.0*s));
+    }
+    cout << (Uniform ? "Uniform" : "Nonuniform") << " output:" << endl;
+
+    start = clock();
+    const vector<Quaternion> RRef = SquadReference(RIn, tIn, tOut);
+    end = clock();
+    cout << "\t" << setw(28) << left << "Reference Squad" << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+
+    start = clock();
+    const vector<Quaternion> RSquad = WU::Squad(RIn, tIn, tOut);
+    end = clock();
+    cout << "\t" << setw(28) << left << "Squad" << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max difference " << MaxDifference(RSquad, RRef) << endl;
+
+    start = clock();
+    const WU::SquadInterpolator Interpolator(RIn, tIn);
+    end = clock();
+    cout << "\t" << setw(28) << left << "SquadInterpolator setup" << double(end-start)/double(CLOCKS_PER_SEC) << " seconds" << endl;
+    vector<Quaternion> ROut;
+    start = clock();
+    Interpolator(tOut, ROut);
+    end = clock();
+    cout << "\t" << setw(28) << left << "SquadInterpolator" << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max difference " << MaxDifference(ROut, RRef) << endl;
+
+    if(!Uniform) { break; }
+  }
+
+  /// Single times, including one before the data, which is
+  /// extrapolated, and one after, which throws
+  const vector<double> tSome(1, 1234.5);
+  cout << "Single time: " << (WU::SquadInterpolator(RIn, tIn, 1234.5, 1234.5)(1234.5) - SquadReference(RIn, tIn, tSome)[0]).abs()
+       << " difference; " << WU::SquadInterpolator(RIn, tIn, 1234.5, 1234.5).NIntervals() << " interval set up" << endl;
+  cout << "Before the data: " << WU::SquadInterpolator(RIn, tIn)(-1.0) << endl;
+  try {
+    WU::SquadInterpolator(RIn, tIn)(2001.0);
+    cout << "After the data: no exception" << endl;
+  } catch(int e) {
+    cout << "After the data: exception " << e << endl;
+  }
+
+  return 0;
+}
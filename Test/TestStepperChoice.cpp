@@ -0,0 +1,84 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <cmath>
+
+#include "OrbitalPhasing_T1.hpp"
+#include "OrbitalPhasing_T4.hpp"
+#include "OrbitalPhasing_T4_Spin.hpp"
+#include "OrbitalPhasing_EOB.hpp"
+#include "Interpolate.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+const double delta=0.2, chis=0.1, chia=0.05, v0=0.1;
+
+/// Integrate one approximant, returning the time since the start and
+/// the phase
+void Phase(const string& Approximant, const WU::ODEStepper Stepper, const double rtol, WU::ODEStatistics& Statistics,
+           vector<double>& t, vector<double>& Phi) {
+  vector<double> v;
+  Statistics.Clear();
+  if(Approximant=="TaylorT1") {
+    WU::TaylorT1(delta, chis, chia, v0, t, v, Phi, 500, true, 0, &Statistics, Stepper, rtol);
+  } else if(Approximant=="TaylorT4") {
+    WU::TaylorT4(delta, chis, chia, v0, t, v, Phi, 500, true, 0, 0, &Statistics, Stepper, rtol);
+  } else if(Approximant=="TaylorT4Spin") {
+    vector<double> chi1(3, 0.0), chi2(3, 0.0);
+    chi1[0] = 0.3; chi1[2] = 0.2; chi2[1] = -0.1;
+    vector<vector<double> > S1, S2, LNHat;
+    WU::TaylorT4Spin(delta, chi1, chi2, v0, t, v, Phi, S1, S2, LNHat, 500, true, 0, 0, &Statistics, Stepper, rtol);
+  } else {
+    WU::EOB(delta, chis, chia, v0, t, v, Phi, 40, true, rtol, 0, 0, 0, &Statistics, Stepper);
+  }
+  const double t0 = t[0];
+  for(unsigned int i=0; i<t.size(); ++i) { t[i] -= t0; }
+}
+
+/// For each approximant, compare the cost of integrating with each
+/// stepper at several tolerances to the error in the phase, measured
+/// against a tight reference integration.  The phase at the stopping
+/// event is too sensitive to the event itself to be a useful measure,
+/// so the phases are compared at 90% of the reference duration.
+int main() {
+  const string Approximants[] = { "TaylorT1", "TaylorT4", "TaylorT4Spin", "EOB" };
+  const WU::ODEStepper Steppers[] = { WU::Dopr853Stepper, WU::BSStepper };
+  const string StepperNames[] = { "Dopr853", "BS" };
+  const double Tolerances[] = { 1e-6, 1e-8, 1e-10, 1e-12 };
+  WU::ODEStatistics Statistics;
+  vector<double> t, Phi;
+
+  cout << "# Approximant Stepper rtol NSteps NRejected NRHS Seconds PhaseError" << endl;
+  for(unsigned int a=0; a<4; ++a) {
+    /// EOB is limited by roundoff beyond about 1e-11, and runs slowly
+    /// there, so its reference and tolerances are looser
+    const bool IsEOB = (Approximants[a]=="EOB");
+    Phase(Approximants[a], (IsEOB ? WU::DefaultStepper : WU::Dopr853Stepper), (IsEOB ? 1e-11 : 1e-13), Statistics, t, Phi);
+    const double tCompare = 0.9*t.back();
+    const double PhiRef = WU::Interpolate(t, Phi, tCompare);
+    if(IsEOB) { cout << "EOB phases at the reference tolerance:\n" << Statistics; }
+    for(unsigned int s=0; s<2; ++s) {
+      for(unsigned int i=0; i<4; ++i) {
+        const double rtol = (IsEOB ? 100.0*Tolerances[i] : Tolerances[i]);
+        Phase(Approximants[a], Steppers[s], rtol, Statistics, t, Phi);
+        WU::ODEStatistics::Phase Total = Statistics.Total();
+        if(IsEOB) {
+          /// Leave out the eccentricity reduction, which does not depend on the stepper or rtol
+          Total = WU::ODEStatistics::Phase();
+          for(unsigned int p=0; p<Statistics.NPhases(); ++p) {
+            if(Statistics[p].Name=="EccentricityReduction") { continue; }
+            Total.NSteps += Statistics[p].NSteps;
+            Total.NRejected += Statistics[p].NRejected;
+            Total.NRHS += Statistics[p].NRHS;
+            Total.Seconds += Statistics[p].Seconds;
+          }
+        }
+        cout << Approximants[a] << " " << StepperNames[s] << " " << rtol << " "
+             << Total.NSteps << " " << Total.NRejected << " " << Total.NRHS << " "
+             << setprecision(4) << Total.Seconds << " " << fabs(WU::Interpolate(t, Phi, tCompare)-PhiRef) << setprecision(6) << endl;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "OrbitalPhasing_T4_Spin.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// Time evaluations of the right-hand side of the precessing TaylorT4
+/// equations, and complete TaylorT4Spin integrations.
+int main() {
+  const double delta=0.2, v0=0.05;
+  vector<double> chi1(3), chi2(3);
+  chi1[0] = 0.3;  chi1[1] = 0.1; chi1[2] = 0.2;
+  chi2[0] = -0.2; chi2[1] = 0.4; chi2[2] = -0.1;
+  clock_t start, end;
+
+  const WU::TaylorT4SpinEquations d(delta);
+  const unsigned int N = 2000000;
+  vector<double> y(11), dydt(11);
+  y[1] = 0.0;
+  y[2] = chi1[0]*0.36; y[3] = chi1[1]*0.36; y[4] = chi1[2]*0.36;
+  y[5] = chi2[0]*0.16; y[6] = chi2[1]*0.16; y[7] = chi2[2]*0.16;
+  y[8] = 0.1; y[9] = -0.05;
+  double Sum = 0.0;
+  start = clock();
+  for(unsigned int i=0; i<N; ++i) {
+    y[0] = 0.05 + 0.3*i/N;
+    y[10] = 1.0 - 1e-7*i;
+    d(0.0, y, dydt);
+    Sum += dydt[0] + dydt[2] + dydt[6] + dydt[10];
+  }
+  end = clock();
+  const double TimeRHS = double(end-start)/double(CLOCKS_PER_SEC);
+  cout << setprecision(16) << "RHS: " << N/TimeRHS << " calls/sec (sum=" << Sum << ")" << endl;
+
+  const unsigned int NIntegrations = 10;
+  vector<double> t, v, Phi;
+  vector<vector<double> > S1, S2, LNHat;
+  start = clock();
+  for(unsigned int i=0; i<NIntegrations; ++i) {
+    WU::TaylorT4Spin(delta, chi1, chi2, v0, t, v, Phi, S1, S2, LNHat, 1, true);
+  }
+  end = clock();
+  cout << "TaylorT4Spin: " << double(end-start)/double(CLOCKS_PER_SEC)/NIntegrations << " seconds per integration from v0=" << v0
+       << "\n\t" << t.size() << " steps; t0=" << t[0] << "; Phi=" << Phi.back()
+       << "; LNHat=(" << LNHat[0].back() << ", " << LNHat[1].back() << ", " << LNHat[2].back() << ")" << endl;
+
+  return 0;
+}
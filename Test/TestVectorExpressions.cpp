@@ -0,0 +1,102 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+
+#include "VectorFunctions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+double MaxDifference(const vector<double>& a, const vector<double>& b) {
+  double Max = 0.0;
+  for(unsigned int i=0; i<a.size(); ++i) { Max = max(Max, fabs(a[i]-b[i])); }
+  return Max;
+}
+
+/// For vectors with N=10^6 points, compare the time taken and the
+/// results of explicit loops and of the (lazy) vector expressions.
+/// The differences should all be exactly zero.
+int main() {
+  const unsigned int N = 1000000, Repeats = 20;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  vector<double> Amp(N), Phi(N), a(N), b(N);
+  for(unsigned int i=0; i<N; ++i) {
+    Amp[i] = 1.0 + 1.e-6*i;
+    Phi[i] = 1.e-4*i + 0.1*sin(1.e-5*i);
+    a[i] = 0.3*i;
+    b[i] = 1.0/(1.0+i);
+  }
+
+  {
+    vector<double> Loop(N, 0.0), Expr(N, 0.0);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { Loop[i] += Amp[i]*cos(Phi[i]); }
+    }
+    end = clock();
+    const double TimeLoop = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      Expr += Amp*cos(Phi);
+    }
+    end = clock();
+    cout << setw(36) << left << "Re += Amp*cos(Phi)" << TimeLoop << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(Loop, Expr) << endl;
+  }
+
+  {
+    vector<double> Loop(N), Expr(N);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { Loop[i] = 0.5*(a[i]+b[i]); }
+    }
+    end = clock();
+    const double TimeLoop = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      Expr = 0.5*(a+b);
+    }
+    end = clock();
+    cout << setw(36) << left << "0.5*(a+b)" << TimeLoop << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(Loop, Expr) << endl;
+  }
+
+  {
+    vector<double> Loop(N), Expr(N);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { Loop[i] = atan2(Amp[i]*sin(Phi[i]), Amp[i]*cos(Phi[i])) - sqrt(fabs(a[i]-b[i]))/2.0; }
+    }
+    end = clock();
+    const double TimeLoop = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      Expr = atan2(Amp*sin(Phi), Amp*cos(Phi)) - sqrt(fabs(a-b))/2.0;
+    }
+    end = clock();
+    cout << setw(36) << left << "atan2(..)-sqrt(fabs(a-b))/2" << TimeLoop << " seconds vs. "
+         << double(end-start)/double(CLOCKS_PER_SEC) << " seconds; max difference " << MaxDifference(Loop, Expr) << endl;
+  }
+
+  {
+    /// The compound operators with vector arguments
+    vector<double> Loop(a), Expr(a);
+    for(unsigned int i=0; i<N; ++i) { Loop[i] -= b[i]; Loop[i] *= b[i]; Loop[i] /= Amp[i]; }
+    Expr -= b;
+    Expr *= b;
+    Expr /= Amp;
+    cout << setw(36) << left << "-=, *=, /=" << "max difference " << MaxDifference(Loop, Expr) << endl;
+  }
+
+  try {
+    const vector<double> c(N-1);
+    const vector<double> d = a + c;
+    cout << "Mismatched sizes: no exception" << endl;
+  } catch(int e) {
+    cout << "Mismatched sizes: exception " << e << endl;
+  }
+
+  return 0;
+}
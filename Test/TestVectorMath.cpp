@@ -0,0 +1,161 @@
+#include "NumericalRecipes.hpp"
+
+#include <iomanip>
+#include <ctime>
+#include <cstdlib>
+
+#include "VectorMath.hpp"
+#include "VectorFunctions.hpp"
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// The error of a in units in the last place of the exact value b,
+/// which is computed in long double
+double ULPs(const double a, const long double b) {
+  const double bd = double(b);
+  const double ulp = nextafter(fabs(bd), 1e308) - fabs(bd);
+  return double(fabsl((long double)(a) - b)) / ulp;
+}
+
+/// For N=10^6 random arguments, compare the time taken by the vector
+/// kernels and by loops over the libm functions, and measure the
+/// largest errors of each relative to long-double results.  Measure
+/// the errors of SinCos at the doubles nearest to multiples of pi/2
+/// over the whole range of its kernel, where the argument reduction
+/// cancels most of the argument.  Then compare the conversion of a chirp from (Re,Im) to (Mag,Arg), with
+/// phase unwrapping, against the previous separate passes.
+int main() {
+  const unsigned int N = 1000000, Repeats = 10;
+  clock_t start, end;
+  cout << setprecision(4);
+
+  srand(1234);
+  vector<double> x(N), y(N), s(N), c(N), z(N), sRef(N), cRef(N), zRef(N);
+  for(unsigned int i=0; i<N; ++i) {
+    x[i] = (2.0*rand()/RAND_MAX-1.0) * (i%2 ? 1.e3 : 10.0);
+    y[i] = (2.0*rand()/RAND_MAX-1.0) * (i%3 ? 1.0 : 1.e-3);
+  }
+
+  {
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { sRef[i] = sin(x[i]); cRef[i] = cos(x[i]); }
+    }
+    end = clock();
+    const double TimeLibm = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      WU::SinCos(x, s, c);
+    }
+    end = clock();
+    double MaxULPs = 0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      MaxULPs = max(MaxULPs, max(ULPs(s[i], sinl((long double)(x[i]))), ULPs(c[i], cosl((long double)(x[i])))));
+    }
+    cout << setw(8) << left << "SinCos" << "libm: " << TimeLibm << " seconds; kernel: " << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max error " << MaxULPs << " ulp" << endl;
+  }
+
+  {
+    const long double PiO2 = 1.570796326794896619231321691639751442L;
+    vector<double> xNear;
+    for(unsigned int k=1; k*PiO2<8.2e5; ++k) {
+      const double xk = double(k*PiO2);
+      xNear.push_back(xk);
+      xNear.push_back(-nextafter(xk, 0.0));
+      xNear.push_back(nextafter(xk, 1e308));
+    }
+    WU::SinCos(xNear, s, c);
+    double MaxULPs = 0.0;
+    for(unsigned int i=0; i<xNear.size(); ++i) {
+      MaxULPs = max(MaxULPs, max(ULPs(s[i], sinl((long double)(xNear[i]))), ULPs(c[i], cosl((long double)(xNear[i])))));
+    }
+    cout << setw(8) << left << "" << "max error next to multiples of pi/2 below 8.2e5: " << MaxULPs << " ulp" << endl;
+  }
+
+  {
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { zRef[i] = atan2(y[i], x[i]); }
+    }
+    end = clock();
+    const double TimeLibm = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      WU::Atan2(y, x, z);
+    }
+    end = clock();
+    double MaxULPs = 0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      MaxULPs = max(MaxULPs, ULPs(z[i], atan2l((long double)(y[i]), (long double)(x[i]))));
+    }
+    cout << setw(8) << left << "Atan2" << "libm: " << TimeLibm << " seconds; kernel: " << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max error " << MaxULPs << " ulp" << endl;
+  }
+
+  {
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      for(unsigned int i=0; i<N; ++i) { zRef[i] = hypot(x[i], y[i]); }
+    }
+    end = clock();
+    const double TimeLibm = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      WU::Hypot(x, y, z);
+    }
+    end = clock();
+    double MaxULPs = 0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      const long double X=x[i], Y=y[i];
+      MaxULPs = max(MaxULPs, ULPs(z[i], sqrtl(X*X+Y*Y)));
+    }
+    cout << setw(8) << left << "Hypot" << "libm: " << TimeLibm << " seconds; kernel: " << double(end-start)/double(CLOCKS_PER_SEC)
+         << " seconds; max error " << MaxULPs << " ulp" << endl;
+  }
+
+  {
+    /// A chirp whose phase winds through many turns
+    vector<double> Mag(N), Arg(N), Re, Im, MagRef, ArgRef, MagNew, ArgNew;
+    for(unsigned int i=0; i<N; ++i) {
+      const double t = 1.e-6*i;
+      Mag[i] = 0.1/pow(1.0001-t, 0.25);
+      Arg[i] = -2.e4*pow(1.0001-t, 0.625);
+    }
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      WU::PolarToCartesian(Mag, Arg, Re, Im);
+    }
+    end = clock();
+    cout << setw(8) << left << "ReIm" << double(end-start)/double(CLOCKS_PER_SEC)/Repeats << " seconds per conversion" << endl;
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      MagRef.resize(N);
+      ArgRef.resize(N);
+      for(unsigned int i=0; i<N; ++i) {
+        MagRef[i] = sqrt(Re[i]*Re[i]+Im[i]*Im[i]);
+        ArgRef[i] = atan2(Im[i], Re[i]);
+      }
+      ArgRef = WU::Unwrap(ArgRef);
+    }
+    end = clock();
+    const double TimeLibm = double(end-start)/double(CLOCKS_PER_SEC);
+    start = clock();
+    for(unsigned int r=0; r<Repeats; ++r) {
+      WU::CartesianToPolar(Re, Im, MagNew, ArgNew);
+    }
+    end = clock();
+    double MaxMag = 0.0, MaxArg = 0.0, MaxArgRef = 0.0, MaxArgNew = 0.0;
+    for(unsigned int i=0; i<N; ++i) {
+      MaxMag = max(MaxMag, fabs(MagNew[i]-MagRef[i])/MagRef[i]);
+      MaxArg = max(MaxArg, fabs(ArgNew[i]-ArgRef[i]));
+      MaxArgRef = max(MaxArgRef, fabs(ArgRef[i]-ArgRef[0]-Arg[i]+Arg[0]));
+      MaxArgNew = max(MaxArgNew, fabs(ArgNew[i]-ArgNew[0]-Arg[i]+Arg[0]));
+    }
+    cout << setw(8) << left << "MagArg" << "separate: " << TimeLibm/Repeats << " seconds; fused: " << double(end-start)/double(CLOCKS_PER_SEC)/Repeats
+         << " seconds; max differences " << MaxMag << " (Mag, relative), " << MaxArg << " (Arg)" << endl
+         << "        Arg errors (relative to the first): separate " << MaxArgRef << "; fused " << MaxArgNew << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,257 @@
+#include "DenseTrajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "NumericalRecipes.hpp"
+#include "Utilities.hpp"
+
+using namespace std;
+namespace WU = WaveformUtilities;
+using WU::DenseTrajectory;
+
+
+void DenseTrajectory::Clear() {
+  nvar = 0;
+  tEnd = 0.0;
+  StepStart.clear();
+  StepSize.clear();
+  Offset.clear();
+  Type.clear();
+  Mu.clear();
+  Coefficients.clear();
+}
+
+void DenseTrajectory::swap(DenseTrajectory& b) {
+  std::swap(nvar, b.nvar);
+  std::swap(tEnd, b.tEnd);
+  StepStart.swap(b.StepStart);
+  StepSize.swap(b.StepSize);
+  Offset.swap(b.Offset);
+  Type.swap(b.Type);
+  Mu.swap(b.Mu);
+  Coefficients.swap(b.Coefficients);
+}
+
+/// Make room for a new step, whose coefficients will be filled in by AddStep.
+void DenseTrajectory::NewStep(const double xold, const double h, const int type, const int mu,
+                              const unsigned int n, const unsigned int NCoefficients) {
+  if(nvar==0) {
+    nvar = n;
+  } else if(nvar!=n) {
+    Throw1WithMessage("Number of variables changed in the middle of a DenseTrajectory.");
+  }
+  if(StepStart.size()>0 && xold<StepStart.back()) {
+    Throw1WithMessage("DenseTrajectory steps must be added in order of increasing time.");
+  }
+  StepStart.push_back(xold);
+  StepSize.push_back(h);
+  Offset.push_back(Coefficients.size());
+  Type.push_back(type);
+  Mu.push_back(mu);
+  Coefficients.resize(Coefficients.size()+NCoefficients);
+  tEnd = xold+h;
+}
+
+/// Add DeltaT to the time of every step (e.g., to set the merger at t=0).
+DenseTrajectory& DenseTrajectory::ShiftTime(const double DeltaT) {
+  for(unsigned int k=0; k<StepStart.size(); ++k) {
+    StepStart[k] += DeltaT;
+  }
+  tEnd += DeltaT;
+  return *this;
+}
+
+/// End the trajectory at time t, inside its last step (e.g., at an
+/// event found by Odeint).
+DenseTrajectory& DenseTrajectory::TruncateAt(const double t) {
+  if(StepStart.size()==0 || t<StepStart.back()) {
+    Throw1WithMessage("DenseTrajectory may only be truncated within its last step.");
+  }
+  tEnd = t;
+  return *this;
+}
+
+/// Find the step containing t by bisection; times outside the
+/// trajectory are assigned to the first or last step.
+unsigned int DenseTrajectory::Locate(const double t) const {
+  if(StepStart.size()==0) { Throw1WithMessage("Empty DenseTrajectory"); }
+  const unsigned int k = upper_bound(StepStart.begin(), StepStart.end(), t) - StepStart.begin();
+  return (k==0 ? 0 : k-1);
+}
+
+/// Find the step containing t, starting from the step Guess; this is
+/// O(1) when successive calls have t increasing slowly.
+unsigned int DenseTrajectory::Hunt(const double t, const unsigned int Guess) const {
+  const unsigned int N = StepStart.size();
+  if(Guess>=N || t<StepStart[Guess]) { return Locate(t); }
+  unsigned int k = Guess;
+  for(unsigned int j=0; j<4 && k<N-1; ++j) {
+    if(t<StepStart[k+1]) { return k; }
+    ++k;
+  }
+  if(k==N-1) { return k; }
+  return Locate(t);
+}
+
+double DenseTrajectory::Value(const unsigned int Step, const unsigned int i, const double t) const {
+  const unsigned int n = nvar;
+  const double* c = &Coefficients[Offset[Step]] + i;
+  const double s = (t-StepStart[Step])/StepSize[Step];
+  const double s1 = 1.0-s;
+  if(Type[Step]==Dopr853Step) {
+    /// See StepperDopr853::dense_out
+    return c[0]+s*(c[n]+s1*(c[2*n]+s*(c[3*n]+s1*(c[4*n]+s*(c[5*n]+s1*(c[6*n]+s*c[7*n]))))));
+  }
+  /// See StepperBS::dense_out
+  const int mu = Mu[Step];
+  double y = c[0]+s*(c[n]+s1*(c[2*n]*s+c[3*n]*s1));
+  if(mu<0) { return y; }
+  const double s05 = s-0.5;
+  double C = c[n*(mu+4)];
+  for(int j=mu; j>0; --j) {
+    C = c[n*(j+3)] + C*s05/j;
+  }
+  return y + SQR(s*s1)*C;
+}
+
+double DenseTrajectory::Derivative(const unsigned int Step, const unsigned int i, const double t) const {
+  const unsigned int n = nvar;
+  const double* c = &Coefficients[Offset[Step]] + i;
+  const double h = StepSize[Step];
+  const double s = (t-StepStart[Step])/h;
+  const double s1 = 1.0-s;
+  if(Type[Step]==Dopr853Step) {
+    /// Differentiate the nested form of StepperDopr853::dense_out from
+    /// the inside out, alternating factors of s and (1-s)
+    double p = c[7*n], dp = 0.0;
+    for(int j=6; j>=0; --j) {
+      if(j%2==0) {
+        dp = p + s*dp;
+        p = c[j*n] + s*p;
+      } else {
+        dp = -p + s1*dp;
+        p = c[j*n] + s1*p;
+      }
+    }
+    return dp/h;
+  }
+  const int mu = Mu[Step];
+  const double A = c[2*n]*s+c[3*n]*s1, dA = c[2*n]-c[3*n];
+  const double B = c[n]+s1*A, dB = -A+s1*dA;
+  double dy = B+s*dB;
+  if(mu>=0) {
+    const double s05 = s-0.5;
+    double C = c[n*(mu+4)], dC = 0.0;
+    for(int j=mu; j>0; --j) {
+      dC = (C + s05*dC)/j;
+      C = c[n*(j+3)] + C*s05/j;
+    }
+    dy += SQR(s*s1)*dC + 2.0*s*s1*(s1-s)*C;
+  }
+  return dy/h;
+}
+
+/// Evaluate component i of the solution at time t.
+double DenseTrajectory::Evaluate(const unsigned int i, const double t) const {
+  return Value(Locate(t), i, t);
+}
+
+/// Evaluate all components of the solution at time t.
+void DenseTrajectory::EvaluateAll(const double t, std::vector<double>& y) const {
+  const unsigned int k = Locate(t);
+  y.resize(nvar);
+  for(unsigned int i=0; i<nvar; ++i) {
+    y[i] = Value(k, i, t);
+  }
+}
+
+/// Evaluate component i of the solution at each of the times t, which
+/// should be sorted for efficiency (though this is not required).
+std::vector<double> DenseTrajectory::Evaluate(const unsigned int i, const std::vector<double>& t) const {
+  std::vector<double> y(t.size());
+  unsigned int k = 0;
+  for(unsigned int j=0; j<t.size(); ++j) {
+    k = Hunt(t[j], k);
+    y[j] = Value(k, i, t[j]);
+  }
+  return y;
+}
+
+/// Evaluate all components of the solution at each of the times t;
+/// the output is indexed as y[component][time].
+void DenseTrajectory::EvaluateAll(const std::vector<double>& t, std::vector<std::vector<double> >& y) const {
+  y.resize(nvar);
+  for(unsigned int i=0; i<nvar; ++i) {
+    y[i].resize(t.size());
+  }
+  unsigned int k = 0;
+  for(unsigned int j=0; j<t.size(); ++j) {
+    k = Hunt(t[j], k);
+    for(unsigned int i=0; i<nvar; ++i) {
+      y[i][j] = Value(k, i, t[j]);
+    }
+  }
+}
+
+/// Evaluate the time derivative of component i of the solution at time t.
+double DenseTrajectory::EvaluateDerivative(const unsigned int i, const double t) const {
+  return Derivative(Locate(t), i, t);
+}
+
+/// Evaluate the time derivative of component i at each of the times t.
+std::vector<double> DenseTrajectory::EvaluateDerivative(const unsigned int i, const std::vector<double>& t) const {
+  std::vector<double> dydt(t.size());
+  unsigned int k = 0;
+  for(unsigned int j=0; j<t.size(); ++j) {
+    k = Hunt(t[j], k);
+    dydt[j] = Derivative(k, i, t[j]);
+  }
+  return dydt;
+}
+
+/// Return N evenly spaced times spanning the trajectory.
+std::vector<double> DenseTrajectory::UniformTime(const unsigned int N) const {
+  /// This is the analog of Waveform::UniformTime; the result may be
+  /// passed to Evaluate to sample the continuous solution itself,
+  /// rather than an interpolant of its samples.
+  const double t0 = TMin();
+  const double dt = (TMax()-t0)/(N-1);
+  std::vector<double> NewTime(N);
+  for(unsigned int j=0; j<N; ++j) {
+    NewTime[j] = t0 + j*dt;
+  }
+  NewTime.back() = TMax();
+  return NewTime;
+}
+
+/// Return times with N samples per cycle of the (2,2) mode.
+std::vector<double> DenseTrajectory::NSamplesPerCycle22(const unsigned int N, const unsigned int iPhi) const {
+  /// \param N Number of samples per cycle of the (2,2) mode
+  /// \param iPhi Index of the orbital phase in the solution vector
+  ///
+  /// This is the analog of Waveform::NSamplesPerCycle22, except that
+  /// the (2,2) frequency is taken directly from the derivative of the
+  /// dense output of the orbital phase, \f$\omega_{22} = 2\,
+  /// \dot{\Phi}\f$, rather than from finite differences of
+  /// interpolated data.  The time step is also allowed to decrease
+  /// below the integrator's own step, because the dense output is
+  /// accurate everywhere.
+  if(iPhi>=nvar) { Throw1WithMessage("iPhi is out of range"); }
+  const double t1 = TMax();
+  std::vector<double> NewTime(1, TMin());
+  unsigned int k = 0;
+  double t = NewTime[0];
+  double dt_Last = StepSize[0];
+  while(true) {
+    k = Hunt(t, k);
+    const double omega22 = 2.0*fabs(Derivative(k, iPhi, t));
+    const double dt_Samples = (omega22==0.0 ? StepSize[k] : 2*M_PI / (N*omega22));
+    const double dt_New = min(dt_Samples, 1.1*dt_Last);
+    t += dt_New;
+    if(t>t1) { break; }
+    NewTime.push_back(t);
+    dt_Last = dt_New;
+  }
+  return NewTime;
+}
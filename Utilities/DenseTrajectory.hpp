@@ -0,0 +1,107 @@
+#ifndef DENSETRAJECTORY_HPP
+#define DENSETRAJECTORY_HPP
+
+#include <vector>
+
+namespace WaveformUtilities {
+
+  template <class D> struct StepperDopr853;
+  template <class D> struct StepperBS;
+
+  /// This class stores the dense-output interpolation coefficients of
+  /// every step taken by an ODE integration, so that the continuous
+  /// solution y(t) can be evaluated at arbitrary times after the
+  /// integration is finished, to the accuracy of the integrator
+  /// itself.  This is more accurate than splining the discrete
+  /// samples returned in an Output object.
+  ///
+  /// To use it, point the `trajectory` member of an Output object at a
+  /// DenseTrajectory before integrating; the Output object must have
+  /// nsave>0, so that the stepper actually computes its dense-output
+  /// coefficients.  Both StepperDopr853 and StepperBS steps may be
+  /// stored (and mixed, as in the EOB integration).  Steps must be
+  /// added in order of increasing time.
+  ///
+  /// Evaluation at a single time locates the step by bisection,
+  /// O(log N); evaluation on a sorted vector of times advances through
+  /// the steps monotonically, O(1) per point.
+  class DenseTrajectory {
+  private:
+    enum StepType { Dopr853Step, BSStep };
+    unsigned int nvar;
+    double tEnd;
+    std::vector<double> StepStart;
+    std::vector<double> StepSize;
+    std::vector<unsigned int> Offset;
+    std::vector<int> Type;
+    std::vector<int> Mu;
+    std::vector<double> Coefficients;
+
+  private:
+    unsigned int Locate(const double t) const;
+    unsigned int Hunt(const double t, const unsigned int Guess) const;
+    double Value(const unsigned int Step, const unsigned int i, const double t) const;
+    double Derivative(const unsigned int Step, const unsigned int i, const double t) const;
+    void NewStep(const double xold, const double h, const int type, const int mu, const unsigned int n, const unsigned int NCoefficients);
+
+  public:
+    DenseTrajectory() : nvar(0), tEnd(0.0) { }
+    ~DenseTrajectory() { }
+    void Clear();
+    void swap(DenseTrajectory& b);
+
+    template <class D> void AddStep(const StepperDopr853<D>& s);
+    template <class D> void AddStep(const StepperBS<D>& s);
+    DenseTrajectory& ShiftTime(const double DeltaT);
+    DenseTrajectory& TruncateAt(const double t);
+
+    inline unsigned int NVar() const { return nvar; }
+    inline unsigned int NSteps() const { return StepStart.size(); }
+    inline double TMin() const { return StepStart.front(); }
+    inline double TMax() const { return tEnd; }
+
+    double Evaluate(const unsigned int i, const double t) const;
+    void EvaluateAll(const double t, std::vector<double>& y) const;
+    std::vector<double> Evaluate(const unsigned int i, const std::vector<double>& t) const;
+    void EvaluateAll(const std::vector<double>& t, std::vector<std::vector<double> >& y) const;
+    double EvaluateDerivative(const unsigned int i, const double t) const;
+    std::vector<double> EvaluateDerivative(const unsigned int i, const std::vector<double>& t) const;
+
+    std::vector<double> UniformTime(const unsigned int N) const;
+    std::vector<double> NSamplesPerCycle22(const unsigned int N, const unsigned int iPhi=1) const;
+  };
+
+
+  /// Store the coefficients of the step just taken by a StepperDopr853.
+  template <class D>
+  void DenseTrajectory::AddStep(const StepperDopr853<D>& s) {
+    const unsigned int n = s.n;
+    NewStep(s.xold, s.hdid, Dopr853Step, 0, n, 8*n);
+    double* c = &Coefficients[Offset.back()];
+    for(unsigned int i=0; i<n; ++i) {
+      c[i]     = s.rcont1[i];
+      c[n+i]   = s.rcont2[i];
+      c[2*n+i] = s.rcont3[i];
+      c[3*n+i] = s.rcont4[i];
+      c[4*n+i] = s.rcont5[i];
+      c[5*n+i] = s.rcont6[i];
+      c[6*n+i] = s.rcont7[i];
+      c[7*n+i] = s.rcont8[i];
+    }
+  }
+
+  /// Store the coefficients of the step just taken by a StepperBS.
+  template <class D>
+  void DenseTrajectory::AddStep(const StepperBS<D>& s) {
+    const unsigned int n = s.n;
+    const unsigned int NCoefficients = (s.mu<0 ? 4*n : (s.mu+5)*n);
+    NewStep(s.xold, s.hdid, BSStep, s.mu, n, NCoefficients);
+    double* c = &Coefficients[Offset.back()];
+    for(unsigned int j=0; j<NCoefficients; ++j) {
+      c[j] = s.dens[j];
+    }
+  }
+
+} // namespace WaveformUtilities
+
+#endif // DENSETRAJECTORY_HPP
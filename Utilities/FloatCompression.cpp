@@ -0,0 +1,355 @@
+#include "FloatCompression.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "NumericalRecipes.hpp"
+
+using namespace std;
+namespace WU = WaveformUtilities;
+
+/// The first byte of each series gives the method used
+static const unsigned char Lossless = 0;
+static const unsigned char QuantizedAbsolute = 1;
+static const unsigned char QuantizedRelative = 2;
+
+/// Quantized values must be smaller than 2^50 steps, so that their
+/// differences are exact
+static const double MaxSteps = 1125899906842624.0;
+
+static inline Ullong ToBits(const double x) {
+  Ullong b;
+  memcpy(&b, &x, sizeof(double));
+  return b;
+}
+
+static inline double FromBits(const Ullong b) {
+  double x;
+  memcpy(&x, &b, sizeof(double));
+  return x;
+}
+
+/// The number of leading and trailing zero bits of x, which is nonzero
+static inline unsigned int LeadingZeros(Ullong x) {
+  #ifdef __GNUC__
+  return __builtin_clzll(x);
+  #else
+  unsigned int n = 0;
+  while(!(x & (Ullong(1)<<63))) { x <<= 1; ++n; }
+  return n;
+  #endif
+}
+static inline unsigned int TrailingZeros(Ullong x) {
+  #ifdef __GNUC__
+  return __builtin_ctzll(x);
+  #else
+  unsigned int n = 0;
+  while(!(x & Ullong(1))) { x >>= 1; ++n; }
+  return n;
+  #endif
+}
+
+/// The prediction of x[i] by cubic extrapolation from the values
+/// before it, as the sum of the last value and its backward
+/// differences.  There is no multiplication, so that the encoder and
+/// decoder round identically however the compiler fuses operations.
+static inline double Predict(const double* x, const unsigned int i) {
+  if(i==0) { return 0.0; }
+  const double a = x[i-1];
+  if(i==1) { return a; }
+  const double d1 = a-x[i-2];
+  double p = a+d1;
+  if(i>2) {
+    const double d2 = x[i-2]-x[i-3];
+    const double dd1 = d1-d2;
+    if(i==3) {
+      p = a+(d1+dd1);
+    } else {
+      const double ddd = dd1-(d2-(x[i-3]-x[i-4]));
+      p = a+(d1+(dd1+ddd));
+    }
+  }
+  return (fabs(p)<=numeric_limits<double>::max() ? p : a);
+}
+
+/// The prediction of the multiple k[i] of the step, by quadratic
+/// extrapolation; rounding makes the higher differences noisy.  The
+/// arithmetic is unsigned, so that corrupt data cannot overflow.
+static inline Ullong Predict(const Ullong k1, const Ullong k2, const Ullong k3, const unsigned int i) {
+  if(i==0) { return 0; }
+  if(i==1) { return k1; }
+  if(i==2) { return k1+(k1-k2); }
+  return 3*(k1-k2)+k3;
+}
+
+/// Unsigned integers in 7-bit groups, least significant first, with
+/// the high bit set in every byte but the last
+static inline void AppendVarint(string& Bytes, Ullong u) {
+  while(u>=0x80) {
+    Bytes.push_back(char((u & 0x7F) | 0x80));
+    u >>= 7;
+  }
+  Bytes.push_back(char(u));
+}
+static inline bool ReadVarint(const char*& p, const char* End, Ullong& u) {
+  u = 0;
+  for(unsigned int Shift=0; Shift<64; Shift+=7) {
+    if(p==End) { return false; }
+    const unsigned char c = *p++;
+    u |= Ullong(c & 0x7F) << Shift;
+    if(!(c & 0x80)) { return true; }
+  }
+  return false;
+}
+
+/// 64-bit words as eight bytes, least significant first, so that the
+/// encoding does not depend on the byte order of the machine
+static inline void AppendFixed64(string& Bytes, Ullong u) {
+  for(unsigned int k=0; k<8; ++k) {
+    Bytes.push_back(char(u & 0xFF));
+    u >>= 8;
+  }
+}
+static inline bool ReadFixed64(const char*& p, const char* End, Ullong& u) {
+  if(End-p<8) { return false; }
+  u = 0;
+  for(unsigned int k=0; k<8; ++k) { u |= Ullong((unsigned char)(p[k])) << (8*k); }
+  p += 8;
+  return true;
+}
+
+/// Signed integers of small magnitude map to small unsigned integers
+static inline Ullong ZigZag(const Llong d) { return (Ullong(d)<<1) ^ Ullong(d>>63); }
+static inline Llong UnZigZag(const Ullong u) { return Llong((u>>1) ^ (~(u&1)+1)); }
+
+/// Bits are written and read most significant first
+class BitWriter {
+private:
+  string& Bytes;
+  Ullong Acc;
+  unsigned int NAcc;
+public:
+  BitWriter(string& bytes) : Bytes(bytes), Acc(0), NAcc(0) { }
+  /// Write the low N<=32 bits of Bits, which has no others set
+  inline void Write(const Ullong Bits, const unsigned int N) {
+    Acc = (Acc<<N) | Bits;
+    NAcc += N;
+    while(NAcc>=8) {
+      NAcc -= 8;
+      Bytes.push_back(char((Acc>>NAcc) & 0xFF));
+    }
+  }
+  /// Write the low N<=64 bits of Bits, which has no others set
+  inline void WriteLong(const Ullong Bits, const unsigned int N) {
+    if(N>32) {
+      Write(Bits>>32, N-32);
+      Write(Bits & Ullong(0xFFFFFFFF), 32);
+    } else {
+      Write(Bits, N);
+    }
+  }
+  /// Write v>=1 as n-1 zeros followed by its n significant bits, so
+  /// that small numbers take few bits
+  inline void WriteGamma(const Ullong v) {
+    const unsigned int n = 64-LeadingZeros(v);
+    unsigned int Zeros = n-1;
+    while(Zeros>32) { Write(0, 32); Zeros -= 32; }
+    Write(0, Zeros);
+    WriteLong(v, n);
+  }
+  /// Pad the last byte with zeros
+  void Flush() {
+    if(NAcc>0) { Bytes.push_back(char((Acc<<(8-NAcc)) & 0xFF)); }
+    NAcc = 0;
+  }
+};
+
+class BitReader {
+private:
+  const char* p;
+  const char* End;
+  Ullong Acc;
+  unsigned int NAcc;
+  bool Failed;
+public:
+  BitReader(const char* begin, const char* end) : p(begin), End(end), Acc(0), NAcc(0), Failed(false) { }
+  /// Read N<=32 bits
+  inline void Refill() {
+    while(NAcc<=56 && p!=End) {
+      Acc = (Acc<<8) | Ullong((unsigned char)(*p++));
+      NAcc += 8;
+    }
+  }
+  inline Ullong Read(const unsigned int N) {
+    if(NAcc<N) {
+      Refill();
+      if(NAcc<N) { Failed = true; return 0; }
+    }
+    NAcc -= N;
+    return (Acc>>NAcc) & ((Ullong(1)<<N)-1);
+  }
+  /// Read N<=64 bits
+  inline Ullong ReadLong(const unsigned int N) {
+    if(N>32) {
+      const Ullong High = Read(N-32);
+      return (High<<32) | Read(32);
+    }
+    return Read(N);
+  }
+  /// Read a number written by BitWriter::WriteGamma
+  inline Ullong ReadGamma() {
+    // Usually the whole code is in the accumulator
+    if(NAcc<32) { Refill(); }
+    if(NAcc>0) {
+      const Ullong Top = Acc<<(64-NAcc);
+      if(Top!=0) {
+        const unsigned int Zeros = LeadingZeros(Top);
+        if(2*Zeros<NAcc) {
+          NAcc -= 2*Zeros+1;
+          return (Acc>>NAcc) & ((Ullong(2)<<Zeros)-1);
+        }
+      }
+    }
+    unsigned int Zeros = 0;
+    while(Read(1)==0) {
+      if(Failed || ++Zeros>63) { Failed = true; return 0; }
+    }
+    return (Ullong(1)<<Zeros) | ReadLong(Zeros);
+  }
+  bool Good() const { return !Failed; }
+  /// The first byte not yet read, including the padding of the last
+  const char* Position() const { return p - NAcc/8; }
+};
+
+/// Each value is XORed with its prediction.  A zero result takes the
+/// bit '0'; otherwise, its nonzero bits are written after '10' if they
+/// lie in the window of the last '11', or else after '11', 6 bits for
+/// the number of leading zeros, and 6 bits for the number of bits in
+/// the new window, less one.  A window is reused unless it is more
+/// than 12 bits longer than needed, which is what a new one costs.
+static void CompressLossless(const vector<double>& x, string& Bytes) {
+  Bytes.push_back(char(Lossless));
+  AppendVarint(Bytes, x.size());
+  BitWriter Out(Bytes);
+  unsigned int Lead = 64, Trail = 64; // No window yet
+  for(unsigned int i=0; i<x.size(); ++i) {
+    const Ullong Diff = ToBits(x[i]) ^ ToBits(Predict(&x[0], i));
+    if(Diff==0) {
+      Out.Write(0, 1);
+      continue;
+    }
+    const unsigned int NewLead = LeadingZeros(Diff), NewTrail = TrailingZeros(Diff);
+    if(NewLead>=Lead && NewTrail>=Trail && NewLead+NewTrail<=Lead+Trail+12) {
+      Out.Write(2, 2);
+    } else {
+      Lead = NewLead;
+      Trail = NewTrail;
+      Out.Write(3, 2);
+      Out.Write(Lead, 6);
+      Out.Write(63-Lead-Trail, 6);
+    }
+    Out.WriteLong(Diff>>Trail, 64-Lead-Trail);
+  }
+  Out.Flush();
+}
+
+static bool DecompressLossless(const char*& p, const char* End, vector<double>& x) {
+  Ullong N;
+  if(!ReadVarint(p, End, N) || N>8*Ullong(End-p)) { return false; }
+  x.resize(N);
+  BitReader In(p, End);
+  unsigned int Lead = 64, Trail = 64;
+  for(unsigned int i=0; i<N; ++i) {
+    Ullong Diff = 0;
+    if(In.Read(1)) {
+      if(In.Read(1)) {
+        Lead = In.Read(6);
+        const unsigned int Length = In.Read(6)+1;
+        if(Lead+Length>64) { return false; }
+        Trail = 64-Lead-Length;
+      } else if(Lead+Trail>=64) {
+        return false;
+      }
+      Diff = In.ReadLong(64-Lead-Trail) << Trail;
+    }
+    x[i] = FromBits(ToBits(Predict(&x[0], i)) ^ Diff);
+  }
+  if(!In.Good()) { return false; }
+  p = In.Position();
+  return true;
+}
+
+/// The step is written first, then the differences between each
+/// multiple of the step and its prediction, mapped to unsigned
+/// integers v>=1 and written with BitWriter::WriteGamma, so that a
+/// difference of 0 takes one bit and +-1 three.  Returns false,
+/// having written nothing, if any value cannot be represented.
+static bool CompressQuantized(const vector<double>& x, string& Bytes, const double Tol, const bool RelativeTol) {
+  // Leave a little room for the roundoff of the reconstruction
+  const double Step = 2.0*(RelativeTol ? log1p(Tol) : Tol)*(1.0-1.e-6);
+  if(!(Step>0.0 && Step<=numeric_limits<double>::max())) { return false; }
+  const string::size_type Start = Bytes.size();
+  Bytes.push_back(char(RelativeTol ? QuantizedRelative : QuantizedAbsolute));
+  AppendFixed64(Bytes, ToBits(Step));
+  AppendVarint(Bytes, x.size());
+  BitWriter Out(Bytes);
+  Ullong k1 = 0, k2 = 0, k3 = 0;
+  for(unsigned int i=0; i<x.size(); ++i) {
+    if(RelativeTol && !(x[i]>0.0)) { Bytes.resize(Start); return false; }
+    const double q = floor((RelativeTol ? log(x[i]) : x[i])/Step + 0.5);
+    if(!(fabs(q)<MaxSteps)) { Bytes.resize(Start); return false; }
+    const Ullong k = Ullong(Llong(q));
+    const double Decoded = (RelativeTol ? exp(double(Llong(k))*Step) : double(Llong(k))*Step);
+    if(!(fabs(Decoded-x[i]) <= (RelativeTol ? Tol*x[i] : Tol))) { Bytes.resize(Start); return false; }
+    Out.WriteGamma(ZigZag(Llong(k-Predict(k1, k2, k3, i)))+1);
+    k3 = k2;
+    k2 = k1;
+    k1 = k;
+  }
+  Out.Flush();
+  return true;
+}
+
+static bool DecompressQuantized(const char*& p, const char* End, vector<double>& x, const bool RelativeTol) {
+  Ullong StepBits, N;
+  if(!ReadFixed64(p, End, StepBits)) { return false; }
+  const double Step = FromBits(StepBits);
+  if(!ReadVarint(p, End, N) || N>8*Ullong(End-p)) { return false; }
+  x.resize(N);
+  BitReader In(p, End);
+  Ullong k1 = 0, k2 = 0, k3 = 0;
+  for(unsigned int i=0; i<N; ++i) {
+    const Ullong k = Predict(k1, k2, k3, i) + Ullong(UnZigZag(In.ReadGamma()-1));
+    x[i] = double(Llong(k))*Step;
+    k3 = k2;
+    k2 = k1;
+    k1 = k;
+  }
+  if(!In.Good()) { return false; }
+  if(RelativeTol) {
+    for(unsigned int i=0; i<N; ++i) { x[i] = exp(x[i]); }
+  }
+  p = In.Position();
+  return true;
+}
+
+void WU::CompressSeries(const vector<double>& x, string& Bytes, const double Tol, const bool RelativeTol) {
+  if(Tol>0.0 && CompressQuantized(x, Bytes, Tol, RelativeTol)) { return; }
+  CompressLossless(x, Bytes);
+}
+
+bool WU::DecompressSeries(const char*& Begin, const char* End, vector<double>& x) {
+  const char* p = Begin;
+  if(p==End) { return false; }
+  const unsigned char Method = *p++;
+  bool Good = false;
+  if(Method==Lossless) {
+    Good = DecompressLossless(p, End, x);
+  } else if(Method==QuantizedAbsolute || Method==QuantizedRelative) {
+    Good = DecompressQuantized(p, End, x, Method==QuantizedRelative);
+  }
+  if(Good) { Begin = p; }
+  return Good;
+}
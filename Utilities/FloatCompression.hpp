@@ -0,0 +1,46 @@
+#ifndef FLOATCOMPRESSION_HPP
+#define FLOATCOMPRESSION_HPP
+
+#include <string>
+#include <vector>
+
+namespace WaveformUtilities {
+
+  /// Compact binary encodings of long, smooth series of doubles
+  ///
+  /// With Tol<=0, the series is stored losslessly: each value is
+  /// predicted by cubic extrapolation from the four before it, and
+  /// the bits of the value XORed with those of the prediction are
+  /// stored in the manner of Gorilla (Pelkonen et al., 2015) -- one
+  /// bit when the prediction is exact, and otherwise only the span
+  /// of bits that differ, reusing the previous span when it covers
+  /// them.  Smooth data, like the time, the magnitude, or the
+  /// unwrapped phase of a mode, agrees with its prediction in most
+  /// of the high bits.
+  ///
+  /// With Tol>0, each value is instead rounded to a multiple of a
+  /// step, and the differences of the multiples from their
+  /// prediction by quadratic extrapolation are stored in a
+  /// variable-length code, which usually takes a few bits each.  If
+  /// RelativeTol is false, every value decoded is within Tol of the
+  /// original, as for ArgTol in MinimalGrid; if it is true, every
+  /// value decoded is within Tol*|x[i]| of the original, as for
+  /// MagTol, by rounding log(x[i]).  Series that cannot be encoded
+  /// this way -- relative tolerances with values that are not
+  /// positive, or values that are not finite or are too large for
+  /// the step -- are stored losslessly.
+  ///
+  /// The encoded series is appended to Bytes, and records its own
+  /// length and method, so that series may be concatenated.  Every
+  /// field is written byte by byte, least significant first, so the
+  /// encoding is the same on machines of either byte order.
+  void CompressSeries(const std::vector<double>& x, std::string& Bytes, const double Tol=0.0, const bool RelativeTol=false);
+
+  /// Decode one series written by CompressSeries, starting at Begin,
+  /// and advance Begin past it.  Returns false, leaving Begin where
+  /// it was, if the data ends before End or is not a valid series.
+  bool DecompressSeries(const char*& Begin, const char* End, std::vector<double>& x);
+
+} // namespace WaveformUtilities
+
+#endif // FLOATCOMPRESSION_HPP
@@ -28,6 +28,7 @@ void gaussj(MatDoub_IO &a, MatDoub_IO &b)
   for (j=0;j<n;j++) ipiv[j]=0;
   for (i=0;i<n;i++) {
     big=0.0;
+    irow=icol=-1; // <added/> NaNs never pass the test below
     for (j=0;j<n;j++)
       if (ipiv[j] != 1)
         for (k=0;k<n;k++) {
@@ -39,6 +40,7 @@ void gaussj(MatDoub_IO &a, MatDoub_IO &b)
             }
           }
         }
+    if (icol < 0) Throw1WithMessage("gaussj: Singular Matrix"); // <added/>
     ++(ipiv[icol]);
     if (irow != icol) {
       for (l=0;l<n;l++) SWAP(a[irow][l],a[icol][l]);
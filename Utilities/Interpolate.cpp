@@ -1,5 +1,7 @@
 #include "Interpolate.hpp"
 
+#include <algorithm>
+
 #include "NumericalRecipes.hpp"
 #include "VectorFunctions.hpp"
 #include "Utilities.hpp"
@@ -10,12 +12,258 @@ using WU::Interpolator;
 using WU::PolynomialInterpolator;
 using WU::SplineInterpolator;
 using WU::SplineIntegrator;
+using WU::MultiSplineInterpolator;
 using WU::Interpolate;
 using WU::SplineIntegral;
 using WU::SplineCumulativeIntegral;
 
 // #undef DEBUG
 
+/// Find the interval [X[j],X[j+1]] of the increasing abscissas X
+/// containing each of a series of points, clamped to the first and
+/// last intervals.  If the points increase slowly enough, j is found
+/// by advancing from the last one; otherwise, it is computed directly
+/// if X is uniformly spaced, or found by bisection if not.
+class Bracketer {
+private:
+  const vector<double>& X;
+  const int N;
+  bool Uniform;
+  double InvDX, xLast;
+  int j;
+public:
+  Bracketer(const vector<double>& x)
+    : X(x), N(x.size()), Uniform(true), InvDX((N-1)/(X.back()-X[0])), xLast(X[0]), j(0)
+  {
+    const double dx = (X.back()-X[0])/(N-1);
+    for(int i=1; i<N-1 && Uniform; ++i) {
+      Uniform = (fabs(X[i]-X[0]-i*dx) <= 1e-10*dx);
+    }
+  }
+  int operator()(const double x) {
+    if(x>=xLast) {
+      // Try a few steps forward before starting over
+      for(int Steps=0; Steps<4 && j<N-2 && X[j+1]<=x; ++Steps) { ++j; }
+      if(j<N-2 && X[j+1]<=x) { j = locate(x); }
+    } else {
+      j = locate(x);
+    }
+    xLast = x;
+    return j;
+  }
+  int locate(const double x) const {
+    if(Uniform) {
+      int k = std::max(0, std::min(N-2, int(floor((x-X[0])*InvDX))));
+      // Correct for roundoff in the spacing
+      while(k<N-2 && X[k+1]<=x) { ++k; }
+      while(k>0 && X[k]>x) { --k; }
+      return k;
+    }
+    return std::max(0, std::min(N-2, int(std::upper_bound(X.begin(), X.end(), x)-X.begin())-1));
+  }
+};
+
+WU::PiecewiseCubic::PiecewiseCubic()
+  : X(), Coefficients()
+{ }
+
+/// The slopes at the data points are those of the natural cubic
+/// spline, or, for the Catmull-Rom spline, the centered differences
+/// (one-sided at the ends).  No storage is used beyond the
+/// coefficients.
+WU::PiecewiseCubic::PiecewiseCubic(const vector<double>& X1, const vector<double>& Y1, const WU::CubicInterpolant Method)
+  : X(X1), Coefficients()
+{
+  const int N = X.size();
+  if(N<2) { Throw1WithMessage("PiecewiseCubic needs at least two points"); }
+  if(int(Y1.size())!=N) {
+    cerr << "\nX1.size()=" << X1.size() << "\tY1.size()=" << Y1.size() << endl;
+    Throw1WithMessage("Incompatible sizes");
+  }
+  if(X.back()<=X[0]) { Throw1WithMessage("PiecewiseCubic needs increasing X1"); }
+  Coefficients.resize(5*(N-1));
+  double* c = &Coefficients[0];
+  if(Method==WU::NaturalCubicSpline) {
+    // Solve for the second derivatives y2, as in
+    // SplineInterpolator::sety2, keeping y2[k] in c[5k+2] and u[k] in
+    // c[5k+3], with only one division in the chain of dependencies
+    // from one point to the next
+    c[2] = c[3] = 0.0;
+    double DeltaLast = (Y1[1]-Y1[0])/(X[1]-X[0]);
+    for(int i=1; i<N-1; ++i) {
+      const double hm = X[i]-X[i-1], hp = X[i+1]-X[i];
+      const double Delta = (Y1[i+1]-Y1[i])/hp;
+      const double InvH2 = 1.0/(hm+hp);
+      const double sig = hm*InvH2;
+      const double InvP = 1.0/(sig*c[5*(i-1)+2]+2.0);
+      c[5*i+2] = (sig-1.0)*InvP;
+      c[5*i+3] = (6.0*(Delta-DeltaLast)*InvH2-sig*c[5*(i-1)+3])*InvP;
+      DeltaLast = Delta;
+    }
+    double y2Next = 0.0;
+    for(int k=N-2; k>=0; --k) {
+      c[5*k+2] = c[5*k+2]*y2Next+c[5*k+3];
+      y2Next = c[5*k+2];
+    }
+    for(int k=0; k<N-1; ++k) {
+      const double h = X[k+1]-X[k];
+      const double y2k = c[5*k+2], y2k1 = (k<N-2 ? c[5*(k+1)+2] : 0.0);
+      c[5*k] = Y1[k];
+      c[5*k+1] = (Y1[k+1]-Y1[k])/h - h*(2.0*y2k+y2k1)/6.0;
+      c[5*k+2] = y2k/2.0;
+      c[5*k+3] = (y2k1-y2k)/(6.0*h);
+    }
+  } else {
+    double m = (Y1[1]-Y1[0])/(X[1]-X[0]);
+    for(int k=0; k<N-1; ++k) {
+      const double h = X[k+1]-X[k];
+      const double Delta = (Y1[k+1]-Y1[k])/h;
+      const double mNext = (k<N-2 ? (Y1[k+2]-Y1[k])/(X[k+2]-X[k]) : Delta);
+      c[5*k] = Y1[k];
+      c[5*k+1] = m;
+      c[5*k+2] = (3.0*Delta-2.0*m-mNext)/h;
+      c[5*k+3] = (m+mNext-2.0*Delta)/(h*h);
+      m = mNext;
+    }
+  }
+  // The integrals up to the start of each interval
+  c[4] = 0.0;
+  for(int k=1; k<N-1; ++k) {
+    const double* cm = &c[5*(k-1)];
+    const double h = X[k]-X[k-1];
+    c[5*k+4] = cm[4] + h*(cm[0] + h*(cm[1]/2.0 + h*(cm[2]/3.0 + h*cm[3]/4.0)));
+  }
+}
+
+int WU::PiecewiseCubic::Interval(const double x) const {
+  const int N = X.size();
+  return std::max(0, std::min(N-2, int(std::upper_bound(X.begin(), X.end(), x)-X.begin())-1));
+}
+
+/// Evaluate the integral (Order=-1), value (0), or first or second
+/// derivative (1 or 2) of the cubic on interval k at t=x-X[k]
+static inline double EvaluateCubic(const double* c, const double t, const int Order) {
+  switch(Order) {
+  case 0:
+    return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+  case 1:
+    return c[1] + t*(2.0*c[2] + t*3.0*c[3]);
+  case 2:
+    return 2.0*c[2] + t*6.0*c[3];
+  default:
+    return c[4] + t*(c[0] + t*(c[1]/2.0 + t*(c[2]/3.0 + t*c[3]/4.0)));
+  }
+}
+
+double WU::PiecewiseCubic::Evaluate(const double x, const int Order) const {
+  if(X.size()<2) { Throw1WithMessage("Empty PiecewiseCubic"); }
+  const int k = Interval(x);
+  return EvaluateCubic(&Coefficients[5*k], x-X[k], Order);
+}
+
+void WU::PiecewiseCubic::Evaluate(const vector<double>& x, vector<double>& y, const int Order) const {
+  if(X.size()<2) { Throw1WithMessage("Empty PiecewiseCubic"); }
+  Bracketer Bracket(X);
+  if(y.size()!=x.size()) { y.resize(x.size()); }
+  const double* c = &Coefficients[0];
+  if(Order==0) {
+    // The most common case, without the switch
+    for(unsigned int i=0; i<x.size(); ++i) {
+      const int k = Bracket(x[i]);
+      const double t = x[i]-X[k];
+      const double* ck = &c[5*k];
+      y[i] = ck[0] + t*(ck[1] + t*(ck[2] + t*ck[3]));
+    }
+  } else {
+    for(unsigned int i=0; i<x.size(); ++i) {
+      const int k = Bracket(x[i]);
+      y[i] = EvaluateCubic(&c[5*k], x[i]-X[k], Order);
+    }
+  }
+}
+
+vector<double> WU::PiecewiseCubic::Evaluate(const vector<double>& x, const int Order) const {
+  vector<double> y(x.size());
+  Evaluate(x, y, Order);
+  return y;
+}
+
+void WU::PiecewiseCubic::ValueAndDerivative(const vector<double>& x, vector<double>& y, vector<double>& dydx) const {
+  if(X.size()<2) { Throw1WithMessage("Empty PiecewiseCubic"); }
+  Bracketer Bracket(X);
+  if(y.size()!=x.size()) { y.resize(x.size()); }
+  if(dydx.size()!=x.size()) { dydx.resize(x.size()); }
+  for(unsigned int i=0; i<x.size(); ++i) {
+    const int k = Bracket(x[i]);
+    const double t = x[i]-X[k];
+    const double* c = &Coefficients[5*k];
+    y[i] = c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+    dydx[i] = c[1] + t*(2.0*c[2] + t*3.0*c[3]);
+  }
+}
+
+/// The values of the first derivative at the knots
+vector<double> WU::PiecewiseCubic::Derivative() const {
+  const unsigned int N = X.size();
+  vector<double> D(N);
+  for(unsigned int k=0; k<N-1; ++k) {
+    D[k] = Coefficients[5*k+1];
+  }
+  D[N-1] = EvaluateCubic(&Coefficients[5*(N-2)], X[N-1]-X[N-2], 1);
+  return D;
+}
+
+/// The integral over all the knots
+double WU::PiecewiseCubic::Integral() const {
+  const unsigned int N = X.size();
+  return EvaluateCubic(&Coefficients[5*(N-2)], X[N-1]-X[N-2], -1);
+}
+
+/// Write the knots and coefficients as text, from which operator>>
+/// reproduces the object exactly
+std::ostream& WaveformUtilities::operator<<(std::ostream& os, const WU::PiecewiseCubic& P) {
+  const std::streamsize OldPrecision = os.precision(17);
+  const unsigned int N = P.X.size();
+  os << "PiecewiseCubic " << N << "\n";
+  for(unsigned int k=0; k+1<N; ++k) {
+    os << P.X[k];
+    for(unsigned int j=0; j<5; ++j) { os << " " << P.Coefficients[5*k+j]; }
+    os << "\n";
+  }
+  if(N>0) { os << P.X[N-1] << "\n"; }
+  os.precision(OldPrecision);
+  return os;
+}
+
+std::istream& WaveformUtilities::operator>>(std::istream& is, WU::PiecewiseCubic& P) {
+  std::string Name;
+  unsigned int N=0;
+  is >> Name >> N;
+  if(!is || Name!="PiecewiseCubic") { Throw1WithMessage("Input is not a PiecewiseCubic"); }
+  P.X.resize(N);
+  P.Coefficients.resize(N>0 ? 5*(N-1) : 0);
+  for(unsigned int k=0; k+1<N; ++k) {
+    is >> P.X[k];
+    for(unsigned int j=0; j<5; ++j) { is >> P.Coefficients[5*k+j]; }
+  }
+  if(N>0) { is >> P.X[N-1]; }
+  if(!is) { Throw1WithMessage("Failed to read PiecewiseCubic"); }
+  return is;
+}
+
+void WaveformUtilities::Resample(const vector<double>& X1, const vector<double>& Y1, const vector<double>& X2, vector<double>& Y2,
+                                 const WU::CubicInterpolant Method) {
+  WU::PiecewiseCubic(X1, Y1, Method).Value(X2, Y2);
+}
+
+vector<double> WaveformUtilities::Resample(const vector<double>& X1, const vector<double>& Y1, const vector<double>& X2,
+                                           const WU::CubicInterpolant Method) {
+  vector<double> Y2(X2.size());
+  WU::Resample(X1, Y1, X2, Y2, Method);
+  return Y2;
+}
+
+
 vector<double> WaveformUtilities::Interpolate(const vector<double>& X1, const vector<double>& Y1, const vector<double>& X2) {
   if(X1.size()==0) { Throw1WithMessage("X1.size()==0"); }
   if(X2.size()==0) { Throw1WithMessage("X2.size()==0"); }
@@ -29,9 +277,13 @@ void WaveformUtilities::Interpolate(const vector<double>& X1, const vector<doubl
   if(X1.size()==0) { Throw1WithMessage("X1.size()==0"); }
   if(X2.size()==0) { Throw1WithMessage("X2.size()==0"); }
   if(Y1.size()==0) { Throw1WithMessage("Y1.size()==0"); }
-  SplineInterpolator Spline(X1, Y1);
-  if(Y2.size()!=X2.size()) { Y2.resize(X2.size()); }
-  for(unsigned int i=0; i<Y2.size(); ++i) { Y2[i] = Spline.interp(X2[i]); }
+  if(X1.size()>1 && X1.back()>X1[0]) {
+    WU::Resample(X1, Y1, X2, Y2);
+  } else {
+    SplineInterpolator Spline(X1, Y1);
+    if(Y2.size()!=X2.size()) { Y2.resize(X2.size()); }
+    for(unsigned int i=0; i<Y2.size(); ++i) { Y2[i] = Spline.interp(X2[i]); }
+  }
   #ifdef DEBUG
   if(WU::hasnan(Y2)) {
     cerr << "Y2 (the result of the interpolation) has NaNs.  I'll look for where this is coming from..." << endl;
@@ -64,13 +316,20 @@ void WaveformUtilities::Interpolate(const vector<double>& X1, const vector<doubl
   if(X1.size()==0) { Throw1WithMessage("X1.size()==0"); }
   if(X2.size()==0) { Throw1WithMessage("X2.size()==0"); }
   if(Y1.size()==0) { Throw1WithMessage("Y1.size()==0"); }
-  SplineInterpolator Spline(X1, Y1);
-  if(Y2.size()!=X2.size()) { Y2.resize(X2.size()); }
-  for(unsigned int i=0; i<Y2.size(); ++i) {
-    if(X2[i]<X1[0] || X2[i]>X1.back()) {
-      Y2[i] = ExtrapVal;
-    } else {
-      Y2[i] = Spline.interp(X2[i]);
+  if(X1.size()>1 && X1.back()>X1[0]) {
+    WU::Resample(X1, Y1, X2, Y2);
+    for(unsigned int i=0; i<Y2.size(); ++i) {
+      if(X2[i]<X1[0] || X2[i]>X1.back()) { Y2[i] = ExtrapVal; }
+    }
+  } else {
+    SplineInterpolator Spline(X1, Y1);
+    if(Y2.size()!=X2.size()) { Y2.resize(X2.size()); }
+    for(unsigned int i=0; i<Y2.size(); ++i) {
+      if(X2[i]<X1[0] || X2[i]>X1.back()) {
+        Y2[i] = ExtrapVal;
+      } else {
+        Y2[i] = Spline.interp(X2[i]);
+      }
     }
   }
   #ifdef DEBUG
@@ -100,6 +359,55 @@ double WaveformUtilities::Interpolate(const vector<double>& X1, const vector<dou
   return y1[0];
 }
 
+inline double sign(const double x) {
+  return (x<0 ? -1.0 : 1.0);
+}
+
+double WaveformUtilities::FrequencyMatchingTime(const vector<double>& Time, const vector<double>& Omega,
+                                               const double T1, const double T2, const double omega) {
+  unsigned int i=0;
+  vector<double> NewTime(Time);
+  vector<double> NewOmega(Omega);
+  const double NewOmegaSign = sign(NewOmega[NewOmega.size()/2]);
+  try {
+    /// Only include data before T2
+    i=NewTime.size()-1;
+    while(NewTime[i]>T2 && i>0) { --i; }
+    if(i!=NewTime.size()-1) {
+      NewTime.erase(NewTime.begin()+i, NewTime.begin()+NewTime.size());
+      NewOmega.erase(NewOmega.begin()+i, NewOmega.begin()+NewOmega.size());
+    }
+    /// Only include data after T1
+    i=0;
+    while(i<NewTime.size() && NewTime[i]<T1) { ++i; }
+    if(i!=0) {
+      NewTime.erase(NewTime.begin(), NewTime.begin()+i);
+      NewOmega.erase(NewOmega.begin(), NewOmega.begin()+i);
+    }
+    /// Make sure the frequency gets up to abs(omega), but is strictly monotonically increasing before it
+    i=1;
+    while(i<NewOmega.size() && NewOmegaSign*NewOmega[i]<fabs(omega)) { ++i; }
+    while(i>0 && NewOmegaSign*NewOmega[i-1]<NewOmegaSign*NewOmega[i]) { --i; }
+    if(i!=1) {
+      NewTime.erase(NewTime.begin(), NewTime.begin()+i);
+      NewOmega.erase(NewOmega.begin(), NewOmega.begin()+i);
+    }
+    /// Make sure the frequency gets past abs(omega), and is strictly monotonically increasing afterward
+    i=1;
+    while(i<NewTime.size() && NewOmegaSign*NewOmega[i]<fabs(omega)) { ++i; }
+    while(i<NewTime.size() && NewOmegaSign*NewOmega[i]>NewOmegaSign*NewOmega[i-1]) { ++i; }
+    if(i!=1) {
+      NewTime.erase(NewTime.begin()+i, NewTime.begin()+NewTime.size());
+      NewOmega.erase(NewOmega.begin()+i, NewOmega.begin()+NewOmega.size());
+    }
+  } catch (char* str) {
+    cerr << "Bad news from FrequencyMatchingTime: " << str << endl
+         << "\nThe frequency requested is probably out of range of one or both of the Waveforms, or your t1 and t2 are too restrictive.\n" << endl;
+    exit(1);
+  }
+  return WU::Interpolate(NewOmega, NewTime, NewOmegaSign*fabs(omega));
+}
+
 
 
 Interpolator::Interpolator(const vector<double>& x, const vector<double>& y, int m)
@@ -127,7 +435,17 @@ Int Interpolator::locate(const Doub x) {
 }
 
 Int Interpolator::hunt(const Doub x) {
-  Int jl=jsav, jm, ju, inc=1;
+  Int jl=jsav;
+  const Int j=hunt(x, jl);
+  cor = abs(jl-jsav) > dj ? 0 : 1;
+  jsav = jl;
+  return j;
+}
+
+/// As above, but starting from, and updating, the caller's index jl
+/// instead of jsav
+Int Interpolator::hunt(const Doub x, Int& jl) const {
+  Int jm, ju, inc=1;
   if (n < 2 || mm < 2 || mm > n) Throw1WithMessage("Interpolator::hunt size error");
   Bool ascnd=(xx[n-1] >= xx[0]);
   if (jl < 0 || jl > n-1) {
@@ -164,8 +482,6 @@ Int Interpolator::hunt(const Doub x) {
     else
       ju=jm;
   }
-  cor = abs(jl-jsav) > dj ? 0 : 1;
-  jsav = jl;
   return MAX(0,MIN(n-mm,jl-((mm-2)>>1)));
 }
 
@@ -230,6 +546,11 @@ void SplineInterpolator::sety2(VecDoub_I &xv, VecDoub_I &yv, Doub yp1, Doub ypn)
 }
 
 Doub SplineInterpolator::rawinterp(Int jl, Doub x)
+{
+  return static_cast<const SplineInterpolator&>(*this).rawinterp(jl, x);
+}
+
+Doub SplineInterpolator::rawinterp(Int jl, Doub x) const
 {
   Int klo=jl,khi=jl+1;
   Doub y,h,b,a;
@@ -242,23 +563,178 @@ Doub SplineInterpolator::rawinterp(Int jl, Doub x)
   return y;
 }
 
+// <added>
+void SplineInterpolator::rawinterp(Int jl, Doub x, Doub& y, Doub& dydx)
+{
+  Int klo=jl,khi=jl+1;
+  Doub h,b,a;
+  h=xx[khi]-xx[klo];
+  if (h == 0.0) Throw1WithMessage("Bad input to routine SplineInterpolator::rawinterp");
+  a=(xx[khi]-x)/h;
+  b=(x-xx[klo])/h;
+  y=a*yy[klo]+b*yy[khi]+((a*a*a-a)*y2[klo]
+                         +(b*b*b-b)*y2[khi])*(h*h)/6.0;
+  dydx=(yy[khi]-yy[klo])/h+((1.0-3.0*a*a)*y2[klo]
+                            +(3.0*b*b-1.0)*y2[khi])*h/6.0;
+}
+// </added>
+
+
+
+MultiSplineInterpolator::MultiSplineInterpolator(const vector<double>& X1, const vector<double>& X2)
+  : N1(X1.size()), InvH(N1>0 ? N1-1 : 0), SixOverDX(N1), Sig(N1), InvP(N1), C(N1, 0.0),
+    Lo(X2.size()), WLo(X2.size()), WHi(X2.size()), W2Lo(X2.size()), W2Hi(X2.size()), Outside(X2.size()),
+    u(N1, 0.0), y2(N1, 0.0)
+{
+  if(N1<2) { Throw1WithMessage("MultiSplineInterpolator needs at least two points"); }
+  if(X2.size()==0) { Throw1WithMessage("X2.size()==0"); }
+  if(X1.back()<=X1[0]) { Throw1WithMessage("MultiSplineInterpolator needs increasing X1"); }
+
+  // The parts of SplineInterpolator::sety2 that do not depend on Y
+  for(unsigned int i=0; i<N1-1; ++i) {
+    InvH[i] = 1.0/(X1[i+1]-X1[i]);
+  }
+  for(unsigned int i=1; i<N1-1; ++i) {
+    Sig[i] = (X1[i]-X1[i-1])/(X1[i+1]-X1[i-1]);
+    InvP[i] = 1.0/(Sig[i]*C[i-1]+2.0);
+    C[i] = (Sig[i]-1.0)*InvP[i];
+    SixOverDX[i] = 6.0/(X1[i+1]-X1[i-1]);
+  }
+
+  // The intervals and weights, as in SplineInterpolator::rawinterp
+  Bracketer Bracket(X1);
+  for(unsigned int i=0; i<X2.size(); ++i) {
+    const double x = X2[i];
+    const int klo = Bracket(x);
+    const double h = X1[klo+1]-X1[klo];
+    const double a = (X1[klo+1]-x)*InvH[klo];
+    const double b = (x-X1[klo])*InvH[klo];
+    Lo[i] = klo;
+    WLo[i] = a;
+    WHi[i] = b;
+    W2Lo[i] = (a*a*a-a)*(h*h)/6.0;
+    W2Hi[i] = (b*b*b-b)*(h*h)/6.0;
+    Outside[i] = (x<X1[0] || x>X1.back());
+  }
+}
+
+/// The second derivatives of the natural spline through Y1, from the
+/// factored tridiagonal system
+void MultiSplineInterpolator::SetY2(const vector<double>& Y1) {
+  if(Y1.size()!=N1) {
+    cerr << "\nY1.size()=" << Y1.size() << "\tX1.size()=" << N1 << endl;
+    Throw1WithMessage("Incompatible sizes");
+  }
+  const double* y = &Y1[0];
+  for(unsigned int i=1; i<N1-1; ++i) {
+    const double d = (y[i+1]-y[i])*InvH[i] - (y[i]-y[i-1])*InvH[i-1];
+    u[i] = (d*SixOverDX[i]-Sig[i]*u[i-1])*InvP[i];
+  }
+  y2[N1-1] = 0.0;
+  for(int k=N1-2; k>=0; --k) {
+    y2[k] = C[k]*y2[k+1]+u[k];
+  }
+}
+
+void MultiSplineInterpolator::operator()(const vector<double>& Y1, vector<double>& Y2) {
+  SetY2(Y1);
+  const unsigned int N2 = Lo.size();
+  if(Y2.size()!=N2) { Y2.resize(N2); }
+  const double* y = &Y1[0];
+  const double* d2 = &y2[0];
+  for(unsigned int i=0; i<N2; ++i) {
+    const int k = Lo[i];
+    Y2[i] = WLo[i]*y[k] + WHi[i]*y[k+1] + W2Lo[i]*d2[k] + W2Hi[i]*d2[k+1];
+  }
+}
+
+void MultiSplineInterpolator::operator()(const vector<double>& Y1, vector<double>& Y2, const double ExtrapVal) {
+  this->operator()(Y1, Y2);
+  for(unsigned int i=0; i<Y2.size(); ++i) {
+    if(Outside[i]) { Y2[i] = ExtrapVal; }
+  }
+}
+
+vector<double> MultiSplineInterpolator::operator()(const vector<double>& Y1) {
+  vector<double> Y2(Lo.size());
+  this->operator()(Y1, Y2);
+  return Y2;
+}
+
 
 
 std::vector<double> WaveformUtilities::SplineIntegral(const std::vector<double>& X1, const std::vector<double>& Y1) {
+  if(X1.size()>1 && X1.back()>X1[0]) {
+    return WU::PiecewiseCubic(X1, Y1).Integral(X1);
+  }
   SplineIntegrator I(X1, Y1);
   return I();
 }
 
 std::vector<double> WaveformUtilities::SplineIntegral(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2) {
+  if(X1.size()>1 && X1.back()>X1[0]) {
+    return WU::PiecewiseCubic(X1, Y1).Integral(X2);
+  }
   SplineIntegrator I(X1, Y1);
   return I(X2);
 }
 
 double WaveformUtilities::SplineCumulativeIntegral(const std::vector<double>& X1, const std::vector<double>& Y1) {
+  if(X1.size()>1 && X1.back()>X1[0]) {
+    return WU::PiecewiseCubic(X1, Y1).Integral();
+  }
   SplineIntegrator I(X1, Y1);
   return I.CumulativeIntegral();
 }
 
+/// Return weights w such that the integral over X1 of the natural
+/// cubic spline through (X1, Y1) is sum(w*Y1), for any Y1.  The
+/// integral is linear in Y1 and in the second derivatives y2, which
+/// solve A.y2=B.Y1 with A symmetric, so the weights are found with a
+/// single tridiagonal solve A.z=q, where q multiplies y2 in the
+/// integral.
+std::vector<double> WaveformUtilities::SplineIntegrationWeights(const std::vector<double>& X1) {
+  const unsigned int N = X1.size();
+  if(N<2) { Throw1WithMessage("SplineIntegrationWeights needs at least two points"); }
+  vector<double> w(N, 0.0);
+  vector<double> h(N-1);
+  for(unsigned int j=0; j<N-1; ++j) {
+    h[j] = X1[j+1]-X1[j];
+    w[j] += h[j]/2.;
+    w[j+1] += h[j]/2.;
+  }
+  if(N==2) { return w; }
+  /// Solve the symmetric tridiagonal system for the interior points
+  /// j=1..N-2, with the Thomas algorithm
+  const unsigned int n = N-2;
+  vector<double> z(n), c(n);
+  for(unsigned int k=0; k<n; ++k) {
+    const unsigned int j = k+1;
+    const double q = (h[j-1]*h[j-1]*h[j-1] + h[j]*h[j]*h[j])/24.;
+    const double diag = (h[j-1]+h[j])/3.;
+    const double lower = h[j-1]/6.;
+    if(k==0) {
+      c[k] = h[j]/6./diag;
+      z[k] = q/diag;
+    } else {
+      const double den = diag - lower*c[k-1];
+      c[k] = h[j]/6./den;
+      z[k] = (q - lower*z[k-1])/den;
+    }
+  }
+  for(int k=n-2; k>=0; --k) {
+    z[k] -= c[k]*z[k+1];
+  }
+  /// w = p - B^T.z, where row j of B.Y1 is (Y1[j+1]-Y1[j])/h[j] - (Y1[j]-Y1[j-1])/h[j-1]
+  for(unsigned int k=0; k<n; ++k) {
+    const unsigned int j = k+1;
+    w[j+1] -= z[k]/h[j];
+    w[j]   += z[k]*(1./h[j] + 1./h[j-1]);
+    w[j-1] -= z[k]/h[j-1];
+  }
+  return w;
+}
+
 void SplineIntegrator::SetUpIntegrationCoefficients() {
   for(unsigned int j=0; j<xx.size()-1; ++j) {
     const double xxj = xx[j];
@@ -2,18 +2,90 @@
 #define INTERPOLATE_HPP
 
 #include <vector>
+#include <iostream>
 
 namespace WaveformUtilities {
 
+  /// The piecewise cubics available to Resample: the natural cubic
+  /// spline, or the Catmull-Rom spline, whose slopes are the centered
+  /// differences of the data, so that no tridiagonal system is solved
+  /// (at the cost of a discontinuous second derivative).
+  enum CubicInterpolant { NaturalCubicSpline, CatmullRomSpline };
+
+  /// A piecewise cubic through (X,Y), for increasing X.  The knots are
+  /// stored, along with five numbers for each interval k in one
+  /// contiguous array: the coefficients of Y[k] + c1*t + c2*t^2 +
+  /// c3*t^3, with t=x-X[k], and the integral from X[0] to X[k].  The
+  /// value, first and second derivatives, and integral from X[0] at
+  /// any x then cost a bracketing of x and a few operations.  The
+  /// vector versions bracket sorted points by advancing from the last
+  /// one.  Beyond the knots, the end intervals' cubics are used.  All
+  /// queries are const, so one fit may be shared freely; it may also
+  /// be written to a stream and read back exactly.
+  class PiecewiseCubic {
+    friend std::ostream& operator<<(std::ostream& os, const PiecewiseCubic& P);
+    friend std::istream& operator>>(std::istream& is, PiecewiseCubic& P);
+  private:
+    std::vector<double> X, Coefficients;
+    int Interval(const double x) const;
+    double Evaluate(const double x, const int Order) const;
+    void Evaluate(const std::vector<double>& x, std::vector<double>& y, const int Order) const;
+    std::vector<double> Evaluate(const std::vector<double>& x, const int Order) const;
+
+  public:
+    PiecewiseCubic();
+    PiecewiseCubic(const std::vector<double>& X1, const std::vector<double>& Y1, const CubicInterpolant Method=NaturalCubicSpline);
+
+    const std::vector<double>& Knots() const { return X; }
+
+    double Value(const double x) const { return Evaluate(x, 0); }
+    double Derivative(const double x) const { return Evaluate(x, 1); }
+    double SecondDerivative(const double x) const { return Evaluate(x, 2); }
+    double Integral(const double x) const { return Evaluate(x, -1); }
+
+    void Value(const std::vector<double>& x, std::vector<double>& y) const { Evaluate(x, y, 0); }
+    void Derivative(const std::vector<double>& x, std::vector<double>& y) const { Evaluate(x, y, 1); }
+    void SecondDerivative(const std::vector<double>& x, std::vector<double>& y) const { Evaluate(x, y, 2); }
+    void Integral(const std::vector<double>& x, std::vector<double>& y) const { Evaluate(x, y, -1); }
+
+    std::vector<double> Value(const std::vector<double>& x) const { return Evaluate(x, 0); }
+    std::vector<double> Derivative(const std::vector<double>& x) const { return Evaluate(x, 1); }
+    std::vector<double> SecondDerivative(const std::vector<double>& x) const { return Evaluate(x, 2); }
+    std::vector<double> Integral(const std::vector<double>& x) const { return Evaluate(x, -1); }
+
+    void ValueAndDerivative(const std::vector<double>& x, std::vector<double>& y, std::vector<double>& dydx) const;
+
+    std::vector<double> Derivative() const;
+    double Integral() const;
+  };
+  std::ostream& operator<<(std::ostream& os, const PiecewiseCubic& P);
+  std::istream& operator>>(std::istream& is, PiecewiseCubic& P);
+
+  /// Interpolate Y1(X1), for increasing X1, to X2, with a
+  /// PiecewiseCubic.  The Interpolate and SplineIntegral functions
+  /// below use the natural spline from here whenever X1 is increasing.
+  void Resample(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2, std::vector<double>& Y2,
+                const CubicInterpolant Method=NaturalCubicSpline);
+  std::vector<double> Resample(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2,
+                               const CubicInterpolant Method=NaturalCubicSpline);
+
   std::vector<double> Interpolate(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2);
   void Interpolate(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2, std::vector<double>& Y2);
   std::vector<double> Interpolate(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2, const double ExtrapVal);
   void Interpolate(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2, std::vector<double>& Y2, const double ExtrapVal);
   double Interpolate(const std::vector<double>& X1, const std::vector<double>& Y1, const double& X2);
 
+  /// Find the time at which the frequency Omega(Time) first reaches
+  /// the magnitude of omega between T1 and T2, interpolating over the
+  /// monotonic stretch of data around that point.  This is how
+  /// Waveform::AlignTo_F and HybridPipeline align their Waveforms.
+  double FrequencyMatchingTime(const std::vector<double>& Time, const std::vector<double>& Omega,
+                               const double T1, const double T2, const double omega);
+
   std::vector<double> SplineIntegral(const std::vector<double>& X1, const std::vector<double>& Y1);
   std::vector<double> SplineIntegral(const std::vector<double>& X1, const std::vector<double>& Y1, const std::vector<double>& X2);
   double SplineCumulativeIntegral(const std::vector<double>& X1, const std::vector<double>& Y1);
+  std::vector<double> SplineIntegrationWeights(const std::vector<double>& X1);
 
   class Interpolator {
   protected:
@@ -31,6 +103,7 @@ namespace WaveformUtilities {
 
     int locate(const double x);
     int hunt(const double x);
+    int hunt(const double x, int& jlo) const;
 
     virtual double rawinterp(int jlo, double x) = 0;
   };
@@ -56,6 +129,51 @@ namespace WaveformUtilities {
 
     void sety2(const std::vector<double>& xv, const std::vector<double>& yv, double yp1, double ypn);
     double rawinterp(int jl, double xv);
+    double rawinterp(int jl, double xv) const;
+
+    using Interpolator::interp;
+    /// Evaluate the spline at x, hunting from the caller's index jlo
+    /// (which is updated) rather than from the stored one.  This does
+    /// not change the interpolator, so one may be shared by several
+    /// callers, each with its own index.
+    double interp(double x, int& jlo) const {
+      return rawinterp(hunt(x, jlo), x);
+    }
+    /// Evaluate the spline and its derivative at x
+    void interp(double x, double& y, double& dydx) {
+      int jlo = cor ? hunt(x) : locate(x);
+      rawinterp(jlo, x, y, dydx);
+    }
+    void rawinterp(int jl, double xv, double& y, double& dydx);
+  };
+
+  /// Natural cubic-spline interpolation of many data series that share
+  /// the (increasing) abscissas X1, onto the abscissas X2.  Everything
+  /// that depends only on X1 and X2 -- the factorization of the
+  /// tridiagonal system for the second derivatives, the interval of X1
+  /// containing each X2[i], and the interpolation weights there -- is
+  /// computed once, in the constructor.  Each series then costs one
+  /// forward-and-back substitution and one pass over X2.  The results
+  /// are the same, to roundoff, as those of SplineInterpolator.
+  class MultiSplineInterpolator {
+  private:
+    unsigned int N1;
+    std::vector<double> InvH, SixOverDX, Sig, InvP, C;
+    std::vector<int> Lo;
+    std::vector<double> WLo, WHi, W2Lo, W2Hi;
+    std::vector<char> Outside;
+    std::vector<double> u, y2;
+    void SetY2(const std::vector<double>& Y1);
+
+  public:
+    MultiSplineInterpolator(const std::vector<double>& X1, const std::vector<double>& X2);
+
+    unsigned int NIn() const { return N1; }
+    unsigned int NOut() const { return Lo.size(); }
+
+    void operator()(const std::vector<double>& Y1, std::vector<double>& Y2);
+    void operator()(const std::vector<double>& Y1, std::vector<double>& Y2, const double ExtrapVal);
+    std::vector<double> operator()(const std::vector<double>& Y1);
   };
 
   class SplineIntegrator : public SplineInterpolator {
@@ -0,0 +1,99 @@
+#include "MinimalGrid.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "NumericalRecipes.hpp"
+#include "Utilities.hpp"
+
+using namespace std;
+namespace WU = WaveformUtilities;
+using WU::MinimalGridCompressor;
+
+MinimalGridCompressor::MinimalGridCompressor(const unsigned int nModes, const double magTol, const double argTol)
+  : NModes(nModes), MagTol(magTol), ArgTol(argTol), NSamples(0), NKept(0), IStart(0), tStart(0.0), tPrevious(0.0),
+    MagStart(nModes), ArgStart(nModes), MagPrevious(nModes), ArgPrevious(nModes),
+    MagSlopeMin(nModes), MagSlopeMax(nModes), ArgSlopeMin(nModes), ArgSlopeMax(nModes),
+    Indices(), Finished(false)
+{ }
+
+/// Start the next interval at the previous sample, which is kept
+void MinimalGridCompressor::Restart(const unsigned int IPrevious) {
+  IStart = IPrevious;
+  tStart = tPrevious;
+  MagStart = MagPrevious;
+  ArgStart = ArgPrevious;
+  for(unsigned int i=0; i<NModes; ++i) {
+    MagSlopeMin[i] = ArgSlopeMin[i] = -numeric_limits<double>::max();
+    MagSlopeMax[i] = ArgSlopeMax[i] = numeric_limits<double>::max();
+  }
+  Indices.push_back(IStart);
+  ++NKept;
+}
+
+/// Narrow the range of slopes from the start of the interval to those
+/// that pass within tolerance of the sample (t,Mag,Arg)
+void MinimalGridCompressor::Narrow(const double t, const vector<double>& Mag, const vector<double>& Arg) {
+  const double InvDt = 1.0/(t-tStart);
+  for(unsigned int i=0; i<NModes; ++i) {
+    const double MagErr = MagTol*fabs(Mag[i]);
+    MagSlopeMin[i] = max(MagSlopeMin[i], (Mag[i]-MagErr-MagStart[i])*InvDt);
+    MagSlopeMax[i] = min(MagSlopeMax[i], (Mag[i]+MagErr-MagStart[i])*InvDt);
+    ArgSlopeMin[i] = max(ArgSlopeMin[i], (Arg[i]-ArgTol-ArgStart[i])*InvDt);
+    ArgSlopeMax[i] = min(ArgSlopeMax[i], (Arg[i]+ArgTol-ArgStart[i])*InvDt);
+  }
+}
+
+void MinimalGridCompressor::Add(const double t, const vector<double>& Mag, const vector<double>& Arg) {
+  if(Mag.size()!=NModes || Arg.size()!=NModes) {
+    cerr << "\nNModes=" << NModes << "\tMag.size()=" << Mag.size() << "\tArg.size()=" << Arg.size() << endl;
+    Throw1WithMessage("Wrong number of modes");
+  }
+  if(Finished) {
+    Throw1WithMessage("Cannot add samples after Finish()");
+  }
+  if(NSamples>0 && !(t>tPrevious)) {
+    cerr << "\nt=" << t << " follows t=" << tPrevious << endl;
+    Throw1WithMessage("Times must increase");
+  }
+  const unsigned int I = NSamples++;
+  if(I==0) {
+    // The first sample is kept, and starts the first interval
+    tPrevious = t;
+    MagPrevious = Mag;
+    ArgPrevious = Arg;
+    Restart(0);
+    return;
+  }
+  if(I > IStart+1) {
+    // Check that the interval from the start to this sample passes
+    // within tolerance of every sample between; if not, end the
+    // interval at the previous sample, which certainly did
+    const double InvDt = 1.0/(t-tStart);
+    bool Fits = true;
+    for(unsigned int i=0; i<NModes && Fits; ++i) {
+      const double MagSlope = (Mag[i]-MagStart[i])*InvDt;
+      const double ArgSlope = (Arg[i]-ArgStart[i])*InvDt;
+      Fits = (MagSlope>=MagSlopeMin[i] && MagSlope<=MagSlopeMax[i] && ArgSlope>=ArgSlopeMin[i] && ArgSlope<=ArgSlopeMax[i]);
+    }
+    if(!Fits) { Restart(I-1); }
+  }
+  Narrow(t, Mag, Arg);
+  tPrevious = t;
+  MagPrevious = Mag;
+  ArgPrevious = Arg;
+}
+
+void MinimalGridCompressor::Finish() {
+  if(Finished) { return; }
+  Finished = true;
+  if(NSamples>1) {
+    Indices.push_back(NSamples-1);
+    ++NKept;
+  }
+}
+
+void MinimalGridCompressor::TakeIndices(vector<unsigned int>& Kept) {
+  Kept.clear();
+  Kept.swap(Indices);
+}
@@ -0,0 +1,63 @@
+#ifndef MINIMALGRID_HPP
+#define MINIMALGRID_HPP
+
+#include <vector>
+
+namespace WaveformUtilities {
+
+  /// Choose a subset of the samples of a set of modes, such that
+  /// linear interpolation between the kept samples reproduces every
+  /// sample of every mode to within the tolerances: MagTol relative
+  /// to the magnitude, and ArgTol absolute in the phase.  The first
+  /// and last samples are always kept.
+  ///
+  /// The samples are given one time at a time, as they are read or
+  /// generated, and the data is passed over once.  For each mode, the
+  /// compressor keeps the last kept sample, and the range of slopes
+  /// from it that pass within tolerance of every sample since; a new
+  /// sample whose own slope lies outside that range (for any mode)
+  /// means the sample before it is kept and becomes the new start.
+  /// So each sample costs a few operations per mode, and the memory
+  /// used does not grow with the length of the data, apart from the
+  /// indices kept, which may be taken as they are found:
+  ///
+  ///   MinimalGridCompressor Compressor(NModes, MagTol, ArgTol);
+  ///   while( ... ) {
+  ///     Compressor.Add(t, Mag, Arg);
+  ///     Compressor.TakeIndices(Kept); // only the new indices
+  ///     ...
+  ///   }
+  ///   Compressor.Finish();
+  ///   Compressor.TakeIndices(Kept);
+  class MinimalGridCompressor {
+  private:
+    const unsigned int NModes;
+    const double MagTol, ArgTol;
+    unsigned int NSamples, NKept, IStart;
+    double tStart, tPrevious;
+    std::vector<double> MagStart, ArgStart, MagPrevious, ArgPrevious;
+    std::vector<double> MagSlopeMin, MagSlopeMax, ArgSlopeMin, ArgSlopeMax;
+    std::vector<unsigned int> Indices;
+    bool Finished;
+    void Restart(const unsigned int IPrevious);
+    void Narrow(const double t, const std::vector<double>& Mag, const std::vector<double>& Arg);
+  public:
+    MinimalGridCompressor(const unsigned int NModes, const double MagTol=1.e-5, const double ArgTol=1.e-5);
+
+    /// Add the sample at time t (later than the last one), with one
+    /// element of Mag and Arg for each mode
+    void Add(const double t, const std::vector<double>& Mag, const std::vector<double>& Arg);
+    /// Keep the last sample; no more may be added
+    void Finish();
+
+    /// The number of samples given, and the number kept so far
+    unsigned int NSamplesAdded() const { return NSamples; }
+    unsigned int NSamplesKept() const { return NKept; }
+    /// Replace the contents of Kept with the indices kept since the
+    /// last call, in increasing order
+    void TakeIndices(std::vector<unsigned int>& Kept);
+  };
+
+} // namespace WaveformUtilities
+
+#endif // MINIMALGRID_HPP
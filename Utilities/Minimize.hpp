@@ -14,6 +14,8 @@ namespace WaveformUtilities {
   ///   xmin = Minimizer.minimize(func); // xmin is the location of the minimum
   /// Bad results are obtained if there is no real minimum in [a,b].  Tolerance should
   /// not be less than about sqrt(mach. prec.) unless you know what you're doing.
+  /// Dbrent is used in the same way, when the functor also has a method df(x)
+  /// returning the derivative.
 
   struct Bracketmethod {
     Doub ax,bx,cx,fa,fb,fc;
@@ -155,6 +157,94 @@ namespace WaveformUtilities {
     }
   };
 
+  struct Dbrent : Bracketmethod {
+    Doub xmin,fmin;
+    const Doub tol;
+    Dbrent(const Doub toll=3.0e-8) : tol(toll) {}
+    template <class T>
+    Doub minimize(T &funcd)
+    {
+      const Int ITMAX=100;
+      const Doub ZEPS=numeric_limits<Doub>::epsilon()*1.0e-3;
+      Bool ok1,ok2;
+      Doub a,b,d=0.0,d1,d2,du,dv,dw,dx,e=0.0;
+      Doub fu,fv,fw,fx,olde,tol1,tol2,u,u1,u2,v,w,x,xm;
+
+      a=(ax < cx ? ax : cx);
+      b=(ax > cx ? ax : cx);
+      x=w=v=bx;
+      fw=fv=fx=funcd(x);
+      dw=dv=dx=funcd.df(x);
+      for (Int iter=0;iter<ITMAX;iter++) {
+        xm=0.5*(a+b);
+        tol1=tol*std::abs(x)+ZEPS;
+        tol2=2.0*tol1;
+        if (std::abs(x-xm) <= (tol2-0.5*(b-a))) {
+          fmin=fx;
+          return xmin=x;
+        }
+        if (std::abs(e) > tol1) {
+          d1=2.0*(b-a);
+          d2=d1;
+          if (dw != dx) d1=(w-x)*dx/(dx-dw);
+          if (dv != dx) d2=(v-x)*dx/(dx-dv);
+          u1=x+d1;
+          u2=x+d2;
+          ok1 = (a-u1)*(u1-b) > 0.0 && dx*d1 <= 0.0;
+          ok2 = (a-u2)*(u2-b) > 0.0 && dx*d2 <= 0.0;
+          olde=e;
+          e=d;
+          if (ok1 || ok2) {
+            if (ok1 && ok2)
+              d=(std::abs(d1) < std::abs(d2) ? d1 : d2);
+            else if (ok1)
+              d=d1;
+            else
+              d=d2;
+            if (std::abs(d) <= std::abs(0.5*olde)) {
+              u=x+d;
+              if (u-a < tol2 || b-u < tol2)
+                d=SIGN(tol1,xm-x);
+            } else {
+              d=0.5*(e=(dx >= 0.0 ? a-x : b-x));
+            }
+          } else {
+            d=0.5*(e=(dx >= 0.0 ? a-x : b-x));
+          }
+        } else {
+          d=0.5*(e=(dx >= 0.0 ? a-x : b-x));
+        }
+        if (std::abs(d) >= tol1) {
+          u=x+d;
+          fu=funcd(u);
+        } else {
+          u=x+SIGN(tol1,d);
+          fu=funcd(u);
+          if (fu > fx) {
+            fmin=fx;
+            return xmin=x;
+          }
+        }
+        du=funcd.df(u);
+        if (fu <= fx) {
+          if (u >= x) a=x; else b=x;
+          mov3(v,fv,dv,w,fw,dw);
+          mov3(w,fw,dw,x,fx,dx);
+          mov3(x,fx,dx,u,fu,du);
+        } else {
+          if (u < x) a=u; else b=u;
+          if (fu <= fw || w == x) {
+            mov3(v,fv,dv,w,fw,dw);
+            mov3(w,fw,dw,u,fu,du);
+          } else if (fu < fv || v == x || v == w) {
+            mov3(v,fv,dv,u,fu,du);
+          }
+        }
+      }
+      Throw1WithMessage("Too many iterations in dbrent");
+    }
+  };
+
 }
 
 #endif // MINIMIZE_HPP
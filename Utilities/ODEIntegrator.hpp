@@ -8,15 +8,102 @@
 ///   Also, an optional function pointer may be given, to be evaluated at
 ///   each time step, returning 'false' if the integration should stop.
 ///   Otherwise, the interface is just as in Numerical Recipes.
+///   The Output object may also be given a pointer to a DenseTrajectory,
+///   which will store the dense-output coefficients of every step.
+///   Alternatively to the boolean test, an event function may be given;
+///   the integration stops when it changes sign from positive to
+///   non-positive, and the location of the event is refined using the
+///   stepper's dense output, so that the last point saved lies on the
+///   event (to within roundoff).
+///   Finally, the Output object may be given an ODEWorkspace, from
+///   which it and the Odeint and stepper objects borrow their storage,
+///   so that a series of integrations need not allocate memory.
+///   The steppers count their rejected steps and right-hand-side
+///   evaluations, which may be recorded in an ODEStatistics object.
 
 #include "NumericalRecipes.hpp"
 #include "Utilities.hpp"
 #include "VectorFunctions.hpp"
+#include "DenseTrajectory.hpp"
+#include "ODEStatistics.hpp"
+#include <ctime>
 
 namespace WaveformUtilities {
   using std::abs;
   using std::sqrt;
 
+  // <added>
+  /// Storage that may be reused by a series of integrations.  Once it
+  /// has grown to the sizes they need, an integration (without a
+  /// DenseTrajectory) makes no heap allocations.  The vectors and
+  /// matrices are lent by swapping, and returned when the borrowers
+  /// are destroyed.  A workspace must only be used by one integration
+  /// at a time, so concurrent integrations need one workspace each.
+  class ODEWorkspace {
+  private:
+    VecDoub xsave;
+    MatDoub ysave;
+    std::vector<VecDoub> Vectors;
+    std::vector<MatDoub> Matrices;
+    Int NVectorsLent, NMatricesLent;
+    ODEWorkspace(const ODEWorkspace&);
+    ODEWorkspace& operator=(const ODEWorkspace&);
+    friend class ODEWorkspaceLoan;
+    friend struct Output;
+  public:
+    ODEWorkspace() : NVectorsLent(0), NMatricesLent(0) { }
+  };
+
+  /// The storage borrowed from an ODEWorkspace by one object.  Without
+  /// a workspace, Borrow just resizes its argument.  The borrower must
+  /// call Return in its destructor, while the borrowed members exist.
+  class ODEWorkspaceLoan {
+  private:
+    static const Int MAXV=32, MAXM=4;
+    ODEWorkspace* ws;
+    Int nv, nm;
+    VecDoub* v[MAXV];
+    MatDoub* m[MAXM];
+    Int iv[MAXV], im[MAXM];
+    ODEWorkspaceLoan(const ODEWorkspaceLoan&);
+    ODEWorkspaceLoan& operator=(const ODEWorkspaceLoan&);
+  public:
+    ODEWorkspaceLoan(ODEWorkspace* wss) : ws(wss), nv(0), nm(0) { }
+    VecDoub& Borrow(VecDoub& a, const Int n) {
+      if (ws != NULL) {
+        if (nv == MAXV) Throw1WithMessage("Too many vectors borrowed from ODEWorkspace");
+        const Int i=ws->NVectorsLent++;
+        if (Int(ws->Vectors.size()) <= i) ws->Vectors.resize(i+1);
+        a.swap(ws->Vectors[i]);
+        v[nv]=&a;
+        iv[nv++]=i;
+      }
+      a.resize(n);
+      return a;
+    }
+    MatDoub& Borrow(MatDoub& a, const Int nrows, const Int ncols) {
+      if (ws != NULL) {
+        if (nm == MAXM) Throw1WithMessage("Too many matrices borrowed from ODEWorkspace");
+        const Int i=ws->NMatricesLent++;
+        if (Int(ws->Matrices.size()) <= i) ws->Matrices.resize(i+1);
+        a.swap(ws->Matrices[i]);
+        m[nm]=&a;
+        im[nm++]=i;
+      }
+      a.resize(nrows,ncols);
+      return a;
+    }
+    void Return() {
+      if (ws == NULL) return;
+      for (Int i=0; i<nv; i++) v[i]->swap(ws->Vectors[iv[i]]);
+      for (Int i=0; i<nm; i++) m[i]->swap(ws->Matrices[im[i]]);
+      ws->NVectorsLent -= nv;
+      ws->NMatricesLent -= nm;
+      nv=nm=0;
+    }
+  };
+  // </added>
+
   struct Output {
     Int kmax;
     Int nvar;
@@ -26,11 +113,58 @@ namespace WaveformUtilities {
     Doub x1,x2,xout,dxout;
     VecDoub xsave;
     MatDoub ysave;
-    Output() : kmax(-1),dense(false),count(0) {}
+    DenseTrajectory* trajectory; // <added />
+    ODEWorkspace* workspace; // <added />
+  // <added>
+  private:
+    /// A copy would swap the borrowed xsave and ysave back into the
+    /// workspace a second time on destruction.
+    Output(const Output&);
+    Output& operator=(const Output&);
+  public:
+  // </added>
+    Output() : kmax(-1),dense(false),count(0),trajectory(NULL),workspace(NULL) {}
     //Output(const Int nsavee) : kmax(500),nsave(nsavee),count(0),xsave(kmax) { // <replaced />
-    Output(const Int nsavee) : kmax(8000),nsave(nsavee),count(0),xsave(kmax) { // <replacement /> (The cost of resizes is hurting me)
+    Output(const Int nsavee) : kmax(8000),nsave(nsavee),count(0),xsave(kmax),trajectory(NULL),workspace(NULL) { // <replacement /> (The cost of resizes is hurting me)
+      dense = nsave > 0 ? true : false;
+    }
+    // <added>
+    /// Borrow xsave and ysave from the workspace until destruction.
+    /// The results must then be copied out, as by extract_x and
+    /// extract_y, rather than swapped.
+    Output(const Int nsavee, ODEWorkspace* ws) : kmax(8000),nsave(nsavee),count(0),trajectory(NULL),workspace(ws) {
       dense = nsave > 0 ? true : false;
+      if (workspace != NULL) {
+        xsave.swap(workspace->xsave);
+        ysave.swap(workspace->ysave);
+      }
+      xsave.resize(kmax);
+    }
+    ~Output() {
+      if (workspace != NULL) {
+        xsave.swap(workspace->xsave);
+        ysave.swap(workspace->ysave);
+      }
     }
+    /// Move the saved values of x, or of variable i, into the given
+    /// vector; with a workspace, they are copied instead.
+    void extract_x(VecDoub &x) {
+      if (workspace != NULL) {
+        x.assign(xsave.begin(), xsave.begin()+count);
+      } else {
+        xsave.resize(count);
+        x.swap(xsave);
+      }
+    }
+    void extract_y(const Int i, VecDoub &yi) {
+      if (workspace != NULL) {
+        yi.assign(ysave[i].begin(), ysave[i].begin()+count);
+      } else {
+        ysave[i].resize(count);
+        yi.swap(ysave[i]);
+      }
+    }
+    // </added>
     void init(const Int neqn, const Doub xlo, const Doub xhi) {
       nvar=neqn;
       if (kmax == -1) return;
@@ -43,18 +177,23 @@ namespace WaveformUtilities {
       }
     }
     void resize() {
-      Int kold=kmax;
       //kmax *= 2; // <replaced />
       kmax *= 4; // <replacement />
-      VecDoub tempvec(xsave);
+      // <replaced>
+      // VecDoub tempvec(xsave);
+      // xsave.resize(kmax);
+      // for (Int k=0; k<kold; k++)
+      //   xsave[k]=tempvec[k];
+      // MatDoub tempmat(ysave);
+      // ysave.resize(nvar,kmax);
+      // for (Int i=0; i<nvar; i++)
+      //   for (Int k=0; k<kold; k++)
+      //     ysave[i][k]=tempmat[i][k];
+      // </replaced>
+      // <replacement> (std::vector keeps its contents, and may already have the capacity)
       xsave.resize(kmax);
-      for (Int k=0; k<kold; k++)
-        xsave[k]=tempvec[k];
-      MatDoub tempmat(ysave);
       ysave.resize(nvar,kmax);
-      for (Int i=0; i<nvar; i++)
-        for (Int k=0; k<kold; k++)
-          ysave[i][k]=tempmat[i][k];
+      // </replacement>
     }
     template <class Stepper>
     void save_dense(Stepper &s, const Doub xout, const Doub h) {
@@ -78,6 +217,7 @@ namespace WaveformUtilities {
         save(x,y);
         xout += dxout;
       } else {
+        if (trajectory != NULL) trajectory->AddStep(s); // <added />
         while ((x-xout)*(x2-x1) > 0.0) {
           save_dense(s,xout,h);
           xout += dxout;
@@ -100,8 +240,11 @@ namespace WaveformUtilities {
     // <added>
     bool denseish;
     bool (Stepper::Dtype::*ContinueIntegration)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const;
+    Doub (Stepper::Dtype::*EventFunction)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const;
     // </added>
+    ODEWorkspaceLoan loan; // <added />
     VecDoub y,dydx;
+    VecDoub ye,dydxe,yc,dydxc; // <added />
     VecDoub &ystart;
     Output &out;
     typename Stepper::Dtype &derivs;
@@ -120,6 +263,16 @@ namespace WaveformUtilities {
            const bool denseishh=false,
            bool (Stepper::Dtype::*ContinueIntegrating)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const = NULL);
     // </replacement>
+    // <added>
+    Odeint(VecDoub_IO &ystartt,const Doub xx1,const Doub xx2,
+           const Doub atol,const Doub rtol,const Doub h1,
+           const Doub hminn,Output &outt,typename Stepper::Dtype &derivss,
+           const bool denseishh,
+           Doub (Stepper::Dtype::*Event)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const);
+    Doub locate_event(const Doub gold, const Doub gnew, VecDoub_O &ye, VecDoub_O &dydxe);
+    ~Odeint() { loan.Return(); }
+    void integrate(ODEStatistics* Statistics, const char* Phase);
+    // </added>
     void integrate();
   };
 
@@ -140,30 +293,133 @@ namespace WaveformUtilities {
                           bool (Stepper::Dtype::*ContinueIntegrating)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const)
     : nok(0), nbad(0), nvar(ystartt.size()),
       x(xx1), x1(xx1), x2(xx2), hmin(hminn), dense(outt.dense),
-      denseish(denseishh), ContinueIntegration(ContinueIntegrating),
-      y(nvar), dydx(nvar), ystart(ystartt), out(outt), derivs(derivss),
-      s(y,dydx,x,atol,rtol,dense) {
+      denseish(denseishh), ContinueIntegration(ContinueIntegrating), EventFunction(NULL),
+      loan(outt.workspace), ystart(ystartt), out(outt), derivs(derivss),
+      s(loan.Borrow(y,nvar),loan.Borrow(dydx,nvar),x,atol,rtol,dense,outt.workspace) {
     // </replacement>
+    loan.Borrow(ye,nvar); loan.Borrow(dydxe,nvar); loan.Borrow(yc,nvar); loan.Borrow(dydxc,nvar); // <added />
+    EPS=std::numeric_limits<Doub>::epsilon();
+    h=SIGN(h1,x2-x1);
+    for (Int i=0;i<nvar;i++) y[i]=ystart[i];
+    out.init(s.neqn,x1,x2);
+  }
+
+  // <added>
+  /// The stepper always prepares its dense output when there is an
+  /// event function, since that is used to locate the event.
+  template<class Stepper>
+  Odeint<Stepper>::Odeint(VecDoub_IO &ystartt, const Doub xx1, const Doub xx2,
+                          const Doub atol, const Doub rtol, const Doub h1, const Doub hminn,
+                          Output &outt,typename Stepper::Dtype &derivss,
+                          const bool denseishh,
+                          Doub (Stepper::Dtype::*Event)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const)
+    : nok(0), nbad(0), nvar(ystartt.size()),
+      x(xx1), x1(xx1), x2(xx2), hmin(hminn), dense(outt.dense),
+      denseish(denseishh), ContinueIntegration(NULL), EventFunction(Event),
+      loan(outt.workspace), ystart(ystartt), out(outt), derivs(derivss),
+      s(loan.Borrow(y,nvar),loan.Borrow(dydx,nvar),x,atol,rtol,dense || Event!=NULL,outt.workspace) {
+    loan.Borrow(ye,nvar); loan.Borrow(dydxe,nvar); loan.Borrow(yc,nvar); loan.Borrow(dydxc,nvar);
     EPS=std::numeric_limits<Doub>::epsilon();
     h=SIGN(h1,x2-x1);
     for (Int i=0;i<nvar;i++) y[i]=ystart[i];
     out.init(s.neqn,x1,x2);
   }
 
+  /// Given that the event function was gold>0 at the beginning of the
+  /// last step and is gnew<=0 at its end, find the event by the
+  /// Illinois variant of regula falsi, evaluating the solution with
+  /// the stepper's dense output.  The point returned is the end of the
+  /// final bracket on which the event function is non-positive, so that
+  /// the stopping condition is satisfied there; the solution and its
+  /// derivative at that point are returned in ye and dydxe.
+  template<class Stepper>
+  Doub Odeint<Stepper>::locate_event(const Doub gold, const Doub gnew, VecDoub_O &ye, VecDoub_O &dydxe) {
+    static const Int MAXIT=100;
+    Doub xa=s.xold, ga=gold, xb=x, gb=gnew;
+    const Doub tol=2.0*EPS*(std::abs(xb)+std::abs(s.hdid));
+    for (Int i=0;i<nvar;i++) { ye[i]=y[i]; dydxe[i]=dydx[i]; }
+    Int side=0;
+    for (Int it=0; it<MAXIT; it++) {
+      if (std::abs(xb-xa) <= tol || gb == 0.0) break;
+      Doub xc=(xa*gb-xb*ga)/(gb-ga);
+      if (!((xc-xa)*(xc-xb) < 0.0)) xc=0.5*(xa+xb);
+      for (Int i=0;i<nvar;i++) yc[i]=s.dense_out(i,xc,s.hdid);
+      derivs(xc,yc,dydxc);
+      ++s.nrhs;
+      const Doub gc=(derivs.*EventFunction)(xc,yc,dydxc);
+      if (gc > 0.0) {
+        xa=xc; ga=gc;
+        if (side == -1) gb *= 0.5;
+        side=-1;
+      } else {
+        xb=xc; gb=gc;
+        for (Int i=0;i<nvar;i++) { ye[i]=yc[i]; dydxe[i]=dydxc[i]; }
+        if (side == +1) ga *= 0.5;
+        side=+1;
+      }
+    }
+    return xb;
+  }
+
+  /// Integrate, and add the counts and time of this integration to the
+  /// named phase of Statistics (if non-NULL), even if it throws.
+  template<class Stepper>
+  void Odeint<Stepper>::integrate(ODEStatistics* Statistics, const char* Phase) {
+    const clock_t start=clock();
+    try {
+      integrate();
+    } catch(...) {
+      if (Statistics != NULL)
+        Statistics->Record(Phase, nok+nbad, s.nrej, s.nrhs, double(clock()-start)/double(CLOCKS_PER_SEC));
+      throw;
+    }
+    if (Statistics != NULL)
+      Statistics->Record(Phase, nok+nbad, s.nrej, s.nrhs, double(clock()-start)/double(CLOCKS_PER_SEC));
+  }
+  // </added>
+
   template<class Stepper>
   void Odeint<Stepper>::integrate() {
     derivs(x,y,dydx);
+    ++s.nrhs; // <added />
     if (dense) {
       if(denseish) { out.dxout = h/double(out.nsave); } // <added />
       out.out(-1,x,y,s,h);
     } else {
       out.save(x,y);
     }
+    // <added>
+    Doub g=0.0;
+    if (EventFunction!=NULL) {
+      g=(derivs.*EventFunction)(x,y,dydx);
+      if (g <= 0.0) return;
+    }
+    // </added>
     for (nstp=0;nstp<MAXSTP;nstp++) {
       if ((x+h*1.0001-x2)*(x2-x1) > 0.0)
         h=x2-x;
       s.step(h,derivs);
       if (s.hdid == h) ++nok; else ++nbad;
+      if (EventFunction!=NULL) { // <added>
+        const Doub gnew=(derivs.*EventFunction)(x,y,dydx);
+        if (gnew <= 0.0) {
+          const Doub xe=locate_event(g,gnew,ye,dydxe);
+          if (dense) {
+            if(denseish) { out.dxout = s.hdid/double(out.nsave); }
+            out.out(nstp,xe,ye,s,s.hdid);
+            if (out.trajectory != NULL) out.trajectory->TruncateAt(xe);
+          }
+          x=xe;
+          for (Int i=0;i<nvar;i++) { y[i]=ye[i]; dydx[i]=dydxe[i]; ystart[i]=y[i]; }
+          if (out.kmax > 0 && std::abs(out.xsave[out.count-1]-x) > 100.0*std::abs(x)*EPS)
+            out.save(x,y);
+          #ifdef DEBUG
+          std::cout << "\nODE returning, having found the event:  " << std::setprecision(16) << x << " \t " << y << " \t " << dydx << std::endl;
+          #endif
+          return;
+        }
+        g=gnew;
+      } // </added>
       if (dense) {
         if(denseish) { out.dxout = s.hdid/double(out.nsave); } // <added />
         out.out(nstp,x,y,s,s.hdid);
@@ -214,15 +470,52 @@ namespace WaveformUtilities {
     Doub EPS;
     Int n,neqn;
     VecDoub yout,yerr;
+    // <added>
+    ODEWorkspaceLoan loan;
+    Int nrhs,nrej;
+    // </added>
+    // <replaced>
+    //StepperBase(VecDoub_IO &yy, VecDoub_IO &dydxx, Doub &xx, const Doub atoll,
+    //            const Doub rtoll, bool dens) : x(xx),y(yy),dydx(dydxx),atol(atoll),
+    //                                           rtol(rtoll),dense(dens),n(y.size()),neqn(n),yout(n),yerr(n) {}
+    // </replaced>
+    // <replacement>
     StepperBase(VecDoub_IO &yy, VecDoub_IO &dydxx, Doub &xx, const Doub atoll,
-                const Doub rtoll, bool dens) : x(xx),y(yy),dydx(dydxx),atol(atoll),
-                                               rtol(rtoll),dense(dens),n(y.size()),neqn(n),yout(n),yerr(n) {}
+                const Doub rtoll, bool dens, ODEWorkspace* ws=NULL) : x(xx),y(yy),dydx(dydxx),atol(atoll),
+                                                                     rtol(rtoll),dense(dens),n(y.size()),neqn(n),loan(ws),nrhs(0),nrej(0) {
+      loan.Borrow(yout,n);
+      loan.Borrow(yerr,n);
+    }
+    ~StepperBase() { loan.Return(); }
+    // </replacement>
   };
 
   #include <cmath>
   #include "StepperDopr853a.hpp"
   #include "StepperBS.hpp"
 
+  // <added>
+  /// Integrate the const right-hand side derivs from ystart with the
+  /// chosen stepper (StepperBS for BSStepper, and StepperDopr853
+  /// otherwise) until the event function becomes non-positive,
+  /// recording the counts and time under the named phase of
+  /// Statistics, if that is non-NULL.
+  template<class D>
+  void IntegrateODE(const ODEStepper Stepper, VecDoub_IO &ystart, const Doub x1, const Doub x2,
+                    const Doub atol, const Doub rtol, const Doub h1, const Doub hmin,
+                    Output &out, const D &derivs, const bool denseish,
+                    Doub (D::*Event)(const double& x, const std::vector<double>& y, const std::vector<double>& dydx) const,
+                    ODEStatistics* Statistics=NULL, const char* Phase="Integration") {
+    if (Stepper == BSStepper) {
+      Odeint<StepperBS<const D> > ode(ystart,x1,x2,atol,rtol,h1,hmin,out,derivs,denseish,Event);
+      ode.integrate(Statistics,Phase);
+    } else {
+      Odeint<StepperDopr853<const D> > ode(ystart,x1,x2,atol,rtol,h1,hmin,out,derivs,denseish,Event);
+      ode.integrate(Statistics,Phase);
+    }
+  }
+  // </added>
+
 } // namespace WaveformUtilities
 
 #endif // ODEINTEGRATOR_HPP
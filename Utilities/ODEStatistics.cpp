@@ -0,0 +1,59 @@
+#include "ODEStatistics.hpp"
+
+namespace WU = WaveformUtilities;
+using WU::ODEStatistics;
+
+
+/// Return the phase with this name, appending it if necessary.
+ODEStatistics::Phase& ODEStatistics::Find(const std::string& Name) {
+  for(unsigned int i=0; i<Phases.size(); ++i) {
+    if(Phases[i].Name==Name) { return Phases[i]; }
+  }
+  Phases.push_back(Phase(Name));
+  return Phases.back();
+}
+
+/// Add one integration to the named phase.
+void ODEStatistics::Record(const std::string& Name, const unsigned int NSteps, const unsigned int NRejected,
+                           const unsigned int NRHS, const double Seconds) {
+  Phase& P = Find(Name);
+  P.NIntegrations += 1;
+  P.NSteps += NSteps;
+  P.NRejected += NRejected;
+  P.NRHS += NRHS;
+  P.Seconds += Seconds;
+}
+
+/// Add everything in b to the named phase.
+void ODEStatistics::Record(const std::string& Name, const ODEStatistics& b) {
+  const Phase T = b.Total();
+  Phase& P = Find(Name);
+  P.NIntegrations += T.NIntegrations;
+  P.NSteps += T.NSteps;
+  P.NRejected += T.NRejected;
+  P.NRHS += T.NRHS;
+  P.Seconds += T.Seconds;
+}
+
+ODEStatistics::Phase ODEStatistics::Total() const {
+  Phase T("Total");
+  for(unsigned int i=0; i<Phases.size(); ++i) {
+    T.NIntegrations += Phases[i].NIntegrations;
+    T.NSteps += Phases[i].NSteps;
+    T.NRejected += Phases[i].NRejected;
+    T.NRHS += Phases[i].NRHS;
+    T.Seconds += Phases[i].Seconds;
+  }
+  return T;
+}
+
+std::ostream& WU::operator<<(std::ostream& os, const ODEStatistics& S) {
+  const std::streamsize Precision = os.precision(6);
+  os << "# Phase NIntegrations NSteps NRejected NRHS Seconds\n";
+  for(unsigned int i=0; i<S.NPhases(); ++i) {
+    os << S[i].Name << " " << S[i].NIntegrations << " " << S[i].NSteps << " " << S[i].NRejected
+       << " " << S[i].NRHS << " " << S[i].Seconds << "\n";
+  }
+  os.precision(Precision);
+  return os;
+}
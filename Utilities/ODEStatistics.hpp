@@ -0,0 +1,49 @@
+#ifndef ODESTATISTICS_HPP
+#define ODESTATISTICS_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace WaveformUtilities {
+
+  /// The steppers with which an approximant may be asked to integrate.
+  /// DefaultStepper leaves the choice to the approximant: DOPR853 for
+  /// the TaylorTn approximants, and Bulirsch-Stoer followed by DOPR853
+  /// for EOB.
+  enum ODEStepper { DefaultStepper, Dopr853Stepper, BSStepper };
+
+  /// Counts and timings of the ODE integrations that produce a
+  /// trajectory, grouped into named phases (for example,
+  /// "EccentricityReduction" and "Integration" for EOB).  Everything
+  /// recorded under the same name is added to the same phase.  NSteps
+  /// counts accepted steps, NRejected counts the steps retried with a
+  /// smaller size, and NRHS counts evaluations of the right-hand side.
+  class ODEStatistics {
+  public:
+    struct Phase {
+      std::string Name;
+      unsigned int NIntegrations, NSteps, NRejected, NRHS;
+      double Seconds;
+      Phase(const std::string& iName="")
+        : Name(iName), NIntegrations(0), NSteps(0), NRejected(0), NRHS(0), Seconds(0.0) { }
+    };
+  private:
+    std::vector<Phase> Phases;
+    Phase& Find(const std::string& Name);
+  public:
+    ODEStatistics() { }
+    void Clear() { Phases.clear(); }
+    void Record(const std::string& Name, const unsigned int NSteps, const unsigned int NRejected,
+                const unsigned int NRHS, const double Seconds);
+    void Record(const std::string& Name, const ODEStatistics& b);
+    inline unsigned int NPhases() const { return Phases.size(); }
+    inline const Phase& operator[](const unsigned int i) const { return Phases[i]; }
+    Phase Total() const;
+  };
+
+  std::ostream& operator<<(std::ostream& os, const ODEStatistics& S);
+
+}
+
+#endif // ODESTATISTICS_HPP
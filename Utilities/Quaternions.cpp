@@ -1,10 +1,12 @@
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include <iostream>
 
 #include "Quaternions.hpp"
 #include "WaveformUtilities_ErrorCodes.hpp"
 using WaveformUtilities::Quaternion;
+using WaveformUtilities::QuaternionSeries;
 
 // Note: Don't do 'using namespace std' because we don't want to
 // confuse which log, exp, etc., is being used in any instance.
@@ -244,21 +246,17 @@ std::vector<Quaternion> WaveformUtilities::MinimalRotation(const std::vector<Qua
   }
   const unsigned int Size=T.size();
   const Quaternion z(0,0,0,1);
-  vector<double> gammaover2dot(Size);
-  vector<Quaternion> Rreturn(R);
+  QuaternionSeries Rreturn(R), gammaover2dot(Size);
   for(unsigned int iteration=0; iteration<NIterations; ++iteration) {
     cout << "\t\tIteration " << iteration << endl;
-    const vector<Quaternion> Rdot = WaveformUtilities::CenteredDifferencing(Rreturn, T);
-    for(unsigned int i=0; i<Size; ++i) {
-      gammaover2dot[i] = ( Rreturn[i].conjugate() * Rdot[i] * z )[0];
-    }
-    const vector<double> gammaover2 = ScalarIntegral(gammaover2dot, T);
-    for(unsigned int i=0; i<Size; ++i) {
-      Rreturn[i] = Rreturn[i] * (gammaover2[i]*z).exp();
-    }
+    // gammaover2dot = conjugate(Rreturn) * Rdot * z
+    gammaover2dot = Rreturn;
+    gammaover2dot.Conjugate().RightMultiply(WaveformUtilities::CenteredDifferencing(Rreturn, T)).RightMultiply(z);
+    const vector<double> gammaover2 = ScalarIntegral(gammaover2dot.Component0(), T);
+    Rreturn.RightMultiplyByExp(gammaover2, z);
   }
   cout << "\tFinished" << endl;
-  return Rreturn;
+  return Rreturn.Quaternions();
 }
 
 /// Construct frame given the X and Y basis vectors of that frame.
@@ -369,6 +367,460 @@ std::vector<Quaternion> WaveformUtilities::RDelta(const std::vector<Quaternion>&
   return Rd;
 }
 
+/// Copy a vector of Quaternions into components.
+WaveformUtilities::QuaternionSeries::QuaternionSeries(const std::vector<Quaternion>& Q)
+  : w(Q.size()), x(Q.size()), y(Q.size()), z(Q.size())
+{
+  for(unsigned int i=0; i<Q.size(); ++i) { Set(i, Q[i]); }
+}
+
+/// Copy a vector of Quaternions into components.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::operator=(const std::vector<Quaternion>& Q) {
+  resize(Q.size());
+  for(unsigned int i=0; i<Q.size(); ++i) { Set(i, Q[i]); }
+  return *this;
+}
+
+/// Copy the components out into a vector of Quaternions.
+void WaveformUtilities::QuaternionSeries::Quaternions(std::vector<Quaternion>& Q) const {
+  const unsigned int N = size();
+  Q.resize(N);
+  for(unsigned int i=0; i<N; ++i) {
+    Q[i].w = w[i]; Q[i].x = x[i]; Q[i].y = y[i]; Q[i].z = z[i];
+  }
+}
+
+/// Copy the components out into a vector of Quaternions.
+std::vector<Quaternion> WaveformUtilities::QuaternionSeries::Quaternions() const {
+  vector<Quaternion> Q;
+  Quaternions(Q);
+  return Q;
+}
+
+/// Replace each element Q_i of this series by Q*Q_i.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::LeftMultiply(const Quaternion& Q) {
+  const unsigned int N = size();
+  const double a0=Q.w, a1=Q.x, a2=Q.y, a3=Q.z;
+  for(unsigned int i=0; i<N; ++i) {
+    const double b0=w[i], b1=x[i], b2=y[i], b3=z[i];
+    w[i] = a0*b0 - a1*b1 - a2*b2 - a3*b3;
+    x[i] = a0*b1 + a1*b0 + a2*b3 - a3*b2;
+    y[i] = a0*b2 - a1*b3 + a2*b0 + a3*b1;
+    z[i] = a0*b3 + a1*b2 - a2*b1 + a3*b0;
+  }
+  return *this;
+}
+
+/// Replace each element Q_i of this series by Q_i*Q.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::RightMultiply(const Quaternion& Q) {
+  const unsigned int N = size();
+  const double b0=Q.w, b1=Q.x, b2=Q.y, b3=Q.z;
+  for(unsigned int i=0; i<N; ++i) {
+    const double a0=w[i], a1=x[i], a2=y[i], a3=z[i];
+    w[i] = a0*b0 - a1*b1 - a2*b2 - a3*b3;
+    x[i] = a0*b1 + a1*b0 + a2*b3 - a3*b2;
+    y[i] = a0*b2 - a1*b3 + a2*b0 + a3*b1;
+    z[i] = a0*b3 + a1*b2 - a2*b1 + a3*b0;
+  }
+  return *this;
+}
+
+/// Replace each element Q_i of this series by P_i*Q_i.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::LeftMultiply(const QuaternionSeries& P) {
+  if(P.size() != size()) {
+    cerr << "\n\nP.size()=" << P.size() << " != size()=" << size() << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    const double a0=P.w[i], a1=P.x[i], a2=P.y[i], a3=P.z[i];
+    const double b0=w[i], b1=x[i], b2=y[i], b3=z[i];
+    w[i] = a0*b0 - a1*b1 - a2*b2 - a3*b3;
+    x[i] = a0*b1 + a1*b0 + a2*b3 - a3*b2;
+    y[i] = a0*b2 - a1*b3 + a2*b0 + a3*b1;
+    z[i] = a0*b3 + a1*b2 - a2*b1 + a3*b0;
+  }
+  return *this;
+}
+
+/// Replace each element Q_i of this series by Q_i*P_i.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::RightMultiply(const QuaternionSeries& P) {
+  if(P.size() != size()) {
+    cerr << "\n\nP.size()=" << P.size() << " != size()=" << size() << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    const double a0=w[i], a1=x[i], a2=y[i], a3=z[i];
+    const double b0=P.w[i], b1=P.x[i], b2=P.y[i], b3=P.z[i];
+    w[i] = a0*b0 - a1*b1 - a2*b2 - a3*b3;
+    x[i] = a0*b1 + a1*b0 + a2*b3 - a3*b2;
+    y[i] = a0*b2 - a1*b3 + a2*b0 + a3*b1;
+    z[i] = a0*b3 + a1*b2 - a2*b1 + a3*b0;
+  }
+  return *this;
+}
+
+/// Replace each element Q_i of this series by Q_i*exp(a_i*Q).
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::RightMultiplyByExp(const std::vector<double>& a, const Quaternion& Q) {
+  ///
+  /// \param a Vector of coefficients
+  /// \param Q Quaternion, usually a pure vector
+  ///
+  /// This is the usual way of rotating a frame about one of its own
+  /// axes by a time-dependent angle.
+  if(a.size() != size()) {
+    cerr << "\n\na.size()=" << a.size() << " != size()=" << size() << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    Set(i, (*this)[i] * (a[i]*Q).exp());
+  }
+  return *this;
+}
+
+/// Replace each element of this series by its conjugate.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::Conjugate() {
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    x[i] = -x[i]; y[i] = -y[i]; z[i] = -z[i];
+  }
+  return *this;
+}
+
+/// Replace each element of this series by its normalized value.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::Normalize() {
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    const double Abs = std::sqrt(w[i]*w[i]+x[i]*x[i]+y[i]*y[i]+z[i]*z[i]);
+    w[i] /= Abs; x[i] /= Abs; y[i] /= Abs; z[i] /= Abs;
+  }
+  return *this;
+}
+
+/// Replace each element of this series by its logarithm.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::Log() {
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    Set(i, (*this)[i].log());
+  }
+  return *this;
+}
+
+/// Replace each element of this series by its exponential.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::Exp() {
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    Set(i, (*this)[i].exp());
+  }
+  return *this;
+}
+
+/// Raise each element of this series to the power t.
+WaveformUtilities::QuaternionSeries& WaveformUtilities::QuaternionSeries::Pow(const double t) {
+  const unsigned int N = size();
+  for(unsigned int i=0; i<N; ++i) {
+    Set(i, (*this)[i].pow(t));
+  }
+  return *this;
+}
+
+/// Centered differencing of a QuaternionSeries.
+WaveformUtilities::QuaternionSeries WaveformUtilities::CenteredDifferencing(const QuaternionSeries& QIn, const std::vector<double>& tIn) {
+  ///
+  /// \param QIn Series of Quaternions.
+  /// \param tIn Vector of corresponding time steps.
+  ///
+  /// The result is the same as that of the std::vector<Quaternion>
+  /// version, but each logarithm is computed once, rather than twice.
+  if(tIn.size() != QIn.size()) {
+    cerr << "\n\ntIn.size()=" << tIn.size() << " != QIn.size()=" << QIn.size() << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  const unsigned int Size = QIn.size();
+  if(Size<2) {
+    cerr << "\n\nQIn.size()=" << Size << "; CenteredDifferencing needs at least two points." << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  QuaternionSeries QOut(Size);
+  Quaternion Qi = QIn[0], Qip1 = QIn[1];
+  Quaternion LogPrevious = WaveformUtilities::log(Qi.inverse()*Qip1);
+  double DtPrevious = tIn[1]-tIn[0];
+  QOut.Set(0, (Qi * LogPrevious) / DtPrevious);
+  for(unsigned int i=1; i<Size-1; ++i) {
+    Qi = Qip1;
+    Qip1 = QIn[i+1];
+    const Quaternion LogNext = WaveformUtilities::log(Qi.inverse()*Qip1);
+    const double DtNext = tIn[i+1]-tIn[i];
+    QOut.Set(i, Qi * (0.5 * (LogNext/DtNext + LogPrevious/DtPrevious)));
+    LogPrevious = LogNext;
+    DtPrevious = DtNext;
+  }
+  QOut.Set(Size-1, (Qip1 * LogPrevious) / DtPrevious);
+  return QOut;
+}
+
+// Helpers for SquadInterpolator, acting on components.  The
+// branches follow Quaternion::log and Quaternion::exp.
+static inline void Multiply(const double* a, const double* b, double* r) {
+  const double w = a[0]*b[0] - a[1]*b[1] - a[2]*b[2] - a[3]*b[3];
+  const double x = a[0]*b[1] + a[1]*b[0] + a[2]*b[3] - a[3]*b[2];
+  const double y = a[0]*b[2] - a[1]*b[3] + a[2]*b[0] + a[3]*b[1];
+  const double z = a[0]*b[3] + a[1]*b[2] - a[2]*b[1] + a[3]*b[0];
+  r[0] = w; r[1] = x; r[2] = y; r[3] = z;
+}
+static inline void Log(const double* q, double* r) {
+  const double bSquared = q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+  const double b = std::sqrt(bSquared);
+  if(b <= Quaternion_Epsilon*std::abs(q[0])) {
+    if(q[0]<0.0) {
+      cerr << "Infinitely many solutions for log of a negative scalar: w=" << q[0] << "." << endl;
+      throw(WaveformUtilities_InfinitelyManySolutions);
+    }
+    r[0] = std::log(q[0]);
+    r[1] = r[2] = r[3] = 0.0;
+  } else {
+    const double f = std::atan2(b, q[0])/b;
+    r[0] = 0.5*std::log(q[0]*q[0]+bSquared);
+    r[1] = f*q[1]; r[2] = f*q[2]; r[3] = f*q[3];
+  }
+}
+static inline void ScaledExp(const double s, const double w, const double x, const double y, const double z, double* r) {
+  const double sx=s*x, sy=s*y, sz=s*z;
+  const double b = std::sqrt(sx*sx + sy*sy + sz*sz);
+  const double e = std::exp(s*w);
+  if(b <= Quaternion_Epsilon*std::abs(s*w)) {
+    r[0] = e;
+    r[1] = r[2] = r[3] = 0.0;
+  } else {
+    const double f = e*std::sin(b)/b;
+    r[0] = e*std::cos(b);
+    r[1] = f*sx; r[2] = f*sy; r[3] = f*sz;
+  }
+}
+/// The outer slerp of Squad, given exp(tau*log(Q_{i+1}/Q_i)) and
+/// exp(tau*log(B_{i+1}/A_i)).
+static inline void SquadBlend(const double tau, const double* E1, const double* E2, const double* Q, const double* A, double* R) {
+  double P[4], B[4], D[4], L[4];
+  Multiply(E1, Q, P);
+  Multiply(E2, A, B);
+  const double InvNormSquared = 1.0/(P[0]*P[0] + P[1]*P[1] + P[2]*P[2] + P[3]*P[3]);
+  const double PInverse[4] = { P[0]*InvNormSquared, -P[1]*InvNormSquared, -P[2]*InvNormSquared, -P[3]*InvNormSquared };
+  Multiply(B, PInverse, D);
+  Log(D, L);
+  ScaledExp(2*tau*(1-tau), L[0], L[1], L[2], L[3], D);
+  Multiply(D, P, R);
+}
+static inline void Store(std::vector<Quaternion>& ROut, const unsigned int j, const double* R) {
+  ROut[j] = Quaternion(R[0], R[1], R[2], R[3]);
+}
+static inline void Store(WaveformUtilities::QuaternionSeries& ROut, const unsigned int j, const double* R) {
+  ROut.Set(j, R[0], R[1], R[2], R[3]);
+}
+
+/// Set up Squad interpolation over all of the input series.
+WaveformUtilities::SquadInterpolator::SquadInterpolator(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn)
+  : NInTotal(tIn.size()), iBegin(0)
+{
+  ///
+  /// \param RIn Vector of rotors
+  /// \param tIn Vector of corresponding times
+  SetUp(RIn, tIn, (NInTotal>1 ? NInTotal-2 : 0));
+}
+
+/// Set up Squad interpolation only for times in [tMin, tMax].
+WaveformUtilities::SquadInterpolator::SquadInterpolator(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn,
+                                                        const double tMin, const double tMax)
+  : NInTotal(tIn.size()), iBegin(0)
+{
+  ///
+  /// \param RIn Vector of rotors
+  /// \param tIn Vector of corresponding times
+  /// \param tMin Earliest time that will be requested
+  /// \param tMax Latest time that will be requested
+  ///
+  /// Only the intervals of tIn containing [tMin, tMax] are set up,
+  /// which saves most of the work when few output times are needed
+  /// from a long series.
+  if(tMin>tMax) {
+    cerr << "\n\ntMin=" << tMin << " > tMax=" << tMax << endl;
+    throw(WaveformUtilities_IndexOutOfBounds);
+  }
+  if(NInTotal<2) {
+    SetUp(RIn, tIn, 0);
+    return;
+  }
+  const int iMin = int(std::lower_bound(tIn.begin()+1, tIn.end(), tMin)-tIn.begin())-1;
+  const int iMax = int(std::lower_bound(tIn.begin()+1, tIn.end(), tMax)-tIn.begin())-1;
+  iBegin = std::max(0, std::min(int(NInTotal)-2, iMin));
+  SetUp(RIn, tIn, std::max(int(iBegin), std::min(int(NInTotal)-2, iMax)));
+}
+
+/// Compute the control rotors of the intervals from iBegin to iEnd.
+void WaveformUtilities::SquadInterpolator::SetUp(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn, const unsigned int iEnd) {
+  if(RIn.size() != tIn.size()) {
+    cerr << "\n\nRIn.size()=" << RIn.size() << " != tIn.size()=" << tIn.size() << endl;
+    throw(WaveformUtilities_VectorSizeMismatch);
+  }
+  if(tIn.size()<2) {
+    cerr << "\n\ntIn.size()=" << tIn.size() << "; Squad needs at least two rotors." << endl;
+    throw(WaveformUtilities_CannotExtrapolateQuaternions);
+  }
+  const unsigned int N = iEnd+1-iBegin;
+  t.assign(tIn.begin()+iBegin, tIn.begin()+iEnd+2);
+  InvDt.resize(N);
+  Qw.resize(N); Qx.resize(N); Qy.resize(N); Qz.resize(N);
+  Aw.resize(N); Ax.resize(N); Ay.resize(N); Az.resize(N);
+  LQw.resize(N); LQx.resize(N); LQy.resize(N); LQz.resize(N);
+  LAw.resize(N); LAx.resize(N); LAy.resize(N); LAz.resize(N);
+  for(unsigned int k=0; k<N; ++k) {
+    const unsigned int i = iBegin+k;
+    // At the ends, the missing neighbor is the reflection of the
+    // next one in, at the same spacing
+    const double Dti = tIn[i+1]-tIn[i];
+    const double Dtim1 = (i==0 ? Dti : tIn[i]-tIn[i-1]);
+    const double Dtip1 = (i+2==NInTotal ? Dti : tIn[i+2]-tIn[i+1]);
+    const Quaternion& Qi = RIn[i];
+    const Quaternion& Qip1 = RIn[i+1];
+    const Quaternion Qim1 = (i==0 ? Qi*Qip1.conjugate()*Qi : RIn[i-1]);
+    const Quaternion Qip2 = (i+2==NInTotal ? Qip1*Qi.conjugate()*Qip1 : RIn[i+2]);
+    const Quaternion Ai = Qi * WaveformUtilities::exp((
+                                WaveformUtilities::log(Qi.conjugate()*Qip1)
+                                +(Dti/Dtim1)*WaveformUtilities::log(Qim1.conjugate()*Qi)
+                                -2*WaveformUtilities::log(Qip1*Qi.conjugate())
+                                )*0.25);
+    const Quaternion Bip1 = Qip1 * WaveformUtilities::exp((
+                                    (Dti/Dtip1)*WaveformUtilities::log(Qip1.conjugate()*Qip2)
+                                    +WaveformUtilities::log(Qi.conjugate()*Qip1)
+                                    -2*WaveformUtilities::log(Qip1*Qi.conjugate())
+                                    )*-0.25);
+    const Quaternion LQ = WaveformUtilities::log(Qip1/Qi);
+    const Quaternion LA = WaveformUtilities::log(Bip1/Ai);
+    InvDt[k] = 1.0/Dti;
+    Qw[k] = Qi[0]; Qx[k] = Qi[1]; Qy[k] = Qi[2]; Qz[k] = Qi[3];
+    Aw[k] = Ai[0]; Ax[k] = Ai[1]; Ay[k] = Ai[2]; Az[k] = Ai[3];
+    LQw[k] = LQ[0]; LQx[k] = LQ[1]; LQy[k] = LQ[2]; LQz[k] = LQ[3];
+    LAw[k] = LA[0]; LAx[k] = LA[1]; LAy[k] = LA[2]; LAz[k] = LA[3];
+  }
+}
+
+/// Index of the interval (tIn[i], tIn[i+1]] containing tOut.
+unsigned int WaveformUtilities::SquadInterpolator::Interval(const double tOut) const {
+  if(tOut>t.back()) {
+    if(iBegin+t.size()==NInTotal) {
+      cerr << "Time " << tOut << " is beyond the end of the input data (time " << t.back() << ")." << endl;
+      throw(WaveformUtilities_CannotExtrapolateQuaternions);
+    }
+    cerr << "Time " << tOut << " is after the range set up for this SquadInterpolator (ending at " << t.back() << ")." << endl;
+    throw(WaveformUtilities_IndexOutOfBounds);
+  }
+  if(tOut<t[0] && iBegin>0) {
+    cerr << "Time " << tOut << " is before the range set up for this SquadInterpolator (starting at " << t[0] << ")." << endl;
+    throw(WaveformUtilities_IndexOutOfBounds);
+  }
+  // Times before the first input are extrapolated from the first interval
+  return std::max(1, int(std::lower_bound(t.begin()+1, t.end(), tOut)-t.begin()))-1;
+}
+
+/// Interpolate to a single time.
+Quaternion WaveformUtilities::SquadInterpolator::operator()(const double tOut) const {
+  const unsigned int k = Interval(tOut);
+  const double tau = (tOut-t[k])*InvDt[k];
+  const double Q[4] = { Qw[k], Qx[k], Qy[k], Qz[k] };
+  const double A[4] = { Aw[k], Ax[k], Ay[k], Az[k] };
+  double E1[4], E2[4], R[4];
+  ScaledExp(tau, LQw[k], LQx[k], LQy[k], LQz[k], E1);
+  ScaledExp(tau, LAw[k], LAx[k], LAy[k], LAz[k], E2);
+  SquadBlend(tau, E1, E2, Q, A, R);
+  return Quaternion(R[0], R[1], R[2], R[3]);
+}
+
+/// Interpolate to a vector of times.
+void WaveformUtilities::SquadInterpolator::operator()(const std::vector<double>& tOut, std::vector<Quaternion>& ROut) const {
+  ///
+  /// \param tOut Vector of times, usually increasing
+  /// \param ROut Vector of interpolated rotors
+  ///
+  /// Increasing times are bracketed by stepping forward; others are
+  /// found by bisection.
+  Evaluate(tOut, ROut);
+}
+
+/// Interpolate to a vector of times, storing the result by components.
+void WaveformUtilities::SquadInterpolator::operator()(const std::vector<double>& tOut, QuaternionSeries& ROut) const {
+  Evaluate(tOut, ROut);
+}
+
+template <class Series>
+void WaveformUtilities::SquadInterpolator::Evaluate(const std::vector<double>& tOut, Series& ROut) const {
+  const unsigned int NOut = tOut.size();
+  ROut.resize(NOut);
+  if(NOut==0) { return; }
+
+  // The uniform case: within an interval, tau advances by a fixed
+  // step, so the inner exponentials advance by products with fixed
+  // step rotors.  They are recomputed directly at the start of each
+  // interval, and every 64 steps, to stop roundoff from accumulating.
+  // The grid is accepted as uniform when each time is within 1e-10
+  // of a step, plus the roundoff in the times themselves, of its
+  // ideal value; the error that tolerates is that fraction of the
+  // rotation across one output step.
+  bool Uniform = (NOut>2);
+  const double h = (tOut.back()-tOut[0])/(NOut-1);
+  const double Tolerance = 1e-10*h + 1e-15*std::max(std::abs(tOut[0]), std::abs(tOut.back()));
+  for(unsigned int j=1; j<NOut-1 && Uniform; ++j) {
+    Uniform = (std::abs(tOut[j]-tOut[0]-j*h) <= Tolerance);
+  }
+  Uniform = Uniform && (h>0.0);
+
+  const unsigned int NInt = t.size()-1;
+  unsigned int k = Interval(tOut[0]);
+  unsigned int kStep = NInt;
+  unsigned int NSteps = 0;
+  // The step rotors S1 and S2 are only read once set, on a uniform
+  // grid, but the compiler cannot see that
+  double Q[4], A[4], E1[4], E2[4], R[4];
+  double S1[4] = {1.0, 0.0, 0.0, 0.0}, S2[4] = {1.0, 0.0, 0.0, 0.0};
+  for(unsigned int j=0; j<NOut; ++j) {
+    const double tj = tOut[j];
+    if(!(tj<=t[k+1] && (tj>t[k] || (k==0 && iBegin==0)))) {
+      // Try a few steps forward before starting over
+      for(unsigned int Steps=0; Steps<4 && k+1<NInt && tj>t[k+1]; ++Steps) { ++k; }
+      if(!(tj<=t[k+1] && tj>t[k])) { k = Interval(tj); }
+    }
+    const double tau = (tj-t[k])*InvDt[k];
+    if(k!=kStep) {
+      Q[0] = Qw[k]; Q[1] = Qx[k]; Q[2] = Qy[k]; Q[3] = Qz[k];
+      A[0] = Aw[k]; A[1] = Ax[k]; A[2] = Ay[k]; A[3] = Az[k];
+    }
+    if(Uniform && k==kStep && NSteps<64) {
+      Multiply(S1, E1, E1);
+      Multiply(S2, E2, E2);
+      ++NSteps;
+    } else {
+      ScaledExp(tau, LQw[k], LQx[k], LQy[k], LQz[k], E1);
+      ScaledExp(tau, LAw[k], LAx[k], LAy[k], LAz[k], E2);
+      if(Uniform && k!=kStep) {
+        const double dtau = h*InvDt[k];
+        ScaledExp(dtau, LQw[k], LQx[k], LQy[k], LQz[k], S1);
+        ScaledExp(dtau, LAw[k], LAx[k], LAy[k], LAz[k], S2);
+      }
+      kStep = k;
+      NSteps = 0;
+    }
+    SquadBlend(tau, E1, E2, Q, A, R);
+    Store(ROut, j, R);
+  }
+}
+
+/// Interpolate to a vector of times.
+std::vector<Quaternion> WaveformUtilities::SquadInterpolator::operator()(const std::vector<double>& tOut) const {
+  vector<Quaternion> ROut;
+  (*this)(tOut, ROut);
+  return ROut;
+}
+
 /// Squad interpolation of Quaternion time series.
 std::vector<Quaternion> WaveformUtilities::Squad(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn, const std::vector<double>& tOut) {
   ///
@@ -379,71 +831,18 @@ std::vector<Quaternion> WaveformUtilities::Squad(const std::vector<Quaternion>&
   /// This function implements a version of cubic-spline interpolation
   /// designed for unit quaternions, which delivers more accurate,
   /// smooth, and physical rotations than other forms of
-  /// interpolation.
+  /// interpolation.  Only the intervals of tIn needed for tOut are set
+  /// up; see SquadInterpolator to reuse the setup for several calls.
   if(RIn.size() != tIn.size()) {
     cerr << "\n\nRIn.size()=" << RIn.size() << " != tIn.size()=" << tIn.size() << endl;
     throw(WaveformUtilities_VectorSizeMismatch);
   }
-  vector<Quaternion> ROut(tOut.size());
-  unsigned int iIn = 0;
-  unsigned int iOut = 0;
-  while(iOut<tOut.size() && iIn<tIn.size() && tIn[tIn.size()-1]>=tOut[iOut]) {
-    double Dtim1, Dti, Dtip1;
-    Quaternion Qim1, Qi, Qip1, Qip2, Ai, Bip1;
-    while(iIn+1<tIn.size() && tIn[iIn+1]<tOut[iOut]) {
-      iIn += 1;
-    }
-    if(iIn+1==tIn.size()) {
-      cerr << "Time " << tOut[iOut] << " is beyond the end of the input data (time " << tIn.back() << ")." << endl;
-      throw(WaveformUtilities_CannotExtrapolateQuaternions);
-    }
-    if(iIn==0) {
-      Dti = tIn[iIn+1]-tIn[iIn];
-      Dtim1 = Dti;
-      Dtip1 = tIn[iIn+2]-tIn[iIn+1];
-      Qim1 = RIn[iIn]*RIn[iIn+1].conjugate()*RIn[iIn];
-      // Qim1 = RIn[iIn];
-      Qi = RIn[iIn];
-      Qip1 = RIn[iIn+1];
-      Qip2 = RIn[iIn+2];
-    } else if(iIn+2==tIn.size()) {
-      Dtim1 = tIn[iIn]-tIn[iIn-1];
-      Dti = tIn[iIn+1]-tIn[iIn];
-      Dtip1 = Dti;
-      Qim1 = RIn[iIn-1];
-      Qi = RIn[iIn];
-      Qip1 = RIn[iIn+1];
-      Qip2 = RIn[iIn+1]*RIn[iIn].conjugate()*RIn[iIn+1];
-      // Qip2 = RIn[iIn+1];
-    } else {
-      Dtim1 = tIn[iIn]-tIn[iIn-1];
-      Dti = tIn[iIn+1]-tIn[iIn];
-      Dtip1 = tIn[iIn+2]-tIn[iIn+1];
-      Qim1 = RIn[iIn-1];
-      Qi = RIn[iIn];
-      Qip1 = RIn[iIn+1];
-      Qip2 = RIn[iIn+2];
-    }
-    Ai = Qi * WaveformUtilities::exp((
-                       WaveformUtilities::log(Qi.conjugate()*Qip1)
-                       +(Dti/Dtim1)*WaveformUtilities::log(Qim1.conjugate()*Qi)
-                       -2*WaveformUtilities::log(Qip1*Qi.conjugate())
-                       )*0.25);
-    Bip1 = Qip1 * WaveformUtilities::exp((
-                           (Dti/Dtip1)*WaveformUtilities::log(Qip1.conjugate()*Qip2)
-                           +WaveformUtilities::log(Qi.conjugate()*Qip1)
-                           -2*WaveformUtilities::log(Qip1*Qi.conjugate())
-                           )*-0.25);
-    while(iOut<tOut.size() && tOut[iOut]<=tIn[iIn+1]) {
-      const double taui = (tOut[iOut]-tIn[iIn]) / Dti;
-      ROut[iOut] = WaveformUtilities::Slerp(2*taui*(1-taui),
-                             WaveformUtilities::Slerp(taui, Qi, Qip1),
-                             WaveformUtilities::Slerp(taui, Ai, Bip1));
-      iOut += 1;
-    }
-    iIn += 1;
+  if(tOut.empty()) {
+    return vector<Quaternion>(0);
   }
-  return ROut;
+  const double tMin = *std::min_element(tOut.begin(), tOut.end());
+  const double tMax = *std::max_element(tOut.begin(), tOut.end());
+  return SquadInterpolator(RIn, tIn, tMin, tMax)(tOut);
 }
 
 std::vector<Quaternion> WaveformUtilities::operator+(const double a, const std::vector<Quaternion>& Q) {
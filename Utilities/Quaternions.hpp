@@ -12,8 +12,11 @@
 
 namespace WaveformUtilities {
 
+  class QuaternionSeries;
+
   // The class for an individual quaternion
   class Quaternion {
+    friend class QuaternionSeries;
   private:
     double w, x, y, z;
   public: // Constructors
@@ -76,6 +79,91 @@ namespace WaveformUtilities {
   std::ostream& operator<<(std::ostream& out, const WaveformUtilities::Quaternion& q);
 
 
+  // A series of Quaternions, stored as separate arrays of the four
+  // components
+  //
+  // The member functions modify the series in place, each in a single
+  // pass, so that a compound expression like conjugate(R)*Rdot*z is
+  // built up as
+  //
+  //   S = R;  S.Conjugate().RightMultiply(Rdot).RightMultiply(z);
+  //
+  // with none of the temporaries of the std::vector<Quaternion>
+  // operators below.  (Rdot must be computed before S is modified,
+  // since the arguments in such a chain may be evaluated after the
+  // calls before them.)  Each element is computed exactly as the
+  // corresponding Quaternion operation would compute it.
+  class QuaternionSeries {
+  private:
+    std::vector<double> w, x, y, z;
+  public: // Constructors and conversions
+    QuaternionSeries() { }
+    explicit QuaternionSeries(const unsigned int N) : w(N), x(N), y(N), z(N) { }
+    QuaternionSeries(const std::vector<Quaternion>& Q);
+    QuaternionSeries& operator=(const std::vector<Quaternion>& Q);
+    void Quaternions(std::vector<Quaternion>& Q) const;
+    std::vector<Quaternion> Quaternions() const;
+  public: // Access
+    unsigned int size() const { return w.size(); }
+    void resize(const unsigned int N) { w.resize(N); x.resize(N); y.resize(N); z.resize(N); }
+    void swap(QuaternionSeries& S) { w.swap(S.w); x.swap(S.x); y.swap(S.y); z.swap(S.z); }
+    inline Quaternion operator[](const unsigned int i) const { return Quaternion(w[i], x[i], y[i], z[i]); }
+    inline void Set(const unsigned int i, const Quaternion& Q) { w[i]=Q.w; x[i]=Q.x; y[i]=Q.y; z[i]=Q.z; }
+    inline void Set(const unsigned int i, const double w0, const double x0, const double y0, const double z0) { w[i]=w0; x[i]=x0; y[i]=y0; z[i]=z0; }
+    const std::vector<double>& Component0() const { return w; }
+    const std::vector<double>& Component1() const { return x; }
+    const std::vector<double>& Component2() const { return y; }
+    const std::vector<double>& Component3() const { return z; }
+  public: // In-place operations
+    QuaternionSeries& LeftMultiply(const Quaternion& Q);
+    QuaternionSeries& RightMultiply(const Quaternion& Q);
+    QuaternionSeries& LeftMultiply(const QuaternionSeries& P);
+    QuaternionSeries& RightMultiply(const QuaternionSeries& P);
+    QuaternionSeries& RightMultiplyByExp(const std::vector<double>& a, const Quaternion& Q);
+    QuaternionSeries& Conjugate();
+    QuaternionSeries& Normalize();
+    QuaternionSeries& Log();
+    QuaternionSeries& Exp();
+    QuaternionSeries& Pow(const double t);
+  };
+  QuaternionSeries CenteredDifferencing(const QuaternionSeries& QIn, const std::vector<double>& tIn);
+
+
+  // Squad interpolation of a rotor time series, set up once
+  //
+  // Everything that depends only on the input series is computed in
+  // the constructor: for each interval, the rotor Q_i at its start,
+  // the control rotor A_i, and the logarithms of Q_{i+1}/Q_i and
+  // B_{i+1}/A_i.  These are stored as separate arrays of components,
+  // so that each output time costs two exponentials and one slerp,
+  // without Quaternion temporaries.  When the output times are
+  // uniformly spaced, the two exponentials are replaced by products
+  // with a fixed step rotor in each interval.  The results are those
+  // of Squad, to roundoff.
+  //
+  // If tMin and tMax are given, only the intervals needed for times
+  // in [tMin, tMax] are set up, and other times cannot be requested.
+  class SquadInterpolator {
+  private:
+    unsigned int NInTotal, iBegin;
+    std::vector<double> t, InvDt;
+    std::vector<double> Qw, Qx, Qy, Qz, Aw, Ax, Ay, Az;
+    std::vector<double> LQw, LQx, LQy, LQz, LAw, LAx, LAy, LAz;
+    void SetUp(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn, const unsigned int iEnd);
+    unsigned int Interval(const double tOut) const;
+    template <class Series>
+    void Evaluate(const std::vector<double>& tOut, Series& ROut) const;
+  public:
+    SquadInterpolator(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn);
+    SquadInterpolator(const std::vector<Quaternion>& RIn, const std::vector<double>& tIn, const double tMin, const double tMax);
+    unsigned int NIntervals() const { return t.size()-1; }
+    Quaternion operator()(const double tOut) const;
+    void operator()(const std::vector<double>& tOut, std::vector<Quaternion>& ROut) const;
+    void operator()(const std::vector<double>& tOut, QuaternionSeries& ROut) const;
+    std::vector<Quaternion> operator()(const std::vector<double>& tOut) const;
+  };
+
+
   // Functions for arrays of Quaternion objects
   std::vector<Quaternion> CenteredDifferencing(const std::vector<Quaternion>& QIn, const std::vector<double>& tIn);
   std::vector<Quaternion> MinimalRotation(const std::vector<Quaternion>& R, const std::vector<double>& T, const unsigned int NIterations=5);
@@ -3,21 +3,29 @@ struct StepperBS : StepperBase {
   typedef D Dtype;
   static const Int KMAXX=8,IMAXX=KMAXX+1;
   Int k_targ;
-  VecInt nseq;
-  VecInt cost;
+  // <replaced>
+  //VecInt nseq;
+  //VecInt cost;
+  // </replaced>
+  Int nseq[IMAXX], cost[IMAXX]; // <replacement /> (fixed sizes need no allocation)
   MatDoub table;
   VecDoub dydxnew;
   Int mu;
-  MatDoub coeff;
-  VecDoub errfac;
+  //MatDoub coeff; // <replaced />
+  Doub coeff[IMAXX][IMAXX]; // <replacement />
+  //VecDoub errfac; // <replaced />
+  Doub errfac[2*IMAXX+2]; // <replacement />
   MatDoub ysave;
   MatDoub fsave;
-  VecInt ipoint;
+  //VecInt ipoint; // <replaced />
+  Int ipoint[IMAXX+1]; // <replacement />
   VecDoub dens;
+  VecDoub ysav,yseq,scale,ym,yn; // <added /> so that steps allocate nothing
   bool first_step,last_step;
   bool forward,reject,prev_reject;
   StepperBS(VecDoub_IO &yy, VecDoub_IO &dydxx, Doub &xx, const Doub atol,
-            const Doub rtol, bool dens);
+            const Doub rtol, bool dens, ODEWorkspace* ws=NULL);
+  ~StepperBS() { loan.Return(); } // <added />
   void step(const Doub htry,D &derivs);
   virtual void dy(VecDoub_I &y, const Doub htot, const Int k, VecDoub_O &yend,
                   Int &ipt, D &derivs);
@@ -27,14 +35,37 @@ struct StepperBS : StepperBase {
   virtual Doub dense_out(const Int i,const Doub x,const Doub h);
   virtual void dense_interp(const Int n, VecDoub_IO &y, const Int imit);
 };
+// <replaced>
+// template <class D>
+// StepperBS<D>::StepperBS(VecDoub_IO &yy,VecDoub_IO &dydxx,Doub &xx,
+//                         const Doub atoll,const Doub rtoll, bool dens) :
+//   StepperBase(yy,dydxx,xx,atoll,rtoll,dens),nseq(IMAXX),cost(IMAXX),
+//   table(KMAXX,n),dydxnew(n),coeff(IMAXX,IMAXX),errfac(2*IMAXX+2),ysave(IMAXX,n),
+//   fsave(IMAXX*(2*IMAXX+1),n),ipoint(IMAXX+1),dens((2*IMAXX+5)*n),
+//   first_step(true), last_step(false), forward(true), reject(false), prev_reject(false)
+// {
+// </replaced>
+// <replacement>
 template <class D>
 StepperBS<D>::StepperBS(VecDoub_IO &yy,VecDoub_IO &dydxx,Doub &xx,
-                        const Doub atoll,const Doub rtoll, bool dens) :
-  StepperBase(yy,dydxx,xx,atoll,rtoll,dens),nseq(IMAXX),cost(IMAXX),
-  table(KMAXX,n),dydxnew(n),coeff(IMAXX,IMAXX),errfac(2*IMAXX+2),ysave(IMAXX,n),
-  fsave(IMAXX*(2*IMAXX+1),n),ipoint(IMAXX+1),dens((2*IMAXX+5)*n),
+                        const Doub atoll,const Doub rtoll, bool dens, ODEWorkspace* ws) :
+  StepperBase(yy,dydxx,xx,atoll,rtoll,dens,ws),
   first_step(true), last_step(false), forward(true), reject(false), prev_reject(false)
 {
+  loan.Borrow(table,KMAXX,n);
+  loan.Borrow(dydxnew,n);
+  loan.Borrow(ysave,IMAXX,n);
+  loan.Borrow(fsave,IMAXX*(2*IMAXX+1),n);
+  loan.Borrow(this->dens,(2*IMAXX+5)*n);
+  loan.Borrow(ysav,n);
+  loan.Borrow(yseq,n);
+  loan.Borrow(scale,n);
+  loan.Borrow(ym,n);
+  loan.Borrow(yn,n);
+  for (Int k=0; k<IMAXX; k++)
+    for (Int l=0; l<IMAXX; l++)
+      coeff[k][l]=0.0;
+  // </replacement>
   EPS=std::numeric_limits<Doub>::epsilon();
   if (dense)
     for (Int i=0;i<IMAXX;i++)
@@ -87,7 +118,8 @@ Doub StepperBS<D>::dense_out(const Int i,const Doub x,const Doub h) {
 template <class D>
 void StepperBS<D>::dense_interp(const Int n, VecDoub_IO &y, const Int imit) {
   Doub y0,y1,yp0,yp1,ydiff,aspl,bspl,ph0,ph1,ph2,ph3,fac1,fac2;
-  VecDoub a(31);
+  //VecDoub a(31); // <replaced />
+  Doub a[31]={0.0}; // <replacement />
   for (Int i=0; i<n; i++) {
     y0=y[i];
     y1=y[2*n+i];
@@ -131,8 +163,9 @@ void StepperBS<D>::dense_interp(const Int n, VecDoub_IO &y, const Int imit) {
 template <class D>
 void StepperBS<D>::dy(VecDoub_I &y,const Doub htot,const Int k,VecDoub_O &yend,
                       Int &ipt,D &derivs) {
-  VecDoub ym(n),yn(n);
+  //VecDoub ym(n),yn(n); // <replaced /> by members
   Int nstep=nseq[k];
+  nrhs += nstep; // <added />
   Doub h=htot/nstep;
   for (Int i=0;i<n;i++) {
     ym[i]=y[i];
@@ -254,9 +287,12 @@ void StepperBS<D>::step(const Doub htry,D &derivs) {
   Int i,k;
   Doub fac,h,hnew,hopt_int=0,err; /// <added> initialization of hopt_int for compiler's sanity
   bool firstk;
-  VecDoub hopt(IMAXX),work(IMAXX);
-  VecDoub ysav(n),yseq(n);
-  VecDoub ymid(n),scale(n);
+  // <replaced>
+  //VecDoub hopt(IMAXX),work(IMAXX);
+  //VecDoub ysav(n),yseq(n);
+  //VecDoub ymid(n),scale(n);
+  // </replaced>
+  Doub hopt[IMAXX]={0.0},work[IMAXX]={0.0}; // <replacement /> (the rest are members)
   work[0]=0;
   h=htry;
   forward = h>0 ? true : false;
@@ -273,6 +309,7 @@ void StepperBS<D>::step(const Doub htry,D &derivs) {
   hnew=std::abs(h);
  interp_error:
   while (firstk || reject) {
+    if (reject) ++nrej; // <added />
     h = forward ? hnew : -hnew;
     firstk=false;
     reject=false;
@@ -294,6 +331,11 @@ void StepperBS<D>::step(const Doub htry,D &derivs) {
           err+=SQR((y[i]-table[0][i])/scale[i]);
         }
         err=sqrt(err/n);
+        if (err != err) { // <added> to catch NaNs from too-large timesteps, as in StepperDopr853
+          reject=true;
+          hnew=0.333*std::abs(h);
+          break;
+        } // </added>
         Doub expo=1.0/(2*k+1);
         Doub facmin=::pow(STEPFAC3,expo);
         if (err == 0.0)
@@ -344,11 +386,12 @@ void StepperBS<D>::step(const Doub htry,D &derivs) {
       prev_reject=true;
   }
   derivs(x+h,y,dydxnew);
+  ++nrhs; // <added />
   if (dense) {
     prepare_dense(h,dydxnew,ysav,scale,k,err);
     hopt_int=h/MAX(::pow(err,1.0/(2*k+3)),0.01);
-    if (err > 10.0) {
-      hnew=std::abs(hopt_int);
+    if (err > 10.0 || err != err) { // <replaced /> (err > 10.0)
+      hnew=(err != err ? 0.333*std::abs(h) : std::abs(hopt_int)); // <replaced /> std::abs(hopt_int)
       reject=true;
       prev_reject=true;
       goto interp_error;
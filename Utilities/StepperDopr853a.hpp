@@ -173,8 +173,10 @@ struct StepperDopr853 : StepperBase {
   VecDoub yerr2;
   VecDoub k2,k3,k4,k5,k6,k7,k8,k9,k10;
   VecDoub rcont1,rcont2,rcont3,rcont4,rcont5,rcont6,rcont7,rcont8;
+  VecDoub dydxnew,ytemp; // <added /> so that steps allocate nothing
   StepperDopr853(VecDoub_IO &yy, VecDoub_IO &dydxx, Doub &xx,
-                 const Doub atoll, const Doub rtoll, bool dens);
+                 const Doub atoll, const Doub rtoll, bool dens, ODEWorkspace* ws=NULL);
+  ~StepperDopr853() { loan.Return(); } // <added />
   void step(const Doub htry,D &derivs);
   void dy(const Doub h,D &derivs);
   void prepare_dense(const Doub h,VecDoub_I &dydxnew,D &derivs);
@@ -188,22 +190,35 @@ struct StepperDopr853 : StepperBase {
   };
   Controller con;
 };
+// <replaced>
+// template <class D>
+// StepperDopr853<D>::StepperDopr853(VecDoub_IO &yy,VecDoub_IO &dydxx,Doub &xx,
+//                                   const Doub atoll,const Doub rtoll,bool dens) :
+//   StepperBase(yy,dydxx,xx,atoll,rtoll,dens),yerr2(n),k2(n),k3(n),k4(n),
+//   k5(n),k6(n),k7(n),k8(n),k9(n),k10(n),rcont1(n),rcont2(n),rcont3(n),
+//   rcont4(n),rcont5(n),rcont6(n),rcont7(n),rcont8(n) {
+// </replaced>
+// <replacement>
 template <class D>
 StepperDopr853<D>::StepperDopr853(VecDoub_IO &yy,VecDoub_IO &dydxx,Doub &xx,
-                                  const Doub atoll,const Doub rtoll,bool dens) :
-  StepperBase(yy,dydxx,xx,atoll,rtoll,dens),yerr2(n),k2(n),k3(n),k4(n),
-  k5(n),k6(n),k7(n),k8(n),k9(n),k10(n),rcont1(n),rcont2(n),rcont3(n),
-  rcont4(n),rcont5(n),rcont6(n),rcont7(n),rcont8(n) {
+                                  const Doub atoll,const Doub rtoll,bool dens,ODEWorkspace* ws) :
+  StepperBase(yy,dydxx,xx,atoll,rtoll,dens,ws) {
+  VecDoub* v[]={&yerr2,&k2,&k3,&k4,&k5,&k6,&k7,&k8,&k9,&k10,
+                &rcont1,&rcont2,&rcont3,&rcont4,&rcont5,&rcont6,&rcont7,&rcont8,
+                &dydxnew,&ytemp};
+  for (Int i=0;i<Int(sizeof(v)/sizeof(v[0]));i++) loan.Borrow(*v[i],n);
+  // </replacement>
   EPS=std::numeric_limits<Doub>::epsilon();
 }
 template <class D>
 void StepperDopr853<D>::step(const Doub htry,D &derivs) {
-  VecDoub dydxnew(n);
+  //VecDoub dydxnew(n); // <replaced /> by a member
   Doub h=htry;
   for (;;) {
     dy(h,derivs);
     Doub err=error(h);
     if (con.success(err,h)) break;
+    ++nrej; // <added />
     if (std::abs(h) <= std::abs(x)*EPS) {
       // <added>
       std::cerr << "\nh=" << h << "\tx=" << x
@@ -214,6 +229,7 @@ void StepperDopr853<D>::step(const Doub htry,D &derivs) {
     }
   }
   derivs(x+h,yout,dydxnew);
+  nrhs += (dense ? 4 : 1); // <added /> including those in prepare_dense
   if (dense)
     prepare_dense(h,dydxnew,derivs);
   dydx=dydxnew;
@@ -224,8 +240,9 @@ void StepperDopr853<D>::step(const Doub htry,D &derivs) {
 }
 template <class D>
 void StepperDopr853<D>::dy(const Doub h,D &derivs) {
-  VecDoub ytemp(n);
+  //VecDoub ytemp(n); // <replaced /> by a member
   Int i;
+  nrhs += 11; // <added />
   for (i=0;i<n;i++)
     ytemp[i]=y[i]+h*a21*dydx[i];
   derivs(x+c2*h,ytemp,k2);
@@ -280,7 +297,7 @@ void StepperDopr853<D>::prepare_dense(const Doub h,VecDoub_I &dydxnew,
                                       D &derivs) {
   Int i;
   Doub ydiff,bspl;
-  VecDoub ytemp(n);
+  //VecDoub ytemp(n); // <replaced /> by a member
   for (i=0;i<n;i++) {
     rcont1[i]=y[i];
     ydiff=yout[i]-y[i];
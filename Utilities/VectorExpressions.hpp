@@ -0,0 +1,317 @@
+#ifndef VECTOREXPRESSIONS_HPP
+#define VECTOREXPRESSIONS_HPP
+
+#include <vector>
+#include <cmath>
+#include "Utilities.hpp"
+
+/// Lazy arithmetic on std::vector<double>
+///
+/// The arithmetic operators and cmath functions acting on vectors
+/// (declared at the bottom of this file, and included by
+/// "VectorFunctions.hpp") return small expression objects instead of
+/// new vectors.  An expression is only evaluated when it is assigned
+/// or converted to a std::vector<double>, or added into one with +=,
+/// etc., and then in a single loop.  So
+///
+///   ReRef() += Amplitude * cos(Phase);
+///
+/// runs one loop over the data, with no intermediate vectors.  An
+/// expression converts implicitly to std::vector<double>, so it may be
+/// passed anywhere a vector is expected; it also has size() and
+/// operator[] for direct use.  Expressions hold references to the
+/// vectors in them, and are meant to be used within the statement that
+/// creates them.
+
+namespace WaveformUtilities {
+  namespace VectorExpressions {
+
+    /// Leaf holding a reference to a vector
+    class Reference {
+    private:
+      const std::vector<double>& v;
+    public:
+      Reference(const std::vector<double>& V) : v(V) { }
+      inline unsigned int size() const { return v.size(); }
+      inline double operator[](const unsigned int i) const { return v[i]; }
+    };
+
+    /// Node applying Op to each element of A
+    template <class A, class Op>
+    class Unary {
+    private:
+      const A a;
+    public:
+      Unary(const A& A0) : a(A0) { }
+      inline unsigned int size() const { return a.size(); }
+      inline double operator[](const unsigned int i) const { return Op::Apply(a[i]); }
+    };
+
+    /// Node applying Op to corresponding elements of A and B
+    template <class A, class B, class Op>
+    class Binary {
+    private:
+      const A a;
+      const B b;
+    public:
+      Binary(const A& A0, const B& B0) : a(A0), b(B0) {
+        if(a.size() != b.size()) {
+          std::cerr << "\na.size()=" << a.size() << "\tb.size()=" << b.size() << std::endl;
+          Throw1WithMessage("Size disagreement");
+        }
+      }
+      inline unsigned int size() const { return a.size(); }
+      inline double operator[](const unsigned int i) const { return Op::Apply(a[i], b[i]); }
+    };
+
+    /// Node applying Op to each element of A and a scalar on the right
+    template <class A, class Op>
+    class BinaryScalarRight {
+    private:
+      const A a;
+      const double b;
+    public:
+      BinaryScalarRight(const A& A0, const double B0) : a(A0), b(B0) { }
+      inline unsigned int size() const { return a.size(); }
+      inline double operator[](const unsigned int i) const { return Op::Apply(a[i], b); }
+    };
+
+    /// Node applying Op to a scalar on the left and each element of B
+    template <class B, class Op>
+    class BinaryScalarLeft {
+    private:
+      const double a;
+      const B b;
+    public:
+      BinaryScalarLeft(const double A0, const B& B0) : a(A0), b(B0) { }
+      inline unsigned int size() const { return b.size(); }
+      inline double operator[](const unsigned int i) const { return Op::Apply(a, b[i]); }
+    };
+
+    /// The type returned by all operations, wrapping one of the above
+    template <class E>
+    class Expression {
+    private:
+      const E e;
+    public:
+      Expression(const E& E0) : e(E0) { }
+      inline const E& Node() const { return e; }
+      inline unsigned int size() const { return e.size(); }
+      inline double operator[](const unsigned int i) const { return e[i]; }
+      operator std::vector<double>() const {
+        const unsigned int N = e.size();
+        std::vector<double> v(N);
+        for(unsigned int i=0; i<N; ++i) { v[i] = e[i]; }
+        return v;
+      }
+    };
+
+    /// Operations on elements
+    struct Plus { static inline double Apply(const double a, const double b) { return a+b; } };
+    struct Minus { static inline double Apply(const double a, const double b) { return a-b; } };
+    struct Times { static inline double Apply(const double a, const double b) { return a*b; } };
+    struct Divide { static inline double Apply(const double a, const double b) { return a/b; } };
+    struct Negate { static inline double Apply(const double a) { return -a; } };
+    #define VECTOREXPRESSIONS_UNARY_FUNCTION(Name, Function) \
+      struct Name { static inline double Apply(const double a) { return std::Function(a); } };
+    #define VECTOREXPRESSIONS_BINARY_FUNCTION(Name, Function) \
+      struct Name { static inline double Apply(const double a, const double b) { return std::Function(a, b); } };
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Cos, cos)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Sin, sin)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Tan, tan)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Acos, acos)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Asin, asin)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Atan, atan)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Cosh, cosh)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Sinh, sinh)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Tanh, tanh)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Exp, exp)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Log, log)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Log10, log10)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Sqrt, sqrt)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Ceil, ceil)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Fabs, fabs)
+    VECTOREXPRESSIONS_UNARY_FUNCTION(Floor, floor)
+    VECTOREXPRESSIONS_BINARY_FUNCTION(Atan2, atan2)
+    VECTOREXPRESSIONS_BINARY_FUNCTION(Pow, pow)
+    VECTOREXPRESSIONS_BINARY_FUNCTION(Fmod, fmod)
+    #undef VECTOREXPRESSIONS_UNARY_FUNCTION
+    #undef VECTOREXPRESSIONS_BINARY_FUNCTION
+
+    /// Evaluate an expression into an existing vector with Op
+    template <class Op, class E>
+    inline std::vector<double>& Update(std::vector<double>& a, const Expression<E>& b) {
+      if(a.size() != b.size()) {
+        std::cerr << "\na.size()=" << a.size() << "\tb.size()=" << b.size() << std::endl;
+        Throw1WithMessage("Size disagreement");
+      }
+      const unsigned int N = a.size();
+      const E& e = b.Node();
+      for(unsigned int i=0; i<N; ++i) { a[i] = Op::Apply(a[i], e[i]); }
+      return a;
+    }
+
+    /// Operators with at least one Expression operand, found by
+    /// argument-dependent lookup
+    #define VECTOREXPRESSIONS_OPERATOR(Symbol, Op) \
+      template <class A, class B> \
+      inline Expression<Binary<A, B, Op> > operator Symbol(const Expression<A>& a, const Expression<B>& b) { \
+        return Expression<Binary<A, B, Op> >(Binary<A, B, Op>(a.Node(), b.Node())); \
+      } \
+      template <class A> \
+      inline Expression<Binary<A, Reference, Op> > operator Symbol(const Expression<A>& a, const std::vector<double>& b) { \
+        return Expression<Binary<A, Reference, Op> >(Binary<A, Reference, Op>(a.Node(), Reference(b))); \
+      } \
+      template <class B> \
+      inline Expression<Binary<Reference, B, Op> > operator Symbol(const std::vector<double>& a, const Expression<B>& b) { \
+        return Expression<Binary<Reference, B, Op> >(Binary<Reference, B, Op>(Reference(a), b.Node())); \
+      } \
+      template <class A> \
+      inline Expression<BinaryScalarRight<A, Op> > operator Symbol(const Expression<A>& a, const double& b) { \
+        return Expression<BinaryScalarRight<A, Op> >(BinaryScalarRight<A, Op>(a.Node(), b)); \
+      } \
+      template <class B> \
+      inline Expression<BinaryScalarLeft<B, Op> > operator Symbol(const double& a, const Expression<B>& b) { \
+        return Expression<BinaryScalarLeft<B, Op> >(BinaryScalarLeft<B, Op>(a, b.Node())); \
+      } \
+      template <class E> \
+      inline std::vector<double>& operator Symbol##=(std::vector<double>& a, const Expression<E>& b) { \
+        return Update<Op>(a, b); \
+      }
+    VECTOREXPRESSIONS_OPERATOR(+, Plus)
+    VECTOREXPRESSIONS_OPERATOR(-, Minus)
+    VECTOREXPRESSIONS_OPERATOR(*, Times)
+    VECTOREXPRESSIONS_OPERATOR(/, Divide)
+    #undef VECTOREXPRESSIONS_OPERATOR
+    template <class A>
+    inline Expression<Unary<A, Negate> > operator-(const Expression<A>& a) {
+      return Expression<Unary<A, Negate> >(Unary<A, Negate>(a.Node()));
+    }
+
+    /// Functions of Expressions, found by argument-dependent lookup
+    #define VECTOREXPRESSIONS_UNARY(Function, Op) \
+      template <class A> \
+      inline Expression<Unary<A, Op> > Function(const Expression<A>& a) { \
+        return Expression<Unary<A, Op> >(Unary<A, Op>(a.Node())); \
+      }
+    #define VECTOREXPRESSIONS_BINARY(Function, Op) \
+      template <class A, class B> \
+      inline Expression<Binary<A, B, Op> > Function(const Expression<A>& a, const Expression<B>& b) { \
+        return Expression<Binary<A, B, Op> >(Binary<A, B, Op>(a.Node(), b.Node())); \
+      } \
+      template <class A> \
+      inline Expression<Binary<A, Reference, Op> > Function(const Expression<A>& a, const std::vector<double>& b) { \
+        return Expression<Binary<A, Reference, Op> >(Binary<A, Reference, Op>(a.Node(), Reference(b))); \
+      } \
+      template <class B> \
+      inline Expression<Binary<Reference, B, Op> > Function(const std::vector<double>& a, const Expression<B>& b) { \
+        return Expression<Binary<Reference, B, Op> >(Binary<Reference, B, Op>(Reference(a), b.Node())); \
+      }
+    VECTOREXPRESSIONS_UNARY(cos, Cos)
+    VECTOREXPRESSIONS_UNARY(sin, Sin)
+    VECTOREXPRESSIONS_UNARY(tan, Tan)
+    VECTOREXPRESSIONS_UNARY(acos, Acos)
+    VECTOREXPRESSIONS_UNARY(asin, Asin)
+    VECTOREXPRESSIONS_UNARY(atan, Atan)
+    VECTOREXPRESSIONS_UNARY(cosh, Cosh)
+    VECTOREXPRESSIONS_UNARY(sinh, Sinh)
+    VECTOREXPRESSIONS_UNARY(tanh, Tanh)
+    VECTOREXPRESSIONS_UNARY(exp, Exp)
+    VECTOREXPRESSIONS_UNARY(log, Log)
+    VECTOREXPRESSIONS_UNARY(log10, Log10)
+    VECTOREXPRESSIONS_UNARY(sqrt, Sqrt)
+    VECTOREXPRESSIONS_UNARY(ceil, Ceil)
+    VECTOREXPRESSIONS_UNARY(fabs, Fabs)
+    VECTOREXPRESSIONS_UNARY(floor, Floor)
+    VECTOREXPRESSIONS_BINARY(atan2, Atan2)
+    VECTOREXPRESSIONS_BINARY(pow, Pow)
+    VECTOREXPRESSIONS_BINARY(fmod, Fmod)
+    template <class A>
+    inline Expression<BinaryScalarRight<A, Pow> > pow(const Expression<A>& base, const double& exponent) {
+      return Expression<BinaryScalarRight<A, Pow> >(BinaryScalarRight<A, Pow>(base.Node(), exponent));
+    }
+    template <class A>
+    inline Expression<BinaryScalarRight<A, Fmod> > fmod(const Expression<A>& numerator, const double& denominator) {
+      return Expression<BinaryScalarRight<A, Fmod> >(BinaryScalarRight<A, Fmod>(numerator.Node(), denominator));
+    }
+    #undef VECTOREXPRESSIONS_UNARY
+    #undef VECTOREXPRESSIONS_BINARY
+
+  } // namespace VectorExpressions
+} // namespace WaveformUtilities
+
+
+/// Arithmetic operators and cmath functions on plain vectors, which
+/// start expressions.  These are in the global namespace, as they
+/// have always been.
+#define VECTOREXPRESSIONS_GLOBAL_OPERATOR(Symbol, Op) \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::Binary<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  operator Symbol(const std::vector<double>& a, const std::vector<double>& b) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<Binary<Reference, Reference, Op> >(Binary<Reference, Reference, Op>(Reference(a), Reference(b))); \
+  } \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::BinaryScalarRight<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  operator Symbol(const std::vector<double>& a, const double& b) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<BinaryScalarRight<Reference, Op> >(BinaryScalarRight<Reference, Op>(Reference(a), b)); \
+  } \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::BinaryScalarLeft<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  operator Symbol(const double& a, const std::vector<double>& b) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<BinaryScalarLeft<Reference, Op> >(BinaryScalarLeft<Reference, Op>(a, Reference(b))); \
+  }
+VECTOREXPRESSIONS_GLOBAL_OPERATOR(+, Plus)
+VECTOREXPRESSIONS_GLOBAL_OPERATOR(-, Minus)
+VECTOREXPRESSIONS_GLOBAL_OPERATOR(*, Times)
+VECTOREXPRESSIONS_GLOBAL_OPERATOR(/, Divide)
+#undef VECTOREXPRESSIONS_GLOBAL_OPERATOR
+inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::Unary<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Negate> >
+operator-(const std::vector<double>& a) {
+  using namespace WaveformUtilities::VectorExpressions;
+  return Expression<Unary<Reference, Negate> >(Unary<Reference, Negate>(Reference(a)));
+}
+
+#define VECTOREXPRESSIONS_GLOBAL_UNARY(Function, Op) \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::Unary<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  Function(const std::vector<double>& a) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<Unary<Reference, Op> >(Unary<Reference, Op>(Reference(a))); \
+  }
+#define VECTOREXPRESSIONS_GLOBAL_BINARY(Function, Op) \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::Binary<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  Function(const std::vector<double>& a, const std::vector<double>& b) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<Binary<Reference, Reference, Op> >(Binary<Reference, Reference, Op>(Reference(a), Reference(b))); \
+  }
+#define VECTOREXPRESSIONS_GLOBAL_SCALAR(Function, Op) \
+  inline WaveformUtilities::VectorExpressions::Expression<WaveformUtilities::VectorExpressions::BinaryScalarRight<WaveformUtilities::VectorExpressions::Reference, WaveformUtilities::VectorExpressions::Op> > \
+  Function(const std::vector<double>& a, const double& b) { \
+    using namespace WaveformUtilities::VectorExpressions; \
+    return Expression<BinaryScalarRight<Reference, Op> >(BinaryScalarRight<Reference, Op>(Reference(a), b)); \
+  }
+VECTOREXPRESSIONS_GLOBAL_UNARY(cos, Cos)
+VECTOREXPRESSIONS_GLOBAL_UNARY(sin, Sin)
+VECTOREXPRESSIONS_GLOBAL_UNARY(tan, Tan)
+VECTOREXPRESSIONS_GLOBAL_UNARY(acos, Acos)
+VECTOREXPRESSIONS_GLOBAL_UNARY(asin, Asin)
+VECTOREXPRESSIONS_GLOBAL_UNARY(atan, Atan)
+VECTOREXPRESSIONS_GLOBAL_UNARY(cosh, Cosh)
+VECTOREXPRESSIONS_GLOBAL_UNARY(sinh, Sinh)
+VECTOREXPRESSIONS_GLOBAL_UNARY(tanh, Tanh)
+VECTOREXPRESSIONS_GLOBAL_UNARY(exp, Exp)
+VECTOREXPRESSIONS_GLOBAL_UNARY(log, Log)
+VECTOREXPRESSIONS_GLOBAL_UNARY(log10, Log10)
+VECTOREXPRESSIONS_GLOBAL_UNARY(sqrt, Sqrt)
+VECTOREXPRESSIONS_GLOBAL_UNARY(ceil, Ceil)
+VECTOREXPRESSIONS_GLOBAL_UNARY(fabs, Fabs)
+VECTOREXPRESSIONS_GLOBAL_UNARY(floor, Floor)
+VECTOREXPRESSIONS_GLOBAL_BINARY(atan2, Atan2)
+VECTOREXPRESSIONS_GLOBAL_BINARY(pow, Pow)
+VECTOREXPRESSIONS_GLOBAL_BINARY(fmod, Fmod)
+VECTOREXPRESSIONS_GLOBAL_SCALAR(pow, Pow)
+VECTOREXPRESSIONS_GLOBAL_SCALAR(fmod, Fmod)
+#undef VECTOREXPRESSIONS_GLOBAL_UNARY
+#undef VECTOREXPRESSIONS_GLOBAL_BINARY
+#undef VECTOREXPRESSIONS_GLOBAL_SCALAR
+
+#endif // VECTOREXPRESSIONS_HPP
@@ -3,6 +3,7 @@
 #include <limits>
 #include <sstream>
 #include "Utilities.hpp"
+#include "VectorMath.hpp"
 namespace WU = WaveformUtilities;
 using WU::Matrix;
 using std::vector;
@@ -122,97 +123,6 @@ string RowFormat(const WaveformUtilities::Matrix<int>& m) {
 
 
 // Arithmetic
-vector<double> operator+(const vector<double>& a, const double& b) {
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]+b;
-  }
-  return c;
-}
-vector<double> operator-(const vector<double>& a, const double& b) {
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]-b;
-  }
-  return c;
-}
-vector<double> operator*(const vector<double>& a, const double& b) {
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]*b;
-  }
-  return c;
-}
-vector<double> operator/(const vector<double>& a, const double& b) {
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]/b;
-  }
-  return c;
-}
-
-vector<double> operator+(const double& a, const vector<double>& b) {
-  vector<double> c(b.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a+b[i];
-  }
-  return c;
-}
-vector<double> operator-(const double& a, const vector<double>& b) {
-  vector<double> c(b.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a-b[i];
-  }
-  return c;
-}
-vector<double> operator*(const double& a, const vector<double>& b) {
-  vector<double> c(b.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a*b[i];
-  }
-  return c;
-}
-vector<double> operator/(const double& a, const vector<double>& b) {
-  vector<double> c(b.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a/b[i];
-  }
-  return c;
-}
-
-vector<double> operator+(const vector<double>& a, const vector<double>& b) {
-  if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]+b[i];
-  }
-  return c;
-}
-vector<double> operator-(const vector<double>& a, const vector<double>& b) {
-  if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]-b[i];
-  }
-  return c;
-}
-vector<double> operator*(const vector<double>& a, const vector<double>& b) {
-  if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]*b[i];
-  }
-  return c;
-}
-vector<double> operator/(const vector<double>& a, const vector<double>& b) {
-  if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> c(a.size());
-  for(unsigned int i=0; i<c.size(); ++i) {
-    c[i] = a[i]/b[i];
-  }
-  return c;
-}
-
 vector<double>& operator+=(vector<double>& a, const double& b) {
   for(unsigned int i=0; i<a.size(); ++i) {
     a[i] += b;
@@ -248,34 +158,25 @@ vector<double>& operator+=(vector<double>& a, const vector<double>& b) {
 vector<double>& operator-=(vector<double>& a, const vector<double>& b) {
   if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
   for(unsigned int i=0; i<a.size(); ++i) {
-    a[i] += b[i];
+    a[i] -= b[i];
   }
   return a;
 }
 vector<double>& operator*=(vector<double>& a, const vector<double>& b) {
   if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
   for(unsigned int i=0; i<a.size(); ++i) {
-    a[i] += b[i];
+    a[i] *= b[i];
   }
   return a;
 }
 vector<double>& operator/=(vector<double>& a, const vector<double>& b) {
   if(! DimensionsAgree(a,b)) { Throw1WithMessage("Size disagreement"); }
   for(unsigned int i=0; i<a.size(); ++i) {
-    a[i] += b[i];
+    a[i] /= b[i];
   }
   return a;
 }
 
-vector<double> operator-(const vector<double>& a) {
-  vector<double> b(a.size());
-  for(unsigned int i=0; i<b.size(); ++i) {
-    b[i] = -a[i];
-  }
-  return b;
-}
-
-
 Matrix<double> operator+(const Matrix<double>& a, const double& b) {
   Matrix<double> c(a.nrows(), a.ncols());
   for(unsigned int row=0; row<c.nrows(); ++row) {
@@ -471,157 +372,6 @@ Matrix<double> operator-(const Matrix<double>& a) {
   return b;
 }
 
-vector<double> cos(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = cos(theta[i]);
-  }
-  return y;
-}
-vector<double> sin(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = sin(theta[i]);
-  }
-  return y;
-}
-vector<double> tan(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = tan(theta[i]);
-  }
-  return y;
-}
-vector<double> acos(const vector<double>& y) {
-  vector<double> theta(y.size());
-  for(unsigned int i=0; i<theta.size(); ++i) {
-    theta[i] = acos(y[i]);
-  }
-  return theta;
-}
-vector<double> asin(const vector<double>& y) {
-  vector<double> theta(y.size());
-  for(unsigned int i=0; i<theta.size(); ++i) {
-    theta[i] = asin(y[i]);
-  }
-  return theta;
-}
-vector<double> atan(const vector<double>& y) {
-  vector<double> theta(y.size());
-  for(unsigned int i=0; i<theta.size(); ++i) {
-    theta[i] = atan(y[i]);
-  }
-  return theta;
-}
-vector<double> atan2(const vector<double>& Im, const vector<double>& Re) {
-  if(! DimensionsAgree(Im,Re)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> theta(Im.size());
-  for(unsigned int i=0; i<theta.size(); ++i) {
-    theta[i] = atan2(Im[i], Re[i]);
-  }
-  return theta;
-}
-vector<double> cosh(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = cosh(theta[i]);
-  }
-  return y;
-}
-vector<double> sinh(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = sinh(theta[i]);
-  }
-  return y;
-}
-vector<double> tanh(const vector<double>& theta) {
-  vector<double> y(theta.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = tanh(theta[i]);
-  }
-  return y;
-}
-vector<double> exp(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = exp(x[i]);
-  }
-  return y;
-}
-vector<double> log(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = log(x[i]);
-  }
-  return y;
-}
-vector<double> log10(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = log10(x[i]);
-  }
-  return y;
-}
-vector<double> pow(const vector<double>& base, const vector<double>& exponent) {
-  if(! DimensionsAgree(base,exponent)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> y(base.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = pow(base[i], exponent[i]);
-  }
-  return y;
-}
-vector<double> pow(const vector<double>& base, const double& exponent) {
-  vector<double> y(base.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = pow(base[i], exponent);
-  }
-  return y;
-}
-vector<double> sqrt(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = sqrt(x[i]);
-  }
-  return y;
-}
-vector<double> ceil(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = ceil(x[i]);
-  }
-  return y;
-}
-vector<double> fabs(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = fabs(x[i]);
-  }
-  return y;
-}
-vector<double> floor(const vector<double>& x) {
-  vector<double> y(x.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = floor(x[i]);
-  }
-  return y;
-}
-vector<double> fmod(const vector<double>& numerator, const vector<double>& denominator) {
-  if(! DimensionsAgree(numerator,denominator)) { Throw1WithMessage("Size disagreement"); }
-  vector<double> y(numerator.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = fmod(numerator[i], denominator[i]);
-  }
-  return y;
-}
-vector<double> fmod(const vector<double>& numerator, const double& denominator) {
-  vector<double> y(numerator.size());
-  for(unsigned int i=0; i<y.size(); ++i) {
-    y[i] = fmod(numerator[i], denominator);
-  }
-  return y;
-}
-
 Matrix<double> cos(const Matrix<double>& theta) {
   Matrix<double> y(theta.nrows(), theta.ncols());
   for(unsigned int row=0; row<y.nrows(); ++row) {
@@ -1092,12 +842,51 @@ vector<double> WU::Intersection(const vector<double>& t1, const vector<double>&
 }
 
 vector<double> WU::Intersection(const vector<vector<double> >& Times, const double MinStep, const double MinTime) {
-  vector<double> Time = Times[0];
-  // Get the intersection of all the time data
-  for(unsigned int i=1; i<Times.size(); ++i) {
-    Time = Intersection(Time, Times[i], MinStep, MinTime);
+  const unsigned int K = Times.size();
+  if(K==0) {
+    Throw1WithMessage("Times is empty");
+  }
+  if(K==1) { return Times[0]; }
+  double mint = MinTime;
+  double maxt = Times[0].size()>0 ? Times[0].back() : 0.0;
+  for(unsigned int k=0; k<K; ++k) {
+    if(Times[k].size()==0) {
+      cerr << "\nTimes[" << k << "] is empty" << endl;
+      Throw1WithMessage("Empty time series");
+    }
+    mint = std::max(mint, Times[k][0]);
+    maxt = std::min(maxt, Times[k].back());
+  }
+  if(mint > maxt) {
+    for(unsigned int k=0; k<K; ++k) {
+      cerr << "\nmin(Times[" << k << "])=" << Times[k][0] << "\tmax(Times[" << k << "])=" << Times[k].back();
+    }
+    cerr << endl;
+    Throw1WithMessage("Empty intersection");
   }
-  return Time;
+  // Step through all the sequences at once, with Index[k] tracking the
+  // interval ( Times[k][Index[k]-1], Times[k][Index[k]] ] containing
+  // the latest time; the next step is the smallest of those intervals
+  // (or MinStep).  With two sequences, this is the same as the
+  // function above.
+  vector<unsigned int> Index(K, 1);
+  vector<double> t;
+  t.reserve(Times[0].size());
+  t.push_back(mint);
+  while(t.back() < maxt) {
+    const double tI = t.back();
+    double Step = numeric_limits<double>::max();
+    for(unsigned int k=0; k<K; ++k) {
+      const vector<double>& T = Times[k];
+      unsigned int& I = Index[k];
+      while(tI>T[I] && I<T.size()-1) { I++; }
+      Step = std::min(Step, T[I]-T[I-1]);
+    }
+    const double Next = tI + std::max(Step, MinStep);
+    if(Next>maxt) { break; }
+    t.push_back(Next);
+  }
+  return t;
 }
 
 vector<double> WU::Union(const vector<double>& t1, const vector<double>& t2, const double MinStep) {
@@ -1209,27 +998,16 @@ vector<double>& WU::Unwrap(vector<double>& Vec, const unsigned int i1, const uns
 void WU::MagArg(const vector<double>& Re, const vector<double>& Im,
                 vector<double>& amp, vector<double>& phi)
 {
-  if(amp.size() != Re.size()) { amp = Re; }
-  if(phi.size() != Re.size()) { phi = Re; }
-
-  for(unsigned int j=0; j<phi.size(); ++j) { // Loop over time
-    amp[j] = sqrt(Re[j]*Re[j]+Im[j]*Im[j]);
-    phi[j] = atan2(Im[j], Re[j]);
-  }
-  phi = Unwrap(phi);
+  CartesianToPolar(Re, Im, amp, phi);
 }
 
 void WU::ReIm(const vector<vector<double> >& amp, const vector<vector<double> >& phi,
           vector<vector<double> >& Re, vector<vector<double> >& Im)
 {
-  if(amp.size() != Re.size() || amp[0].size() != Re[0].size()) { Re = amp; }
-  if(amp.size() != Im.size() || amp[0].size() != Im[0].size()) { Im = amp; }
-
+  Re.resize(amp.size());
+  Im.resize(amp.size());
   for(unsigned int i=0; i<Re.size(); ++i) {
-    for(unsigned int j=0; j<Re[i].size(); ++j) {
-      Re[i][j] = amp[i][j]*cos(phi[i][j]);
-      Im[i][j] = amp[i][j]*sin(phi[i][j]);
-    }
+    PolarToCartesian(amp[i], phi[i], Re[i], Im[i]);
   }
 }
 
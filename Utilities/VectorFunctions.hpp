@@ -7,6 +7,7 @@
 #include <string>
 #include <limits>
 #include "Matrix.hpp"
+#include "VectorExpressions.hpp"
 
 /// IO operators for vectors and matrices
 std::ostream& operator<<(std::ostream& out, const std::vector<double>& v);
@@ -19,18 +20,9 @@ std::string RowFormat(const WaveformUtilities::Matrix<double>& m);
 std::string RowFormat(const WaveformUtilities::Matrix<int>& m);
 
 /// Arithmetic operators on vectors and matrices
-std::vector<double> operator+(const std::vector<double>& a, const double& b);
-std::vector<double> operator-(const std::vector<double>& a, const double& b);
-std::vector<double> operator*(const std::vector<double>& a, const double& b);
-std::vector<double> operator/(const std::vector<double>& a, const double& b);
-std::vector<double> operator+(const double& a, const std::vector<double>& b);
-std::vector<double> operator-(const double& a, const std::vector<double>& b);
-std::vector<double> operator*(const double& a, const std::vector<double>& b);
-std::vector<double> operator/(const double& a, const std::vector<double>& b);
-std::vector<double> operator+(const std::vector<double>& a, const std::vector<double>& b);
-std::vector<double> operator-(const std::vector<double>& a, const std::vector<double>& b);
-std::vector<double> operator*(const std::vector<double>& a, const std::vector<double>& b);
-std::vector<double> operator/(const std::vector<double>& a, const std::vector<double>& b);
+///   The operators and cmath functions on std::vector<double> return
+///   lazy expressions, which are evaluated in one loop when assigned;
+///   see "VectorExpressions.hpp".
 std::vector<double>& operator+=(std::vector<double>& a, const double& b);
 std::vector<double>& operator-=(std::vector<double>& a, const double& b);
 std::vector<double>& operator*=(std::vector<double>& a, const double& b);
@@ -39,7 +31,6 @@ std::vector<double>& operator+=(std::vector<double>& a, const std::vector<double
 std::vector<double>& operator-=(std::vector<double>& a, const std::vector<double>& b);
 std::vector<double>& operator*=(std::vector<double>& a, const std::vector<double>& b);
 std::vector<double>& operator/=(std::vector<double>& a, const std::vector<double>& b);
-std::vector<double> operator-(const std::vector<double>& a);
 WaveformUtilities::Matrix<double> operator+(const WaveformUtilities::Matrix<double>& a, const double& b);
 WaveformUtilities::Matrix<double> operator-(const WaveformUtilities::Matrix<double>& a, const double& b);
 WaveformUtilities::Matrix<double> operator*(const WaveformUtilities::Matrix<double>& a, const double& b);
@@ -65,27 +56,6 @@ WaveformUtilities::Matrix<double> operator-(const WaveformUtilities::Matrix<doub
 /// cmath functions (other than frexp, ldexp, and modf)
 ///   Note that if more than one template argument is given,
 ///   they are assumed to have the same dimensions.
-std::vector<double> cos(const std::vector<double>& theta);
-std::vector<double> sin(const std::vector<double>& theta);
-std::vector<double> tan(const std::vector<double>& theta);
-std::vector<double> acos(const std::vector<double>& y);
-std::vector<double> asin(const std::vector<double>& y);
-std::vector<double> atan(const std::vector<double>& y);
-std::vector<double> atan2(const std::vector<double>& Im, const std::vector<double>& Re);
-std::vector<double> cosh(const std::vector<double>& theta);
-std::vector<double> sinh(const std::vector<double>& theta);
-std::vector<double> tanh(const std::vector<double>& theta);
-std::vector<double> exp(const std::vector<double>& x);
-std::vector<double> log(const std::vector<double>& x);
-std::vector<double> log10(const std::vector<double>& x);
-std::vector<double> pow(const std::vector<double>& base, const std::vector<double>& exponent);
-std::vector<double> pow(const std::vector<double>& base, const double& exponent);
-std::vector<double> sqrt(const std::vector<double>& x);
-std::vector<double> ceil(const std::vector<double>& x);
-std::vector<double> fabs(const std::vector<double>& x);
-std::vector<double> floor(const std::vector<double>& x);
-std::vector<double> fmod(const std::vector<double>& numerator, const std::vector<double>& denominator);
-std::vector<double> fmod(const std::vector<double>& numerator, const double& denominator);
 WaveformUtilities::Matrix<double> cos(const WaveformUtilities::Matrix<double>& theta);
 WaveformUtilities::Matrix<double> sin(const WaveformUtilities::Matrix<double>& theta);
 WaveformUtilities::Matrix<double> tan(const WaveformUtilities::Matrix<double>& theta);
@@ -177,9 +147,10 @@ namespace WaveformUtilities {
   ///   whichever is greater.  The output starts at the earliest
   ///   moment common to t1 and t2, or MinTime, whichever is greater.
   std::vector<double> Intersection(const std::vector<double>& t1, const std::vector<double>& t2, const double MinStep, const double MinTime);
-  /// This function simply iterates the above procedure, for a
-  ///   collection of time sequences.  This is used, for example,
-  ///   in the 'Extrapolate' routine.
+  /// This function does the same for a collection of time
+  ///   sequences, in a single pass through all of them, with the
+  ///   time step at each point the minimum of all their steps.
+  ///   This is used, for example, in the 'Extrapolate' routine.
   std::vector<double> Intersection(const std::vector<std::vector<double> >& Times, const double MinStep, const double MinTime);
   /// This function returns the union of two time sequences,
   ///   similar to the 'Intersection' function above.
@@ -189,6 +160,8 @@ namespace WaveformUtilities {
   /// Phase-conversion functions
   std::vector<double> Unwrap(const std::vector<double>& a);
   std::vector<double>& Unwrap(std::vector<double>& a, const unsigned int i1, const unsigned int i2); // Unwrap between two indices
+  /// MagArg and ReIm use the kernels in "VectorMath.hpp"; MagArg
+  ///   unwraps the phase, and its outputs may be its inputs.
   void MagArg(const std::vector<double>& Re, const std::vector<double>& Im,
               std::vector<double>& mag, std::vector<double>& arg);
   void ReIm(const std::vector<std::vector<double> >& mag, const std::vector<std::vector<double> >& arg,
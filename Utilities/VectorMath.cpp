@@ -0,0 +1,277 @@
+#include "VectorMath.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include "NumericalRecipes.hpp"
+#include "Utilities.hpp"
+
+using namespace std;
+namespace WU = WaveformUtilities;
+
+// The kernels below work on blocks of BlockSize elements, copied into
+// local arrays.  This keeps each block in cache between the passes
+// over it, lets the output vectors alias the inputs, and leaves the
+// compiler free to vectorize loops over arrays it knows do not
+// overlap.  The polynomial coefficients are those of fdlibm.
+
+static const unsigned int BlockSize = 256;
+
+// Where the compiler supports it, each block kernel is compiled for
+// AVX-512, AVX2, and the baseline (SSE2) instruction sets, and the
+// version for the running CPU is chosen when the program is loaded.
+// Otherwise, the kernels are compiled as usual.
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) && (__GNUC__ >= 6) \
+  && defined(__x86_64__) && defined(__linux__) && !defined(VECTORMATH_NO_DISPATCH)
+#define VECTORMATH_KERNEL __attribute__((target_clones("avx512f","avx2","default"), optimize("tree-vectorize")))
+#else
+#define VECTORMATH_KERNEL
+#endif
+
+// Reduction of x to r+rr=x-q*pi/2 with |r|<=pi/4, as in fdlibm's
+// __ieee754_rem_pio2 for medium arguments, with pi/2 split into three
+// 33-bit pieces, so that q*PiO2_k is exact for |q|<2^20, and a tail.
+// Adding and subtracting RoundingShift rounds to the nearest integer.
+static const double TwoOverPi = 6.36619772367581382433e-01;
+static const double PiO2_1 = 1.57079632673412561417e+00;
+static const double PiO2_2 = 6.07710050630396597660e-11;
+static const double PiO2_3 = 2.02226624871116645580e-21;
+static const double PiO2_3t = 8.47842766036889956997e-32;
+static const double SinCosLimit = 8.2e5;
+static const double RoundingShift = 6755399441055744.0;
+
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 =  8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 =  2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 =  1.58969099521155010221e-10;
+static const double C1 =  4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 =  2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 =  2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+/// Compute sin and cos of the n<=BlockSize elements of x; elements
+/// that are too large (or not finite) are computed with libm.
+VECTORMATH_KERNEL static void SinCosBlock(const unsigned int n, const double* x, double* s, double* c) {
+  bool Large = false;
+  for(unsigned int i=0; i<n; ++i) {
+    Large = Large || !(fabs(x[i])<SinCosLimit);
+  }
+  for(unsigned int i=0; i<n; ++i) {
+    const double xi = (fabs(x[i])<SinCosLimit ? x[i] : 0.0);
+    const double q = (xi*TwoOverPi + RoundingShift) - RoundingShift;
+    const int Quadrant = int(q);
+    // Near a multiple of pi/2, the pieces cancel most of x, so rather
+    // than re-reducing when that happens, as fdlibm does, every
+    // element carries the remainder exactly: the first subtraction is
+    // exact, and the errors of the next two are recovered by TwoSum.
+    // Only the tail product is rounded, so r+rr is accurate to well
+    // beyond double precision, relative to r, for every
+    // |x|<SinCosLimit.
+    const double r1 = xi - q*PiO2_1;
+    const double t2 = q*PiO2_2;
+    const double r2 = r1 - t2;
+    const double v2 = r2 - r1;
+    const double e2 = (r1 - (r2 - v2)) - (t2 + v2);
+    const double t3 = q*PiO2_3;
+    const double r3 = r2 - t3;
+    const double v3 = r3 - r2;
+    const double e3 = (r2 - (r3 - v3)) - (t3 + v3);
+    const double Tail = (e2 + e3) - q*PiO2_3t;
+    const double r = r3 + Tail;
+    const double rr = (r3 - r) + Tail;
+    // fdlibm's __kernel_sin and __kernel_cos, including the tail rr
+    const double z = r*r;
+    const double v = z*r;
+    const double SinR = r - ((z*(0.5*rr - v*(S2 + z*(S3 + z*(S4 + z*(S5 + z*S6))))) - rr) - v*S1);
+    const double hz = 0.5*z;
+    const double w = 1.0-hz;
+    const double CosR = w + (((1.0-w)-hz) + (z*z*(C1 + z*(C2 + z*(C3 + z*(C4 + z*(C5 + z*C6))))) - r*rr));
+    const double SinX = ((Quadrant&1) ? CosR : SinR);
+    const double CosX = ((Quadrant&1) ? SinR : CosR);
+    s[i] = ((Quadrant&2) ? -SinX : SinX);
+    c[i] = (((Quadrant+1)&2) ? -CosX : CosX);
+  }
+  if(Large) {
+    for(unsigned int i=0; i<n; ++i) {
+      if(!(fabs(x[i])<SinCosLimit)) {
+        s[i] = sin(x[i]);
+        c[i] = cos(x[i]);
+      }
+    }
+  }
+}
+
+// atan(t) = t - t*P(t^2) for |t|<=7/16
+static const double AT0 =  3.33333333333329318027e-01;
+static const double AT1 = -1.99999999998764832476e-01;
+static const double AT2 =  1.42857142725034663711e-01;
+static const double AT3 = -1.11111104054623557880e-01;
+static const double AT4 =  9.09088713343650656196e-02;
+static const double AT5 = -7.69187620504482999495e-02;
+static const double AT6 =  6.66107313738753120669e-02;
+static const double AT7 = -5.83357013379057348645e-02;
+static const double AT8 =  4.97687799461593236017e-02;
+static const double AT9 = -3.65315727442169155270e-02;
+static const double AT10 = 1.62858201153657823623e-02;
+static const double TanPiO8 = 4.14213562373095034e-01;
+static const double Atan2Limit = 1.e300;
+// pi/4 as hi+lo, where hi has only 50 significant bits, so that m*PiO4Hi
+// is exact for m=0,...,4
+static const double PiO4Hi = 7.85398163397448278999e-01;
+static const double PiO4Lo = 3.06161699786838301793e-17;
+
+/// Compute atan2(y,x) for the n<=BlockSize elements of y and x.  The
+/// smaller of |x| and |y| over the larger is reduced to |t|<=tan(pi/8)
+/// by subtracting pi/4 if necessary; the result is then m*pi/4 +/-
+/// atan(t), with the sign of y.  Elements with very large or nonfinite
+/// components are computed with libm.
+VECTORMATH_KERNEL static void Atan2Block(const unsigned int n, const double* y, const double* x, double* z) {
+  bool Large = false;
+  for(unsigned int i=0; i<n; ++i) {
+    Large = Large || !(fabs(x[i])<Atan2Limit && fabs(y[i])<Atan2Limit);
+  }
+  for(unsigned int i=0; i<n; ++i) {
+    const double ax = fabs(x[i]);
+    const double ay = fabs(y[i]);
+    const bool Swap = (ay>ax);
+    const double Max = (Swap ? ay : ax);
+    const double Min = (Swap ? ax : ay);
+    const bool Shift = (Min > TanPiO8*Max);
+    const double Den = (Shift ? Min+Max : Max);
+    const double t = (Den>0.0 && Den<Atan2Limit ? (Shift ? Min-Max : Min)/Den : 0.0);
+    const double w = t*t;
+    const double v = w*w;
+    const double Odd = w*(AT0 + v*(AT2 + v*(AT4 + v*(AT6 + v*(AT8 + v*AT10)))));
+    const double Even = v*(AT1 + v*(AT3 + v*(AT5 + v*(AT7 + v*AT9))));
+    const double AtanT = t - t*(Odd+Even);
+    // In the first octant, the angle is m*pi/4 + AtanT with m=0 or 1;
+    // reflecting about pi/4 and then about pi/2 gives the others
+    const double m1 = (Shift ? 1.0 : 0.0);
+    const double m2 = (Swap ? 2.0-m1 : m1);
+    const double m = (x[i]<0.0 ? 4.0-m2 : m2);
+    const double Sign = ((Swap != (x[i]<0.0)) ? -1.0 : 1.0);
+    const double Angle = m*PiO4Hi + (m*PiO4Lo + Sign*AtanT);
+    z[i] = (y[i]<0.0 ? -Angle : Angle);
+  }
+  if(Large) {
+    for(unsigned int i=0; i<n; ++i) {
+      if(!(fabs(x[i])<Atan2Limit && fabs(y[i])<Atan2Limit)) {
+        z[i] = atan2(y[i], x[i]);
+      }
+    }
+  }
+}
+
+VECTORMATH_KERNEL static void HypotBlock(const unsigned int n, const double* x, const double* y, double* z) {
+  for(unsigned int i=0; i<n; ++i) {
+    z[i] = sqrt(x[i]*x[i]+y[i]*y[i]);
+  }
+}
+
+/// Copy n elements of a vector into a block
+static inline void Load(const unsigned int n, const double* From, double* To) {
+  for(unsigned int i=0; i<n; ++i) { To[i] = From[i]; }
+}
+
+
+void WU::SinCos(const vector<double>& x, vector<double>& sinx, vector<double>& cosx) {
+  const unsigned int N = x.size();
+  sinx.resize(N);
+  cosx.resize(N);
+  double xb[BlockSize];
+  for(unsigned int i0=0; i0<N; i0+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, N-i0);
+    Load(n, &x[i0], xb);
+    SinCosBlock(n, xb, &sinx[i0], &cosx[i0]);
+  }
+}
+
+void WU::Atan2(const vector<double>& y, const vector<double>& x, vector<double>& z) {
+  if(y.size() != x.size()) {
+    cerr << "\ny.size()=" << y.size() << "\tx.size()=" << x.size() << endl;
+    Throw1WithMessage("Size disagreement");
+  }
+  const unsigned int N = x.size();
+  z.resize(N);
+  double yb[BlockSize], xb[BlockSize];
+  for(unsigned int i0=0; i0<N; i0+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, N-i0);
+    Load(n, &y[i0], yb);
+    Load(n, &x[i0], xb);
+    Atan2Block(n, yb, xb, &z[i0]);
+  }
+}
+
+void WU::Hypot(const vector<double>& x, const vector<double>& y, vector<double>& z) {
+  if(y.size() != x.size()) {
+    cerr << "\nx.size()=" << x.size() << "\ty.size()=" << y.size() << endl;
+    Throw1WithMessage("Size disagreement");
+  }
+  const unsigned int N = x.size();
+  z.resize(N);
+  double xb[BlockSize], yb[BlockSize];
+  for(unsigned int i0=0; i0<N; i0+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, N-i0);
+    Load(n, &x[i0], xb);
+    Load(n, &y[i0], yb);
+    HypotBlock(n, xb, yb, &z[i0]);
+  }
+}
+
+void WU::PolarToCartesian(const vector<double>& Mag, const vector<double>& Arg, vector<double>& Re, vector<double>& Im) {
+  if(Mag.size() != Arg.size()) {
+    cerr << "\nMag.size()=" << Mag.size() << "\tArg.size()=" << Arg.size() << endl;
+    Throw1WithMessage("Size disagreement");
+  }
+  const unsigned int N = Mag.size();
+  Re.resize(N);
+  Im.resize(N);
+  double mb[BlockSize], ab[BlockSize], sb[BlockSize], cb[BlockSize];
+  for(unsigned int i0=0; i0<N; i0+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, N-i0);
+    Load(n, &Mag[i0], mb);
+    Load(n, &Arg[i0], ab);
+    SinCosBlock(n, ab, sb, cb);
+    double* re = &Re[i0];
+    double* im = &Im[i0];
+    for(unsigned int i=0; i<n; ++i) {
+      re[i] = mb[i]*cb[i];
+      im[i] = mb[i]*sb[i];
+    }
+  }
+}
+
+void WU::CartesianToPolar(const vector<double>& Re, const vector<double>& Im, vector<double>& Mag, vector<double>& Arg) {
+  if(Re.size() != Im.size()) {
+    cerr << "\nRe.size()=" << Re.size() << "\tIm.size()=" << Im.size() << endl;
+    Throw1WithMessage("Size disagreement");
+  }
+  const unsigned int N = Re.size();
+  Mag.resize(N);
+  Arg.resize(N);
+  // As in Unwrap, a jump of more than pi between successive values of
+  // atan2 (which are within [-pi,pi]) is counted as a whole turn
+  const double TwoPi = 2.0*M_PI;
+  double Turns = 0.0;
+  double Previous = 0.0;
+  double rb[BlockSize], ib[BlockSize], ab[BlockSize];
+  for(unsigned int i0=0; i0<N; i0+=BlockSize) {
+    const unsigned int n = std::min(BlockSize, N-i0);
+    Load(n, &Re[i0], rb);
+    Load(n, &Im[i0], ib);
+    HypotBlock(n, rb, ib, &Mag[i0]);
+    Atan2Block(n, ib, rb, ab);
+    if(i0==0) { Previous = ab[0]; }
+    double* arg = &Arg[i0];
+    for(unsigned int i=0; i<n; ++i) {
+      const double Dp = ab[i]-Previous;
+      Turns += (Dp<-M_PI ? 1.0 : (Dp>M_PI ? -1.0 : 0.0));
+      Previous = ab[i];
+      arg[i] = ab[i] + TwoPi*Turns;
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#ifndef VECTORMATH_HPP
+#define VECTORMATH_HPP
+
+#include <vector>
+
+namespace WaveformUtilities {
+
+  /// Elementwise transcendental functions for long vectors
+  ///
+  /// These replace loops of scalar libm calls in the conversions
+  /// between (Mag,Arg) and (Re,Im) data.  Each is a branch-free
+  /// polynomial kernel over blocks of the input, written so that the
+  /// compiler can vectorize its loops; with GCC on x86-64 Linux, the
+  /// kernels are compiled for AVX-512, AVX2, and SSE2, and chosen for
+  /// the running CPU at load time.  Elements outside the range of a
+  /// kernel are recomputed with libm.  The largest errors measured,
+  /// relative to the exact results, are
+  ///
+  ///   SinCos   0.8 ulp for |x| < 8.2e5, including arguments next
+  ///            to multiples of pi/2 (libm is used beyond)
+  ///   Atan2    2.2 ulp (signed zeros are treated as +0)
+  ///   Hypot    1.2 ulp (computed as sqrt(x*x+y*y), so |x| and |y|
+  ///            must be smaller than about 1e154, as before)
+  ///
+  /// Test/TestVectorMath.cpp measures these, and compares the
+  /// throughput against libm.
+  ///
+  /// The output vectors are resized as necessary, and may be the same
+  /// as the input vectors.
+
+  /// sinx[i]=sin(x[i]) and cosx[i]=cos(x[i]), sharing the reduction
+  void SinCos(const std::vector<double>& x, std::vector<double>& sinx, std::vector<double>& cosx);
+  /// atan2(y[i],x[i])
+  void Atan2(const std::vector<double>& y, const std::vector<double>& x, std::vector<double>& z);
+  /// sqrt(x[i]*x[i]+y[i]*y[i])
+  void Hypot(const std::vector<double>& x, const std::vector<double>& y, std::vector<double>& z);
+
+  /// Re[i]=Mag[i]*cos(Arg[i]) and Im[i]=Mag[i]*sin(Arg[i])
+  void PolarToCartesian(const std::vector<double>& Mag, const std::vector<double>& Arg,
+                        std::vector<double>& Re, std::vector<double>& Im);
+  /// The inverse of PolarToCartesian, with the phase unwrapped as by
+  /// Unwrap in the same pass over the data.  Each element of Arg is
+  /// atan2(Im[i],Re[i]) plus the number of whole turns accumulated, so
+  /// the unwrapping adds no roundoff that grows along the vector.
+  void CartesianToPolar(const std::vector<double>& Re, const std::vector<double>& Im,
+                        std::vector<double>& Mag, std::vector<double>& Arg);
+
+} // namespace WaveformUtilities
+
+#endif // VECTORMATH_HPP
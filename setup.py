@@ -51,6 +51,12 @@ for key, value in cfs.iteritems():
     if(type(cfs[key])==str) :
         cfs[key] = value.replace('-Wstrict-prototypes', '')
 
+## The revision of the code, marked "-dirty" if the working tree has
+## uncommitted changes.  PNWaveformCache relies on the marker.
+GitRevision = os.popen('git rev-parse HEAD').read().strip()
+if os.popen('git status --porcelain --untracked-files=no').read().strip():
+    GitRevision += '-dirty'
+
 ## This gets the list of files to build and the headers they depend on
 CPPFiles = glob.glob("Utilities/*.cpp") + glob.glob("PostNewtonian/*.cpp") + glob.glob("Objects/*.cpp") + glob.glob("Objects/Waveform/*.cpp")
 SourceFiles = CPPFiles + ['PyGW_IS_FOR_OLD_DATA.i']
@@ -64,7 +70,7 @@ PyGW_IS_FOR_OLD_DATAExtension = Extension(name = '_PyGW_IS_FOR_OLD_DATA',
                           # library_dirs=['/opt/local/lib'], 
                           # libraries=['gsl', 'gslcblas'], 
                           # runtime_library_dirs = [], 
-                          define_macros = [('GitRevision', '"{0}"'.format(os.popen('git rev-parse HEAD').read().strip()))],
+                          define_macros = [('GitRevision', '"{0}"'.format(GitRevision))],
                           # undef_macros = [],
                           # extra_objects = [], # other things to link with
                           extra_compile_args = ['-w'], # turn off all warnings